@@ -95,7 +95,7 @@ class EventBus : public ProtobufProcess<EventBus> {
       auto subscribersForType = this->subscribersMap.find(typeid(T));
       if (subscribersForType == this->subscribersMap.end()) {
         // Nobody subscribed for this event.
-        LOG(INFO) << "Nobody subscribed for this event.";
+        VLOG(1) << "Nobody subscribed for this event.";
         return Nothing();
       }
 
@@ -103,7 +103,7 @@ class EventBus : public ProtobufProcess<EventBus> {
     }
 
     for (const process::UPID& subscriberPID : subscribers) {
-      LOG(INFO) << "Sending to: " << subscriberPID;
+      VLOG(1) << "Sending to: " << subscriberPID;
       T msg(in);
       this->send(subscriberPID, msg);
     }
@@ -201,6 +201,17 @@ class StaticEventBus {
     StaticEventBus::publish<OversubscriptionCtrlEventEnvelope>(envelope);
   }
 
+  static inline void publishSlackScaleEvent(
+      double_t slackScale,
+      const std::string& source,
+      bool memoryContention = false) {
+    OversubscriptionCtrlEventEnvelope envelope;
+    envelope.mutable_message()->set_slack_scale(slackScale);
+    envelope.mutable_message()->set_source(source);
+    envelope.mutable_message()->set_memory_contention(memoryContention);
+    StaticEventBus::publish<OversubscriptionCtrlEventEnvelope>(envelope);
+  }
+
  private:
   // Private constructor.
   StaticEventBus() {}
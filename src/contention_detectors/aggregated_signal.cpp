@@ -0,0 +1,230 @@
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "contention_detectors/aggregated_signal.hpp"
+
+#include "serenity/resource_helper.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/stringify.hpp"
+
+namespace mesos {
+namespace serenity {
+
+namespace {
+
+struct ExecutorSample {
+  const ResourceUsage_Executor* executor;
+  double_t value;
+  //! Value relative to executor reference (1.0 without reference).
+  double_t normalized;
+};
+
+
+// Weighted normalized signal of executors within one scope (host or socket).
+struct Scope {
+  Scope() : weightedSum(0), weights(0) {}
+
+  double_t weightedSum;
+  double_t weights;
+  std::vector<ExecutorSample> samples;
+};
+
+}  // namespace
+
+
+AggregatedSignalDetector::AggregatedSignalDetector(
+    Consumer<Contentions>* _consumer,
+    const lambda::function<usage::GetterFunction>& _getValue,
+    const SerenityConfig& _conf,
+    const lambda::function<SocketFunction>& _getSocket,
+    const lambda::function<usage::GetterFunction>& _getWeight,
+    const Tag& _tag,
+    const Contention_Type _contentionType)
+  : tag(_tag),
+    analyzerConf(_conf),
+    getValue(_getValue),
+    getSocket(_getSocket),
+    getWeight(_getWeight),
+    contentionType(_contentionType),
+    victimFraction(AggregatedSignalDetectorConfig(_conf).getD(
+        detector::VICTIM_FRACTION)),
+    referenceAlpha(AggregatedSignalDetectorConfig(_conf).getD(
+        detector::REFERENCE_ALPHA)) {
+  if (_consumer != nullptr) {
+    this->addConsumer(_consumer);
+  }
+}
+
+
+Try<Nothing> AggregatedSignalDetector::consume(const ResourceUsage& usage) {
+  auto executorsListsTuple =
+    ResourceUsageHelper::getProductionAndRevocableExecutors(usage);
+
+  std::list<ResourceUsage_Executor> productionExecutors =
+    std::get<ResourceUsageHelper::ExecutorType::PRODUCTION>(
+      executorsListsTuple);
+  std::list<ResourceUsage_Executor> revocableExecutors =
+    std::get<ResourceUsageHelper::ExecutorType::REVOCABLE>(
+      executorsListsTuple);
+
+  std::map<std::string, Scope> scopes;
+  for (const ResourceUsage_Executor& executor : productionExecutors) {
+    if (!ResourceUsageHelper::isExecutorHasStatistics(executor)) {
+      SERENITY_VLOG(1) << "No statistics for executor "
+                       << executor.executor_info().executor_id();
+      continue;
+    }
+
+    Try<double_t> value = this->getValue(executor);
+    if (value.isError()) {
+      SERENITY_LOG(ERROR) << value.error();
+      continue;
+    }
+
+    Try<double_t> weight = this->getWeight(executor);
+    if (weight.isError()) {
+      SERENITY_LOG(ERROR) << weight.error();
+      continue;
+    }
+
+    if (weight.get() <= 0) {
+      continue;
+    }
+
+    // Executors have different natural signal levels, so each one
+    // contributes its value relative to its own reference.
+    double_t normalized = 1.0;
+    auto reference = this->references.find(executor.executor_info());
+    if (reference != this->references.end() && reference->second > 0) {
+      normalized = value.get() / reference->second;
+    }
+
+    std::vector<std::string> executorScopes{HOST_SCOPE};
+    Option<uint32_t> socket = this->getSocket(executor);
+    if (socket.isSome()) {
+      executorScopes.push_back("socket" + stringify(socket.get()));
+    }
+
+    for (const std::string& name : executorScopes) {
+      Scope& scope = scopes[name];
+      scope.weightedSum += weight.get() * normalized;
+      scope.weights += weight.get();
+      scope.samples.push_back(
+          ExecutorSample{&executor, value.get(), normalized});
+    }
+  }
+
+  Contentions product;
+  //! Executors of contended scopes and the ones already reported as victims.
+  ExecutorMap<bool> contended;
+  for (const auto& scope : scopes) {
+    const double_t aggregate = scope.second.weightedSum / scope.second.weights;
+
+    auto analyzer = this->analyzers.find(scope.first);
+    if (analyzer == this->analyzers.end()) {
+      analyzer = this->analyzers.insert(std::make_pair(
+          scope.first,
+          std::unique_ptr<SignalAnalyzer>(new SignalDropAnalyzer(
+              Tag(QOS_CONTROLLER, std::string(NAME) + " " + scope.first),
+              this->analyzerConf)))).first;
+    }
+
+    SERENITY_VLOG(1) << "Aggregated signal of " << scope.first << ": "
+                     << aggregate << " (" << scope.second.samples.size()
+                     << " executors)";
+
+    Result<Detection> detected = analyzer->second->processSample(aggregate);
+    if (detected.isError()) {
+      SERENITY_LOG(ERROR) << detected.error();
+      continue;
+    }
+
+    if (detected.isNone()) {
+      continue;
+    }
+
+    if (revocableExecutors.empty()) {
+      SERENITY_LOG(INFO) << "Contention spotted on " << scope.first
+                         << ", however there are no Best effort tasks on "
+                         << "the host. Assuming false positive";
+      analyzer->second->resetSignalRecovering();
+      continue;
+    }
+
+    // Pick victims - executors which signal dropped below their reference.
+    std::vector<const ExecutorSample*> victims;
+    const ExecutorSample* biggestDrop = nullptr;
+    double_t biggestDropFraction = 0;
+    for (const ExecutorSample& sample : scope.second.samples) {
+      const ExecutorInfo& info = sample.executor->executor_info();
+      contended.insert(std::make_pair(info, false));
+
+      const double_t drop = 1.0 - sample.normalized;
+      if (drop >= this->victimFraction) {
+        victims.push_back(&sample);
+      }
+      if (drop > biggestDropFraction) {
+        biggestDropFraction = drop;
+        biggestDrop = &sample;
+      }
+    }
+
+    if (victims.empty() && biggestDrop != nullptr) {
+      victims.push_back(biggestDrop);
+    }
+
+    SERENITY_LOG(INFO) << "Aggregated signal contention spotted on "
+                       << scope.first << " with " << victims.size()
+                       << " victim(s)";
+
+    for (const ExecutorSample* victim : victims) {
+      const ResourceUsage_Executor& executor = *victim->executor;
+      bool& reported = contended[executor.executor_info()];
+      if (reported) {
+        continue;
+      }
+      reported = true;
+
+      Contention contention = createContention(
+          detected.get().severity,
+          this->contentionType,
+          WID(executor.executor_info()).getWorkID(),
+          executor.statistics().timestamp());
+
+      Option<uint32_t> socket = this->getSocket(executor);
+      if (socket.isSome()) {
+        contention.set_socket(socket.get());
+      }
+
+      product.push_back(contention);
+    }
+  }
+
+  // Update references of executors from uncontended scopes. Executors which
+  // are gone are forgotten.
+  ExecutorMap<double_t> references;
+  for (const ExecutorSample& sample : scopes[HOST_SCOPE].samples) {
+    const ExecutorInfo& info = sample.executor->executor_info();
+    auto reference = this->references.find(info);
+    if (reference == this->references.end()) {
+      references[info] = sample.value;
+    } else if (contended.find(info) != contended.end()) {
+      references[info] = reference->second;
+    } else {
+      references[info] = reference->second +
+        this->referenceAlpha * (sample.value - reference->second);
+    }
+  }
+  this->references = std::move(references);
+
+  SERENITY_LOG(INFO) << "Producing " << product.size() << " contentions";
+  produce(product);
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,122 @@
+#ifndef SERENITY_AGGREGATED_SIGNAL_DETECTOR_HPP
+#define SERENITY_AGGREGATED_SIGNAL_DETECTOR_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "contention_detectors/signal_analyzers/base.hpp"
+#include "contention_detectors/signal_analyzers/drop.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/executor_map.hpp"
+#include "serenity/serenity.hpp"
+#include "serenity/topology.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/option.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class AggregatedSignalDetectorConfig : public SerenityConfig {
+ public:
+  AggregatedSignalDetectorConfig() {
+    this->initDefaults();
+  }
+
+  explicit AggregatedSignalDetectorConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! double_t
+    //! Executor of contended scope is a victim when its signal is that
+    //! fraction below its reference.
+    this->fields[detector::VICTIM_FRACTION] =
+      detector::DEFAULT_VICTIM_FRACTION;
+
+    //! double_t
+    //! Weight of new sample in executor reference signal. Reference is not
+    //! updated while scope of the executor is contended.
+    this->fields[detector::REFERENCE_ALPHA] =
+      detector::DEFAULT_REFERENCE_ALPHA;
+  }
+};
+
+
+/**
+ * AggregatedSignalDetector builds one CPU usage weighted aggregate of the
+ * signal (e.g. EMA IPC) of all production executors on the host - and of
+ * executors on each socket, when socket function is given - and runs
+ * change point detection (SignalDropAnalyzer) on these aggregates only.
+ *
+ * Each executor contributes its signal normalized by its reference (EMA of
+ * the signal from uncontended iterations), so the aggregate stays near 1.0
+ * and does not jump when executors with different natural signal levels
+ * start, finish or change their CPU usage. New executors contribute 1.0.
+ *
+ * Aggregate is much less noisy than signal of single executor and the
+ * number of analyzers does not grow with number of executors.
+ *
+ * When aggregate of a scope drops, victims are executors which signal is
+ * VICTIM_FRACTION below reference (or the one with the biggest drop if
+ * there is no such executor).
+ *
+ * Contention of a victim with known socket carries that socket, so
+ * strategies pick aggressors only among executors co-located with it.
+ */
+class AggregatedSignalDetector :
+    public Consumer<ResourceUsage>,
+    public Producer<Contentions> {
+ public:
+  /**
+   * Consumer can be added later (it can be nullptr).
+   */
+  AggregatedSignalDetector(
+      Consumer<Contentions>* _consumer,
+      const lambda::function<usage::GetterFunction>& _getValue,
+      const SerenityConfig& _conf,
+      const lambda::function<SocketFunction>& _getSocket = unknownSocket,
+      const lambda::function<usage::GetterFunction>& _getWeight =
+        usage::getCpuUsage,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME),
+      const Contention_Type _contentionType = Contention_Type_IPC);
+
+  Try<Nothing> consume(const ResourceUsage& usage) override;
+
+  /**
+   * Number of analyzed scopes (host and sockets).
+   */
+  size_t scopes() const {
+    return this->analyzers.size();
+  }
+
+  static const constexpr char* NAME = "AggregatedSignalDetector";
+  static const constexpr char* HOST_SCOPE = "host";
+
+ protected:
+  const Tag tag;
+  const SerenityConfig analyzerConf;
+  const lambda::function<usage::GetterFunction> getValue;
+  const lambda::function<SocketFunction> getSocket;
+  const lambda::function<usage::GetterFunction> getWeight;
+  const Contention_Type contentionType;
+  const double_t victimFraction;
+  const double_t referenceAlpha;
+
+  std::map<std::string, std::unique_ptr<SignalAnalyzer>> analyzers;
+  ExecutorMap<double_t> references;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_AGGREGATED_SIGNAL_DETECTOR_HPP
@@ -0,0 +1,92 @@
+#include <string>
+
+#include "contention_detectors/bandwidth.hpp"
+
+#include "mesos/resources.hpp"
+
+namespace mesos {
+namespace serenity {
+
+static Try<double_t> unknownBandwidth(const ResourceUsage_Executor& exec) {
+  return Error("Bandwidth statistics of this resource are not reported");
+}
+
+
+lambda::function<usage::GetterFunction> bandwidthGetter(Contention_Type type) {
+  if (type == Contention_Type_NETWORK) {
+    return usage::getNetworkBandwidth;
+  }
+  return unknownBandwidth;
+}
+
+
+Option<double_t> maxBandwidth(const SerenityConfig& config) {
+  return config.getOptionalD(detector::MAX_BANDWIDTH);
+}
+
+
+Try<Nothing> BandwidthDetector::consume(const ResourceUsage& in) {
+  Contentions product;
+
+  if (this->cfgMaxBandwidth.isNone()) {
+    this->produce(product);
+    return Nothing();
+  }
+
+  const double_t maximum = this->cfgMaxBandwidth.get();
+  double_t thresholdBandwidth = this->cfgThreshold * maximum;
+  double_t agentSumBandwidth = 0;
+  uint64_t measuredExecutors = 0;
+  uint64_t beExecutors = 0;
+
+  for (const ResourceUsage_Executor& inExec : in.executors()) {
+    if (!inExec.has_executor_info() || !inExec.has_statistics()) {
+      // Filter out these executors.
+      continue;
+    }
+
+    if (!Resources(inExec.allocated()).revocable().empty()) {
+      beExecutors++;
+    }
+
+    Try<double_t> value = this->bandwidthGetFunction(inExec);
+    if (value.isError()) {
+      // Isolator (e.g. network/port_mapping) does not report these counters.
+      continue;
+    }
+
+    agentSumBandwidth += value.get();
+    measuredExecutors++;
+  }
+
+  if (measuredExecutors > 0) {
+    SERENITY_VLOG(1) << "Sum = " << agentSumBandwidth << " B/s vs max = "
+      << maximum << " B/s [threshold = "
+      << thresholdBandwidth << " B/s]";
+  }
+
+  if (agentSumBandwidth > thresholdBandwidth) {
+    if (beExecutors == 0) {
+      SERENITY_LOG(INFO) << "No BE tasks - only high "
+                         << Contention_Type_Name(this->contentionType)
+                         << " bandwidth";
+    } else {
+      // Severity is the fraction of max bandwidth above the threshold.
+      double_t severity =
+        (agentSumBandwidth - thresholdBandwidth) / maximum;
+      SERENITY_LOG(INFO) << "Creating "
+                         << Contention_Type_Name(this->contentionType)
+                         << " contention with severity " << severity;
+
+      product.push_back(createContention(severity, this->contentionType));
+    }
+  }
+
+  // Continue pipeline.
+  this->produce(product);
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,112 @@
+#ifndef SERENITY_BANDWIDTH_DETECTOR_HPP
+#define SERENITY_BANDWIDTH_DETECTOR_HPP
+
+#include <string>
+
+#include "glog/logging.h"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/option.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class BandwidthDetectorConfig : public SerenityConfig {
+ public:
+  BandwidthDetectorConfig() {
+    this->initDefaults();
+  }
+
+  explicit BandwidthDetectorConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    // MAX_BANDWIDTH (double_t) of the node's NIC [bytes/s] has no
+    // default - detector is inactive until it is configured.
+
+    //! double_t
+    //! Fraction of maximum bandwidth above which contention is created.
+    this->fields[detector::BANDWIDTH_THRESHOLD] =
+      detector::DEFAULT_BANDWIDTH_THRESHOLD;
+  }
+};
+
+
+/**
+ * Returns bandwidth getter of executor for given contention type. Only
+ * NETWORK (rx + tx) is measured - Mesos does not report per container
+ * block IO counters, so getter of other types always fails.
+ */
+lambda::function<usage::GetterFunction> bandwidthGetter(Contention_Type type);
+
+
+/**
+ * Returns MAX_BANDWIDTH of the config, if it was configured.
+ */
+Option<double_t> maxBandwidth(const SerenityConfig& config);
+
+
+/**
+ * BandwidthDetector sums network bandwidth of all executors and creates
+ * NETWORK contention when it is above given fraction of node's maximum
+ * bandwidth and there are BE executors to revoke. Without MAX_BANDWIDTH
+ * configured it never creates contentions.
+ *
+ * Severity is the fraction of maximum bandwidth above the threshold.
+ *
+ * Bandwidth is counted from statistics sampled by CumulativeFilter.
+ */
+class BandwidthDetector :
+    public Consumer<ResourceUsage>,
+    public Producer<Contentions> {
+ public:
+  BandwidthDetector(
+      Consumer<Contentions>* _consumer,
+      Contention_Type _contentionType,
+      SerenityConfig _conf = SerenityConfig(),
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME))
+    : Producer<Contentions>(_consumer),
+      tag(_tag),
+      contentionType(_contentionType),
+      bandwidthGetFunction(bandwidthGetter(_contentionType)) {
+    SerenityConfig config = BandwidthDetectorConfig(_conf);
+    this->cfgMaxBandwidth = maxBandwidth(config);
+    this->cfgThreshold = config.getD(detector::BANDWIDTH_THRESHOLD);
+    if (this->cfgMaxBandwidth.isNone()) {
+      SERENITY_LOG(WARNING) << detector::MAX_BANDWIDTH << " is not "
+                            << "configured. Detector is inactive.";
+    }
+  }
+
+  ~BandwidthDetector() {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  static const constexpr char* NAME = "BandwidthDetector";
+  //! Config sections of detectors (and strategies) in QoS pipeline.
+  static const constexpr char* NETWORK_NAME = "NetworkBandwidthDetector";
+
+ protected:
+  const Tag tag;
+  const Contention_Type contentionType;
+  const lambda::function<usage::GetterFunction> bandwidthGetFunction;
+
+  // cfg parameters.
+  Option<double_t> cfgMaxBandwidth;
+  double_t cfgThreshold;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_BANDWIDTH_DETECTOR_HPP
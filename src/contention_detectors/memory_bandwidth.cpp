@@ -0,0 +1,72 @@
+#include <string>
+
+#include "contention_detectors/memory_bandwidth.hpp"
+
+#include "mesos/resources.hpp"
+
+namespace mesos {
+namespace serenity {
+
+Try<Nothing> MemoryBandwidthDetector::consume(const ResourceUsage& in) {
+  Contentions product;
+
+  if (this->cfgMaxBandwidth.isNone()) {
+    this->produce(product);
+    return Nothing();
+  }
+
+  const double_t maximum = this->cfgMaxBandwidth.get();
+  double_t thresholdBandwidth = this->cfgThreshold * maximum;
+  double_t agentSumBandwidth = 0;
+  uint64_t measuredExecutors = 0;
+  uint64_t beExecutors = 0;
+
+  for (const ResourceUsage_Executor& inExec : in.executors()) {
+    if (!inExec.has_executor_info() || !inExec.has_statistics()) {
+      // Filter out these executors.
+      continue;
+    }
+
+    if (!Resources(inExec.allocated()).revocable().empty()) {
+      beExecutors++;
+    }
+
+    Try<double_t> value = this->bandwidthGetFunction(inExec);
+    if (value.isError()) {
+      // Bandwidth is not available for first iteration or without resctrl.
+      continue;
+    }
+
+    agentSumBandwidth += value.get();
+    measuredExecutors++;
+  }
+
+  if (measuredExecutors > 0) {
+    SERENITY_LOG(INFO) << "Sum = " << agentSumBandwidth << " B/s vs max = "
+      << maximum << " B/s [threshold = "
+      << thresholdBandwidth << " B/s]";
+  }
+
+  if (agentSumBandwidth > thresholdBandwidth) {
+    if (beExecutors == 0) {
+      SERENITY_LOG(INFO) << "No BE tasks - only high memory bandwidth";
+    } else {
+      // Severity is the fraction of max bandwidth above the threshold.
+      double_t severity =
+        (agentSumBandwidth - thresholdBandwidth) / maximum;
+      SERENITY_LOG(INFO) << "Creating MEMORY_BANDWIDTH contention with "
+                         << "severity " << severity;
+
+      product.push_back(
+        createContention(severity, Contention_Type_MEMORY_BANDWIDTH));
+    }
+  }
+
+  // Continue pipeline.
+  this->produce(product);
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,98 @@
+#ifndef SERENITY_MEMORY_BANDWIDTH_DETECTOR_HPP
+#define SERENITY_MEMORY_BANDWIDTH_DETECTOR_HPP
+
+#include <list>
+#include <string>
+
+#include "glog/logging.h"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/serenity.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/option.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class MemoryBandwidthDetectorConfig : public SerenityConfig {
+ public:
+  MemoryBandwidthDetectorConfig() {
+    this->initDefaults();
+  }
+
+  explicit MemoryBandwidthDetectorConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    // MAX_MEMORY_BANDWIDTH (double_t) of the node [bytes/s] has no
+    // default - detector is inactive until it is configured.
+
+    //! double_t
+    //! Fraction of maximum memory bandwidth above which contention is
+    //! created.
+    this->fields[detector::MEMORY_BANDWIDTH_THRESHOLD] =
+      detector::DEFAULT_MEMORY_BANDWIDTH_THRESHOLD;
+  }
+};
+
+/**
+ * MemoryBandwidthDetector sums memory bandwidth of all executors and
+ * creates MEMORY_BANDWIDTH contention when it is above given fraction of
+ * node's maximum memory bandwidth and there are BE executors to revoke.
+ *
+ * Severity is the fraction of maximum bandwidth above the threshold.
+ * Without MAX_MEMORY_BANDWIDTH configured it never creates contentions.
+ *
+ * By default bandwidth is taken from MBM total counters attached by
+ * ResctrlFilter.
+ */
+class MemoryBandwidthDetector :
+    public Consumer<ResourceUsage>,
+    public Producer<Contentions> {
+ public:
+  MemoryBandwidthDetector(
+      Consumer<Contentions>* _consumer,
+      SerenityConfig _conf = SerenityConfig(),
+      const lambda::function<usage::GetterFunction>& _bandwidthGetFunction =
+        usage::getMbmTotalBandwidth,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME))
+    : Producer<Contentions>(_consumer),
+      tag(_tag),
+      bandwidthGetFunction(_bandwidthGetFunction) {
+    SerenityConfig config = MemoryBandwidthDetectorConfig(_conf);
+    this->cfgMaxBandwidth =
+      config.getOptionalD(detector::MAX_MEMORY_BANDWIDTH);
+    this->cfgThreshold = config.getD(detector::MEMORY_BANDWIDTH_THRESHOLD);
+    if (this->cfgMaxBandwidth.isNone()) {
+      SERENITY_LOG(INFO) << detector::MAX_MEMORY_BANDWIDTH << " is not "
+                         << "configured. Detector is inactive.";
+    }
+  }
+
+  ~MemoryBandwidthDetector() {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  static const constexpr char* NAME = "MemoryBandwidthDetector";
+
+ protected:
+  const Tag tag;
+  const lambda::function<usage::GetterFunction> bandwidthGetFunction;
+
+  // cfg parameters.
+  Option<double_t> cfgMaxBandwidth;
+  double_t cfgThreshold;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_MEMORY_BANDWIDTH_DETECTOR_HPP
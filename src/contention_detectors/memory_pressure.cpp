@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "contention_detectors/memory_pressure.hpp"
+
+#include "mesos/resources.hpp"
+
+#include "serenity/resource_helper.hpp"
+
+#include "stout/bytes.hpp"
+
+namespace mesos {
+namespace serenity {
+
+Try<Nothing> MemoryPressureDetector::consume(const ResourceUsage& in) {
+  Contentions product;
+
+  std::unique_ptr<ExecutorMap<uint64_t>> newCriticalCounters(
+    new ExecutorMap<uint64_t>());
+
+  double_t usedBytes = 0;
+  uint64_t beExecutors = 0;
+  bool criticalPressure = false;
+
+  for (const ResourceUsage_Executor& inExec : in.executors()) {
+    if (!inExec.has_executor_info() || !inExec.has_statistics()) {
+      // Filter out these executors.
+      continue;
+    }
+
+    const ResourceStatistics& statistics = inExec.statistics();
+    usedBytes += statistics.mem_rss_bytes() +
+                 (this->cfgCacheWeight * statistics.mem_cache_bytes());
+
+    Try<bool> isRevocable = ResourceUsageHelper::isRevocableExecutor(inExec);
+    if (isRevocable.isSome() && isRevocable.get()) {
+      beExecutors++;
+      continue;
+    }
+
+    if (!statistics.has_mem_critical_pressure_counter()) {
+      continue;
+    }
+
+    const uint64_t counter = statistics.mem_critical_pressure_counter();
+    auto previous = this->previousCriticalCounters->find(
+      inExec.executor_info());
+    if (previous != this->previousCriticalCounters->end() &&
+        counter > previous->second) {
+      SERENITY_LOG(INFO) << "Critical memory pressure reported by "
+                         << inExec.executor_info().executor_id().value();
+      criticalPressure = true;
+    }
+
+    newCriticalCounters->insert(
+      std::make_pair(inExec.executor_info(), counter));
+  }
+
+  this->previousCriticalCounters = std::move(newCriticalCounters);
+
+  Option<Bytes> totalAgentMem = Resources(in.total()).mem();
+  if (totalAgentMem.isNone() || totalAgentMem.get() == Bytes(0)) {
+    SERENITY_LOG(ERROR) << "ResourceUsage does not contain Agent's "
+                        << "total memory";
+    this->produce(product);
+    return Nothing();
+  }
+
+  const double_t usedFraction = usedBytes / totalAgentMem.get().bytes();
+  SERENITY_LOG(INFO) << "Used memory fraction = " << usedFraction
+                     << " [threshold = " << this->cfgThreshold << "]";
+
+  double_t severity = 0.0;
+  if (usedFraction > this->cfgThreshold) {
+    // Severity is the fraction of total memory above the threshold.
+    severity = usedFraction - this->cfgThreshold;
+  }
+  if (criticalPressure) {
+    severity = std::max(severity, this->cfgCriticalPressureSeverity);
+  }
+
+  if (severity > 0) {
+    if (beExecutors == 0) {
+      SERENITY_LOG(INFO) << "No BE tasks - only high memory pressure";
+    } else {
+      SERENITY_LOG(INFO) << "Creating MEMORY contention with severity "
+                         << severity;
+      product.push_back(createContention(severity, Contention_Type_MEMORY));
+    }
+  }
+
+  // Continue pipeline.
+  this->produce(product);
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,103 @@
+#ifndef SERENITY_MEMORY_PRESSURE_DETECTOR_HPP
+#define SERENITY_MEMORY_PRESSURE_DETECTOR_HPP
+
+#include <memory>
+#include <string>
+
+#include "glog/logging.h"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/executor_map.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/nothing.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class MemoryPressureDetectorConfig : public SerenityConfig {
+ public:
+  MemoryPressureDetectorConfig() {
+    this->initDefaults();
+  }
+
+  explicit MemoryPressureDetectorConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! double_t
+    //! Fraction of Agent's total memory above which contention is created.
+    this->fields[detector::MEMORY_PRESSURE_THRESHOLD] =
+      detector::DEFAULT_MEMORY_PRESSURE_THRESHOLD;
+
+    //! double_t
+    //! Part of page cache counted as used memory (dirty and mapped pages
+    //! are not easily reclaimable).
+    this->fields[detector::MEMORY_CACHE_WEIGHT] =
+      detector::DEFAULT_MEMORY_CACHE_WEIGHT;
+
+    //! double_t
+    //! Minimal severity of contention when PR executor reports critical
+    //! memory pressure.
+    this->fields[detector::CRITICAL_PRESSURE_SEVERITY] =
+      detector::DEFAULT_CRITICAL_PRESSURE_SEVERITY;
+  }
+};
+
+
+/**
+ * MemoryPressureDetector creates MEMORY contention before PR tasks start
+ * to swap or get OOM killed. There are two triggers:
+ *  - used memory (RSS + weighted page cache) of all executors is above
+ *    given fraction of Agent's total memory,
+ *  - mem_critical_pressure_counter of any PR executor increased since
+ *    previous iteration (kernel struggles to reclaim memory).
+ *
+ * Contention is created only when there are BE executors to revoke.
+ * Severity is the fraction of Agent's total memory to recover.
+ */
+class MemoryPressureDetector :
+    public Consumer<ResourceUsage>,
+    public Producer<Contentions> {
+ public:
+  explicit MemoryPressureDetector(
+      Consumer<Contentions>* _consumer,
+      const SerenityConfig& _conf = SerenityConfig(),
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME))
+    : Producer<Contentions>(_consumer),
+      tag(_tag),
+      previousCriticalCounters(new ExecutorMap<uint64_t>()) {
+    SerenityConfig config = MemoryPressureDetectorConfig(_conf);
+    this->cfgThreshold = config.getD(detector::MEMORY_PRESSURE_THRESHOLD);
+    this->cfgCacheWeight = config.getD(detector::MEMORY_CACHE_WEIGHT);
+    this->cfgCriticalPressureSeverity =
+      config.getD(detector::CRITICAL_PRESSURE_SEVERITY);
+  }
+
+  ~MemoryPressureDetector() {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  static const constexpr char* NAME = "MemoryPressureDetector";
+
+ protected:
+  const Tag tag;
+
+  //! Critical pressure counters of PR executors from previous iteration.
+  std::unique_ptr<ExecutorMap<uint64_t>> previousCriticalCounters;
+
+  // cfg parameters.
+  double_t cfgThreshold;
+  double_t cfgCacheWeight;
+  double_t cfgCriticalPressureSeverity;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_MEMORY_PRESSURE_DETECTOR_HPP
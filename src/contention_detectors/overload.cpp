@@ -5,6 +5,8 @@
 
 #include "mesos/resources.hpp"
 
+#include "serenity/math_utils.hpp"
+
 namespace mesos {
 namespace serenity {
 
@@ -57,14 +59,26 @@ Try<Nothing> OverloadDetector::consume(const ResourceUsage& in) {
   SERENITY_LOG(INFO) << "Sum = " << agentSumCpus << " vs total = "
     << totalAgentCpus.get() << " [threshold = " << thresholdCpus << "]";
 
-  if (agentSumCpus > thresholdCpus) {
+  // In predictive mode react on forecast when it is above current usage.
+  double_t expectedSumCpus = agentSumCpus;
+  if (this->cfgPredictive) {
+    double_t predictedSumCpus = this->predictUtilization(agentSumCpus);
+    SERENITY_LOG(INFO) << "Predicted sum = " << predictedSumCpus;
+    if (predictedSumCpus > expectedSumCpus) {
+      expectedSumCpus = predictedSumCpus;
+    }
+  }
+
+  if (expectedSumCpus > thresholdCpus) {
     if (beExecutors == 0) {
       SERENITY_LOG(INFO) << "No BE tasks - only high host utilization";
     } else {
       // Severity is the amount of the CPUs above the threshold.
-      double_t severity = agentSumCpus - thresholdCpus;
+      double_t severity = expectedSumCpus - thresholdCpus;
       SERENITY_LOG(INFO) << "Creating CPU contention, because of the "
-                         << severity << " CPUs above the threshold. ";
+                         << severity << " CPUs above the threshold"
+                         << (agentSumCpus > thresholdCpus ? "." :
+                             " (predicted).");
 
       product.push_back(createContention(severity, Contention_Type_CPU));
     }
@@ -77,5 +91,16 @@ Try<Nothing> OverloadDetector::consume(const ResourceUsage& in) {
 }
 
 
+double_t OverloadDetector::predictUtilization(double_t agentSumCpus) {
+  this->utilizationWindow.push_back(agentSumCpus);
+  while (this->utilizationWindow.size() > this->cfgTrendWindowSize) {
+    this->utilizationWindow.pop_front();
+  }
+
+  return utils::LinearForecast(this->utilizationWindow,
+                               this->cfgPredictionHorizon);
+}
+
+
 }  // namespace serenity
 }  // namespace mesos
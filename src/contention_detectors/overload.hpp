@@ -1,6 +1,7 @@
 #ifndef SERENITY_OVERLOAD_DETECTOR_HPP
 #define SERENITY_OVERLOAD_DETECTOR_HPP
 
+#include <deque>
 #include <list>
 #include <string>
 
@@ -34,12 +35,31 @@ class OverloadDetectorConfig : public SerenityConfig {
     //! Detector threshold.
     this->fields[detector::THRESHOLD] =
       detector::DEFAULT_UTILIZATION_THRESHOLD;
+
+    //! bool
+    //! Enables trend based prediction of utilization.
+    this->fields[detector::PREDICTIVE] = detector::DEFAULT_PREDICTIVE;
+
+    //! uint64_t
+    //! Number of last iterations used to fit utilization trend.
+    this->fields[detector::TREND_WINDOW_SIZE] =
+      detector::DEFAULT_TREND_WINDOW_SIZE;
+
+    //! double_t
+    //! How many iterations ahead utilization is predicted.
+    this->fields[detector::PREDICTION_HORIZON] =
+      detector::DEFAULT_PREDICTION_HORIZON;
   }
 };
 
 /**
  * OverloadDetector is able to create contention if utilization is above
  * given thresholds.
+ *
+ * In predictive mode it also fits linear trend to the last
+ * TREND_WINDOW_SIZE utilization sums and creates contention when
+ * forecast for PREDICTION_HORIZON iterations ahead crosses the threshold.
+ * Severity is then the predicted amount of CPUs above the threshold.
  */
 class OverloadDetector :
     public Consumer<ResourceUsage>,
@@ -56,6 +76,9 @@ class OverloadDetector :
     SerenityConfig config = OverloadDetectorConfig(_conf);
     this->cfgUtilizationThreshold =
       config.getD(detector::THRESHOLD);
+    this->cfgPredictive = config.getB(detector::PREDICTIVE);
+    this->cfgTrendWindowSize = config.getU64(detector::TREND_WINDOW_SIZE);
+    this->cfgPredictionHorizon = config.getD(detector::PREDICTION_HORIZON);
   }
 
   ~OverloadDetector() {}
@@ -65,11 +88,22 @@ class OverloadDetector :
   static const constexpr char* NAME = "OverloadDetector";
 
  protected:
+  /**
+   * Stores utilization sum in trend window and returns forecast.
+   */
+  double_t predictUtilization(double_t agentSumCpus);
+
   const Tag tag;
   const lambda::function<usage::GetterFunction> cpuUsageGetFunction;
 
+  //!< Last utilization sums (oldest first) for trend fitting.
+  std::deque<double_t> utilizationWindow;
+
   // cfg parameters.
   double_t cfgUtilizationThreshold;
+  bool cfgPredictive;
+  uint64_t cfgTrendWindowSize;
+  double_t cfgPredictionHorizon;
 };
 
 }  // namespace serenity
@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "messages/serenity.hpp"
 
 #include "serenity/serenity.hpp"
 
@@ -30,8 +33,36 @@ class SignalAnalyzer {
 
   virtual Result<Detection> processSample(double_t in) = 0;
 
+  /**
+   * Processes several signals of the same executor sampled together.
+   * Scalar analyzers accept exactly one signal.
+   */
+  virtual Result<Detection> processSamples(const std::vector<double_t>& in) {
+    if (in.size() != 1) {
+      return Error("Analyzer accepts one signal, got " +
+                   std::to_string(in.size()));
+    }
+
+    return processSample(in.front());
+  }
+
   virtual Try<Nothing> resetSignalRecovering() = 0;
 
+  /**
+   * Starts analysis from known baseline of the signal instead of cold
+   * state. Analyzers without such notion ignore it.
+   */
+  virtual void seed(double_t baseline) {}
+
+  /**
+   * Saves analyzer state. Stateless analyzers do not need to implement it.
+   */
+  virtual void checkpoint(FilterCheckpoint_Executor* executor) const {}
+
+  virtual Try<Nothing> restore(const FilterCheckpoint_Executor& executor) {
+    return Nothing();
+  }
+
  protected:
   const Tag tag;
 
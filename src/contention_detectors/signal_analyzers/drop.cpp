@@ -6,6 +6,7 @@
 #include "messages/serenity.hpp"
 
 #include "stout/none.hpp"
+#include "stout/stringify.hpp"
 
 namespace mesos {
 namespace serenity {
@@ -93,6 +94,51 @@ Try<Nothing> SignalDropAnalyzer::resetSignalRecovering() {
 }
 
 
+void SignalDropAnalyzer::seed(double_t baseline) {
+  // Values are replaced in place, so base points stay valid.
+  for (double_t& value : this->window) {
+    value = baseline;
+  }
+}
+
+
+void SignalDropAnalyzer::checkpoint(
+    FilterCheckpoint_Executor* executor) const {
+  for (double_t value : this->window) {
+    executor->add_window(value);
+  }
+
+  if (this->valueBeforeDrop.isSome()) {
+    executor->set_value_before_drop(this->valueBeforeDrop.get());
+  }
+}
+
+
+Try<Nothing> SignalDropAnalyzer::restore(
+    const FilterCheckpoint_Executor& executor) {
+  if (static_cast<size_t>(executor.window_size()) != this->window.size()) {
+    return Error("Checkpoint window size " +
+                 stringify(executor.window_size()) +
+                 " does not match configured " +
+                 stringify(this->window.size()));
+  }
+
+  // Values are replaced in place, so base points stay valid.
+  int index = 0;
+  for (double_t& value : this->window) {
+    value = executor.window(index++);
+  }
+
+  if (executor.has_value_before_drop()) {
+    this->valueBeforeDrop = executor.value_before_drop();
+  } else {
+    this->valueBeforeDrop = None();
+  }
+
+  return Nothing();
+}
+
+
 Result<Detection> SignalDropAnalyzer::_processSample(double_t in) {
   // Check if we track some contention.
   if (this->valueBeforeDrop.isSome()) {
@@ -118,13 +164,13 @@ Result<Detection> SignalDropAnalyzer::_processSample(double_t in) {
   double_t currentDropFraction = 0;
   double_t meanValueBeforeDrop = 0;
   this->dropVotes = 0;
+  // Base point values are formatted only when they will be logged.
+  const bool verbose = tag.isVerbose(1);
   std::stringstream basePointValues;
 
   // Make a voting within all basePoints(checkpoints). Drop will be
   // detected when dropVotes will be >= Quorum number.
   for (std::list<double_t>::iterator basePoint : this->basePoints) {
-    basePointValues << " " << (double_t)(*basePoint);
-
     // Check if drop happened for this basePoint.
     double_t dropFraction = 1.0 - (in / (*basePoint));
     if (dropFraction >= this->cfgFractionalThreshold) {
@@ -132,12 +178,17 @@ Result<Detection> SignalDropAnalyzer::_processSample(double_t in) {
       this->dropVotes++;
       currentDropFraction += dropFraction;
       meanValueBeforeDrop += (double_t)(*basePoint);
+    }
 
-      basePointValues << "[-] ";
-    } else if ((double_t)(*basePoint) >= in) {
-      basePointValues << "[~] ";
-    } else {
-      basePointValues << "[+] ";
+    if (verbose) {
+      basePointValues << " " << (double_t)(*basePoint);
+      if (dropFraction >= this->cfgFractionalThreshold) {
+        basePointValues << "[-] ";
+      } else if ((double_t)(*basePoint) >= in) {
+        basePointValues << "[~] ";
+      } else {
+        basePointValues << "[+] ";
+      }
     }
   }
 
@@ -146,7 +197,7 @@ Result<Detection> SignalDropAnalyzer::_processSample(double_t in) {
     meanValueBeforeDrop /= this->dropVotes;
   }  // In other cases theses variables == 0.
 
-  SERENITY_LOG(INFO)
+  SERENITY_VLOG(1)
   << "{inValue: " << in
   << " |baseValues:" << basePointValues.str()
   << " |currentDrop %: " << currentDropFraction * 100
@@ -83,7 +83,8 @@ class SignalDropAnalyzerConfig : public SerenityConfig {
 /**
  * Dynamic implementation of sequential change point detection.
  *
- * There is no warm-up phase - values starts as DEFAULT_START_VALUE.
+ * There is no warm-up phase - values starts as DEFAULT_START_VALUE (or
+ * baseline given to seed()).
  * Algorithm steps:
  * - Fetch several basePoints depending on parameters e.g T-1, T-2, T-4, T-8.
  * - Make a voting within all basePoints(checkpoints). Drop will be
@@ -126,6 +127,20 @@ class SignalDropAnalyzer : public SignalAnalyzer {
 
   virtual Try<Nothing> resetSignalRecovering();
 
+  /**
+   * Fills the window with baseline, so drop below it is detected
+   * from the first sample.
+   */
+  void seed(double_t baseline) override;
+
+  void checkpoint(FilterCheckpoint_Executor* executor) const override;
+
+  /**
+   * Refills window with saved samples. Window size needs to match current
+   * configuration.
+   */
+  Try<Nothing> restore(const FilterCheckpoint_Executor& executor) override;
+
   /**
    * Move each base point to next iterator.
    */
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "contention_detectors/signal_analyzers/mahalanobis.hpp"
+
+#include "stout/none.hpp"
+#include "stout/stringify.hpp"
+
+namespace mesos {
+namespace serenity {
+
+// Variance of 1% deviation from the mean is added to variance of each
+// signal, so perfectly stable (or perfectly correlated) signals do not turn
+// noise into huge distances and covariance is always invertible.
+static constexpr double_t MIN_RELATIVE_DEVIATION = 0.01;
+static constexpr double_t MIN_VARIANCE = 1e-12;
+
+
+MahalanobisAnalyzer::MahalanobisAnalyzer(
+    const Tag& _tag,
+    const SerenityConfig& _config,
+    size_t _dimensions)
+  : SignalAnalyzer(_tag),
+    dimensions(_dimensions),
+    mean(_dimensions, 0.0),
+    covariance(_dimensions * _dimensions, 0.0),
+    samples(0),
+    anomalies(0) {
+  SerenityConfig config = MahalanobisAnalyzerConfig(_config);
+  this->cfgThreshold = config.getD(detector::MAHALANOBIS_THRESHOLD);
+  this->cfgAlpha = config.getD(detector::MAHALANOBIS_ALPHA);
+  this->cfgWarmupSamples = config.getU64(detector::WARMUP_SAMPLES);
+  this->cfgConsecutiveSamples = config.getU64(detector::CONSECUTIVE_SAMPLES);
+  this->cfgMaxAnomalousSamples =
+    config.getU64(detector::MAX_ANOMALOUS_SAMPLES);
+  this->cfgSeverityFraction = config.getD(detector::SEVERITY_FRACTION);
+}
+
+
+Result<Detection> MahalanobisAnalyzer::processSample(double_t in) {
+  return this->processSamples(std::vector<double_t>{in});
+}
+
+
+Result<Detection> MahalanobisAnalyzer::processSamples(
+    const std::vector<double_t>& in) {
+  if (in.size() != this->dimensions) {
+    return Error("Analyzer expects " + stringify(this->dimensions) +
+                 " signals, got " + stringify(in.size()));
+  }
+
+  if (this->samples < this->cfgWarmupSamples) {
+    this->learn(in);
+    return None();
+  }
+
+  Try<double_t> squaredDistance = this->distance(in);
+  if (squaredDistance.isError()) {
+    return Error(squaredDistance.error());
+  }
+
+  if (squaredDistance.get() <= this->cfgThreshold ||
+      in.front() >= this->mean.front()) {
+    this->anomalies = 0;
+    this->learn(in);
+    return None();
+  }
+
+  this->anomalies++;
+  SERENITY_VLOG(1) << "Anomalous sample (" << this->anomalies << " in a row)"
+                   << " with squared distance " << squaredDistance.get();
+  if (this->cfgMaxAnomalousSamples > 0 &&
+      this->anomalies >= this->cfgMaxAnomalousSamples) {
+    SERENITY_LOG(INFO) << "Signals did not recover after "
+                       << this->anomalies << " anomalous samples. "
+                       << "Learning new baseline.";
+    this->resetSignalRecovering();
+    this->learn(in);
+    return None();
+  }
+
+  if (this->anomalies < this->cfgConsecutiveSamples) {
+    return None();
+  }
+
+  double_t severity = -1;
+  if (this->cfgSeverityFraction > 0) {
+    severity = this->cfgSeverityFraction *
+      (1.0 - std::sqrt(this->cfgThreshold / squaredDistance.get()));
+  }
+
+  return this->createContention(severity);
+}
+
+
+Try<Nothing> MahalanobisAnalyzer::resetSignalRecovering() {
+  this->samples = 0;
+  this->anomalies = 0;
+  return Nothing();
+}
+
+
+Try<double_t> MahalanobisAnalyzer::distance(
+    const std::vector<double_t>& in) const {
+  const size_t n = this->dimensions;
+
+  // Regularized covariance.
+  std::vector<double_t> matrix(this->covariance);
+  for (size_t i = 0; i < n; i++) {
+    const double_t minVariance = std::max(
+        MIN_VARIANCE,
+        std::pow(MIN_RELATIVE_DEVIATION * this->mean[i], 2));
+    matrix[i * n + i] += minVariance;
+  }
+
+  // Cholesky decomposition in place (lower triangle).
+  for (size_t j = 0; j < n; j++) {
+    double_t diagonal = matrix[j * n + j];
+    for (size_t k = 0; k < j; k++) {
+      diagonal -= matrix[j * n + k] * matrix[j * n + k];
+    }
+    if (diagonal <= 0) {
+      return Error("Covariance matrix is not positive definite");
+    }
+    matrix[j * n + j] = std::sqrt(diagonal);
+
+    for (size_t i = j + 1; i < n; i++) {
+      double_t value = matrix[i * n + j];
+      for (size_t k = 0; k < j; k++) {
+        value -= matrix[i * n + k] * matrix[j * n + k];
+      }
+      matrix[i * n + j] = value / matrix[j * n + j];
+    }
+  }
+
+  // Forward substitution: L * y = (x - mean). Distance is |y|^2.
+  std::vector<double_t> y(n, 0.0);
+  double_t squaredDistance = 0;
+  for (size_t i = 0; i < n; i++) {
+    double_t value = in[i] - this->mean[i];
+    for (size_t k = 0; k < i; k++) {
+      value -= matrix[i * n + k] * y[k];
+    }
+    y[i] = value / matrix[i * n + i];
+    squaredDistance += y[i] * y[i];
+  }
+
+  return squaredDistance;
+}
+
+
+void MahalanobisAnalyzer::learn(const std::vector<double_t>& in) {
+  const size_t n = this->dimensions;
+
+  if (this->samples == 0) {
+    this->mean = in;
+    std::fill(this->covariance.begin(), this->covariance.end(), 0.0);
+    this->samples++;
+    return;
+  }
+
+  // Plain average while warming up, so first samples are not neglected.
+  const double_t alpha =
+    std::max(this->cfgAlpha, 1.0 / (this->samples + 1));
+
+  std::vector<double_t> diff(n);
+  for (size_t i = 0; i < n; i++) {
+    diff[i] = in[i] - this->mean[i];
+    this->mean[i] += alpha * diff[i];
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      this->covariance[i * n + j] = (1.0 - alpha) *
+        (this->covariance[i * n + j] + alpha * diff[i] * diff[j]);
+    }
+  }
+
+  this->samples++;
+}
+
+
+void MahalanobisAnalyzer::checkpoint(
+    FilterCheckpoint_Executor* executor) const {
+  for (double_t value : this->mean) {
+    executor->add_mean(value);
+  }
+  for (double_t value : this->covariance) {
+    executor->add_covariance(value);
+  }
+  executor->set_samples(this->samples);
+}
+
+
+Try<Nothing> MahalanobisAnalyzer::restore(
+    const FilterCheckpoint_Executor& executor) {
+  if (static_cast<size_t>(executor.mean_size()) != this->dimensions ||
+      static_cast<size_t>(executor.covariance_size()) !=
+        this->dimensions * this->dimensions) {
+    return Error("Checkpoint has different number of signals");
+  }
+
+  this->mean.assign(executor.mean().begin(), executor.mean().end());
+  this->covariance.assign(
+      executor.covariance().begin(), executor.covariance().end());
+  this->samples = executor.samples();
+  this->anomalies = 0;
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,137 @@
+#ifndef SERENITY_MAHALANOBIS_ANALYZER_HPP
+#define SERENITY_MAHALANOBIS_ANALYZER_HPP
+
+#include <string>
+#include <vector>
+
+#include "contention_detectors/signal_analyzers/base.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/nothing.hpp"
+#include "stout/result.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+#define MAHALANOBIS_ANALYZER_NAME "MahalanobisAnalyzer"
+
+class MahalanobisAnalyzerConfig : public SerenityConfig {
+ public:
+  MahalanobisAnalyzerConfig() {}
+
+  explicit MahalanobisAnalyzerConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    this->fields[detector::ANALYZER_TYPE] = MAHALANOBIS_ANALYZER_NAME;
+
+    //! double_t
+    //! Squared Mahalanobis distance above which sample is anomalous.
+    //! Default is roughly 99.7% quantile of chi-squared with 4 degrees
+    //! of freedom.
+    this->fields[detector::MAHALANOBIS_THRESHOLD] =
+      detector::DEFAULT_MAHALANOBIS_THRESHOLD;
+
+    //! double_t
+    //! Weight of new sample in running mean and covariance. The smaller
+    //! alpha, the longer baseline is remembered.
+    this->fields[detector::MAHALANOBIS_ALPHA] =
+      detector::DEFAULT_MAHALANOBIS_ALPHA;
+
+    //! uint64_t
+    //! Number of samples used only to learn the baseline.
+    this->fields[detector::WARMUP_SAMPLES] = detector::DEFAULT_WARMUP_SAMPLES;
+
+    //! uint64_t
+    //! Anomalous samples in a row needed to create contention.
+    this->fields[detector::CONSECUTIVE_SAMPLES] =
+      detector::DEFAULT_CONSECUTIVE_SAMPLES;
+
+    //! uint64_t
+    //! Anomalous samples in a row after which the shift is taken as a
+    //! lasting change and baseline is learned from scratch.
+    //! If 0 then baseline is never relearned.
+    this->fields[detector::MAX_ANOMALOUS_SAMPLES] =
+      detector::DEFAULT_MAX_ANOMALOUS_SAMPLES;
+
+    //! double_t
+    //! Severity for the distance: fraction * (1 - sqrt(threshold / distance)).
+    //! If -1 then unknown severity will be reported.
+    this->fields[detector::SEVERITY_FRACTION] =
+      detector::DEFAULT_SEVERITY_FRACTION;
+  }
+};
+
+
+/**
+ * Multivariate analyzer of several signals of the same executor, e.g.
+ * IPC, IPS, LLC misses per kilo instruction and CPU usage.
+ *
+ * It keeps exponentially weighted mean and covariance of the signals (so
+ * memory per executor is constant) and measures Mahalanobis distance of
+ * each new sample from them. It catches interference (e.g. memory
+ * bandwidth) which changes relation between signals without clean drop
+ * of any single one of them.
+ *
+ * First signal is the performance signal - sample is anomalous only when
+ * its distance is above threshold and the first signal is below its mean.
+ * Anomalous samples are not learned, so contention does not become the
+ * new baseline. When corrections do not bring signals back within
+ * MAX_ANOMALOUS_SAMPLES, the shift is taken as a lasting change (e.g. new
+ * phase of the workload) and baseline is learned from scratch - the same
+ * as after resetSignalRecovering().
+ */
+class MahalanobisAnalyzer : public SignalAnalyzer {
+ public:
+  MahalanobisAnalyzer(
+      const Tag& _tag,
+      const SerenityConfig& _config,
+      size_t _dimensions);
+
+  Result<Detection> processSample(double_t in) override;
+
+  Result<Detection> processSamples(const std::vector<double_t>& in) override;
+
+  Try<Nothing> resetSignalRecovering() override;
+
+  void checkpoint(FilterCheckpoint_Executor* executor) const override;
+
+  Try<Nothing> restore(const FilterCheckpoint_Executor& executor) override;
+
+  /**
+   * Squared Mahalanobis distance of the sample from learned baseline.
+   */
+  Try<double_t> distance(const std::vector<double_t>& in) const;
+
+ protected:
+  void learn(const std::vector<double_t>& in);
+
+  const size_t dimensions;
+
+  std::vector<double_t> mean;
+  //! Row major dimensions x dimensions matrix.
+  std::vector<double_t> covariance;
+  uint64_t samples;
+  uint64_t anomalies;
+
+  // cfg parameters.
+  double_t cfgThreshold;
+  double_t cfgAlpha;
+  uint64_t cfgWarmupSamples;
+  uint64_t cfgConsecutiveSamples;
+  uint64_t cfgMaxAnomalousSamples;
+  double_t cfgSeverityFraction;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_MAHALANOBIS_ANALYZER_HPP
@@ -1,5 +1,7 @@
 #include <list>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "contention_detectors/signal_based.hpp"
 
@@ -23,7 +25,7 @@ Try<Nothing> SignalBasedDetector::consume(const ResourceUsage& usage) {
   Contentions product;
   for (const ResourceUsage_Executor& executor : productionExecutors) {
     if (!ResourceUsageHelper::isExecutorHasStatistics(executor)) {
-      SERENITY_LOG(INFO) << "No statistics for executor "
+      SERENITY_VLOG(1) << "No statistics for executor "
                          << executor.executor_info().executor_id();
       continue;
     }
@@ -31,47 +33,69 @@ Try<Nothing> SignalBasedDetector::consume(const ResourceUsage& usage) {
     // Check if change point Detector for given executor exists.
     auto cpDetector = this->detectors.find(executor.executor_info());
     if (cpDetector == this->detectors.end()) {
-      SERENITY_LOG(INFO) << "Not found executor: "
+      SERENITY_VLOG(1) << "Not found executor: "
                         << executor.executor_info().executor_id();
-      this->detectors.insert(
+      std::unique_ptr<SignalAnalyzer> analyzer = this->createAnalyzer();
+      Option<double_t> baseline = None();
+      if (this->baselineFunction) {
+        baseline = this->baselineFunction(executor.executor_info());
+      }
+
+      if (baseline.isSome()) {
+        SERENITY_VLOG(1) << "Starting analyzer from workload baseline "
+                         << baseline.get();
+        analyzer->seed(baseline.get());
+      }
+
+      cpDetector = this->detectors.insert(
         std::pair<ExecutorInfo, std::unique_ptr<SignalAnalyzer>>(
           executor.executor_info(),
-          std::unique_ptr<SignalAnalyzer>(
-            new SignalDropAnalyzer(tag, this->detectorConf))));
+          std::move(analyzer))).first;
 
-    } else {
-      // Check if previousSample for given executor exists.
-      // Get proper value.
-      Try<double_t> value = this->getValue(executor);
-      if (value.isError()) {
-        SERENITY_LOG(ERROR) << value.error();
+      // Without baseline first sample is not analyzed.
+      if (baseline.isNone()) {
         continue;
       }
+    }
 
-      SERENITY_LOG(INFO) << "Starting processing executor: "
-                         << executor.executor_info().executor_id();
-      // Perform change point detection.
-      Result<Detection> cpDetected =
-      (cpDetector->second)->processSample(value.get());
-      if (cpDetected.isError()) {
-        SERENITY_LOG(ERROR) << cpDetected.error();
-        continue;
+    // Get proper values.
+    std::vector<double_t> values;
+    values.reserve(this->getValues.size());
+    for (const auto& getValue : this->getValues) {
+      Try<double_t> value = getValue(executor);
+      if (value.isError()) {
+        SERENITY_LOG(ERROR) << value.error();
+        break;
       }
+      values.push_back(value.get());
+    }
+    if (values.size() != this->getValues.size()) {
+      continue;
+    }
 
-      // Detected contention.
-      if (cpDetected.isSome()) {
-        if (revocableExecutors.empty()) {
-          SERENITY_LOG(INFO) << "Contention spotted, however there are no "
-                  << "Best effort tasks on the host. Assuming false positive";
-          (cpDetector->second)->resetSignalRecovering();
-        } else {
-          SERENITY_LOG(INFO) << "Signal contention spotted";
-          product.push_back(createContention(
-          cpDetected.get().severity,
-          contentionType,
-          WID(executor.executor_info()).getWorkID(),
-          executor.statistics().timestamp()));
-        }
+    SERENITY_VLOG(2) << "Starting processing executor: "
+                       << executor.executor_info().executor_id();
+    // Perform change point detection.
+    Result<Detection> cpDetected =
+    (cpDetector->second)->processSamples(values);
+    if (cpDetected.isError()) {
+      SERENITY_LOG(ERROR) << cpDetected.error();
+      continue;
+    }
+
+    // Detected contention.
+    if (cpDetected.isSome()) {
+      if (revocableExecutors.empty()) {
+        SERENITY_LOG(INFO) << "Contention spotted, however there are no "
+                << "Best effort tasks on the host. Assuming false positive";
+        (cpDetector->second)->resetSignalRecovering();
+      } else {
+        SERENITY_LOG(INFO) << "Signal contention spotted";
+        product.push_back(createContention(
+        cpDetected.get().severity,
+        contentionType,
+        WID(executor.executor_info()).getWorkID(),
+        executor.statistics().timestamp()));
       }
     }
   }
@@ -80,5 +104,49 @@ Try<Nothing> SignalBasedDetector::consume(const ResourceUsage& usage) {
   return Nothing();
 }
 
+
+
+std::unique_ptr<SignalAnalyzer> SignalBasedDetector::createAnalyzer() {
+  if (this->detectorConf.hasKey(detector::ANALYZER_TYPE) &&
+      this->detectorConf.getS(detector::ANALYZER_TYPE) ==
+        MAHALANOBIS_ANALYZER_NAME) {
+    return std::unique_ptr<SignalAnalyzer>(new MahalanobisAnalyzer(
+        tag, this->detectorConf, this->getValues.size()));
+  }
+
+  return std::unique_ptr<SignalAnalyzer>(
+      new SignalDropAnalyzer(tag, this->detectorConf));
+}
+
+
+void SignalBasedDetector::checkpoint(FilterCheckpoint* checkpoint) const {
+  for (const auto& detector : this->detectors) {
+    FilterCheckpoint_Executor* executor = checkpoint->add_executors();
+    executor->mutable_work_id()->CopyFrom(WID(detector.first).getWorkID());
+    detector.second->checkpoint(executor);
+  }
+}
+
+
+Try<Nothing> SignalBasedDetector::restore(
+    const FilterCheckpoint& checkpoint) {
+  this->detectors.clear();
+  for (const FilterCheckpoint_Executor& executor : checkpoint.executors()) {
+    std::unique_ptr<SignalAnalyzer> analyzer = this->createAnalyzer();
+
+    Try<Nothing> restored = analyzer->restore(executor);
+    if (restored.isError()) {
+      // Analyzer starts cold for this executor.
+      SERENITY_LOG(WARNING) << restored.error();
+      continue;
+    }
+
+    this->detectors[WID(executor.work_id()).getExecutorInfo()] =
+      std::move(analyzer);
+  }
+
+  return Nothing();
+}
+
 }  // namespace serenity
 }  // namespace mesos
@@ -5,14 +5,17 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "glog/logging.h"
 
-#include "contention_detectors/signal_analyzers/drop.hpp"
 #include "contention_detectors/signal_analyzers/base.hpp"
+#include "contention_detectors/signal_analyzers/drop.hpp"
+#include "contention_detectors/signal_analyzers/mahalanobis.hpp"
 
 #include "messages/serenity.hpp"
 
+#include "serenity/checkpoint.hpp"
 #include "serenity/config.hpp"
 #include "serenity/data_utils.hpp"
 #include "serenity/executor_map.hpp"
@@ -20,6 +23,7 @@
 #include "serenity/serenity.hpp"
 #include "serenity/resource_helper.hpp"
 #include "serenity/wid.hpp"
+#include "serenity/workload_profile.hpp"
 
 #include "stout/lambda.hpp"
 #include "stout/nothing.hpp"
@@ -34,10 +38,15 @@ namespace serenity {
  * SignalBasedDetector looks at specific metric of each production executor
  * and emits contention when it's signal drops bellow certain percent of
  * previous value.
+ *
+ * Analyzer is chosen by ANALYZER_TYPE in detector configuration:
+ * SignalDropAnalyzer (default) for single signal or MahalanobisAnalyzer,
+ * which analyzes all given signals of the executor together.
  */
 class SignalBasedDetector :
     public Consumer<ResourceUsage>,
-    public Producer<Contentions> {
+    public Producer<Contentions>,
+    public Checkpointable {
  public:
   SignalBasedDetector(
       Consumer<Contentions>* _consumer,
@@ -45,23 +54,70 @@ class SignalBasedDetector :
       SerenityConfig _detectorConf,
       const Tag& _tag = Tag(QOS_CONTROLLER, "SignalBasedDetector"),
       const Contention_Type _contentionType = Contention_Type_IPC)
+    : SignalBasedDetector(
+        _consumer,
+        std::vector<lambda::function<usage::GetterFunction>>{_getValue},
+        _detectorConf,
+        _tag,
+        _contentionType) {}
+
+  /**
+   * Detector of several signals. Consumer can be added later (it can be
+   * nullptr).
+   */
+  SignalBasedDetector(
+      Consumer<Contentions>* _consumer,
+      const std::vector<lambda::function<usage::GetterFunction>>& _getValues,
+      SerenityConfig _detectorConf,
+      const Tag& _tag = Tag(QOS_CONTROLLER, "SignalBasedDetector"),
+      const Contention_Type _contentionType = Contention_Type_IPC)
     : tag(_tag),
-      Producer<Contentions>(_consumer),
       detectors(ExecutorMap<std::unique_ptr<SignalAnalyzer>>()),
-      getValue(_getValue),
+      getValues(_getValues),
       detectorConf(_detectorConf),
-      contentionType(_contentionType) {}
+      contentionType(_contentionType) {
+    if (_consumer != nullptr) {
+      this->addConsumer(_consumer);
+    }
+  }
 
   ~SignalBasedDetector() {}
 
   Try<Nothing> consume(const ResourceUsage& usage) override;
 
+  void checkpoint(FilterCheckpoint* checkpoint) const override;
+
+  Try<Nothing> restore(const FilterCheckpoint& checkpoint) override;
+
+  /**
+   * Forgets analyzers of executors which are not in given (unfiltered)
+   * usage. Detector is usually fed with filtered usage, so it cannot do it
+   * itself.
+   */
+  void prune(const ResourceUsage& usage) {
+    pruneExecutors(usage, &this->detectors);
+  }
+
+  /**
+   * Analyzers of new executors with known baseline (e.g. from workload
+   * profile) start from it and analyze the first sample.
+   */
+  void setBaseline(const lambda::function<BaselineFunction>& _baseline) {
+    this->baselineFunction = _baseline;
+  }
+
   static const constexpr char* NAME = "SignalBasedDetector";
 
  protected:
+  /**
+   * Creates analyzer of ANALYZER_TYPE from detector configuration.
+   */
+  std::unique_ptr<SignalAnalyzer> createAnalyzer();
+
   const Tag tag;
   const Contention_Type contentionType;
-  const lambda::function<usage::GetterFunction> getValue;
+  const std::vector<lambda::function<usage::GetterFunction>> getValues;
+  lambda::function<BaselineFunction> baselineFunction;
 
   // Detections.
   ExecutorMap<std::unique_ptr<SignalAnalyzer>> detectors;
@@ -8,6 +8,8 @@
 
 #include "mesos/mesos.hpp"
 
+#include "serenity/wid.hpp"
+
 namespace mesos {
 namespace serenity {
 
@@ -16,13 +18,24 @@ using std::pair;
 using std::string;
 
 
+namespace {
+
+// Counters can be reset (e.g. executor's network namespace was recreated),
+// so negative difference is treated as zero.
+inline uint64_t sampledCounter(uint64_t previous, uint64_t current) {
+  return current > previous ? current - previous : 0;
+}
+
+}  // namespace
+
+
 CumulativeFilter::~CumulativeFilter() {}
 
 
 Try<Nothing> CumulativeFilter::consume(const ResourceUsage& in) {
   std::unique_ptr<ExecutorSet> newSamples(new ExecutorSet());
   double_t totalCpuUsage = 0;
-  ResourceUsage product;
+  product.Clear();
 
   for (const ResourceUsage_Executor& inExec : in.executors()) {
     string executor_id = "<unknown>";
@@ -49,57 +62,69 @@ Try<Nothing> CumulativeFilter::consume(const ResourceUsage& in) {
       auto previousSample = this->previousSamples->find(inExec);
       if (previousSample != this->previousSamples->end()) {
         // Cumulate to sample conversion.
-        ResourceUsage_Executor* outExec = new ResourceUsage_Executor(inExec);
+        ResourceUsage_Executor* outExec = product.add_executors();
+        outExec->CopyFrom(inExec);
 
         // Convert timestamp.
         // NOTE(bplotka): Make sure we don't use timestamp as absolute counter
         // in next filters.
         if (previousSample->statistics().has_timestamp() &&
             inExec.statistics().has_timestamp()) {
-          // SERENITY_LOG(INFO) << "timestamp before = "
-          //                    << inExec.statistics().timestamp();
+          SERENITY_DLOG(2) << "timestamp before = "
+                           << inExec.statistics().timestamp();
           double_t sampled =
             inExec.statistics().timestamp() -
             previousSample->statistics().timestamp();
           outExec->mutable_statistics()->set_timestamp(sampled);
-          // SERENITY_LOG(INFO) << "timestamp sampled = " << sampled;
+          SERENITY_DLOG(2) << "timestamp sampled = " << sampled;
         }
 
         // Convert cpus_system_time_secs.
         if (previousSample->statistics().has_cpus_system_time_secs() &&
             inExec.statistics().has_cpus_system_time_secs()) {
-          // SERENITY_LOG(INFO) << "cpus_system_time_secs before = "
-          // <<  inExec.statistics().cpus_system_time_secs();
+          SERENITY_DLOG(2) << "cpus_system_time_secs before = "
+                           << inExec.statistics().cpus_system_time_secs();
           double_t sampled =
             inExec.statistics().cpus_system_time_secs() -
             previousSample->statistics().cpus_system_time_secs();
           outExec->mutable_statistics()->set_cpus_system_time_secs(sampled);
-          // SERENITY_LOG(INFO) << "cpus_system_time_secs sampled = "
-          // << sampled;
+          SERENITY_DLOG(2) << "cpus_system_time_secs sampled = " << sampled;
         }
 
         // Convert cpus_user_time_secs.
         if (previousSample->statistics().has_cpus_user_time_secs() &&
             inExec.statistics().has_cpus_user_time_secs()) {
-          // SERENITY_LOG(INFO) << "cpus_user_time_secs before = "
-          // <<  inExec.statistics().cpus_user_time_secs();
+          SERENITY_DLOG(2) << "cpus_user_time_secs before = "
+                           << inExec.statistics().cpus_user_time_secs();
           double_t sampled =
             inExec.statistics().cpus_user_time_secs() -
             previousSample->statistics().cpus_user_time_secs();
           outExec->mutable_statistics()->set_cpus_user_time_secs(sampled);
+          SERENITY_DLOG(2) << "cpus_user_time_secs sampled = " << sampled;
+        }
 
-          // SERENITY_LOG(INFO) << "cpus_user_time_secs sampled = " << sampled;
+        // Convert net_rx_bytes.
+        if (previousSample->statistics().has_net_rx_bytes() &&
+            inExec.statistics().has_net_rx_bytes()) {
+          outExec->mutable_statistics()->set_net_rx_bytes(sampledCounter(
+              previousSample->statistics().net_rx_bytes(),
+              inExec.statistics().net_rx_bytes()));
         }
 
-        product.mutable_executors()->AddAllocated(outExec);
+        // Convert net_tx_bytes.
+        if (previousSample->statistics().has_net_tx_bytes() &&
+            inExec.statistics().has_net_tx_bytes()) {
+          outExec->mutable_statistics()->set_net_tx_bytes(sampledCounter(
+              previousSample->statistics().net_tx_bytes(),
+              inExec.statistics().net_tx_bytes()));
+        }
 
       } else {
         // TODO(bplotka): Does it make sense to assume 0 as previous value?
         // (Are these values counted from 0)?
         // If yes we can continue pipeline with these:
-        SERENITY_LOG(INFO) << "First iteration for Executor " << executor_id;
-        ResourceUsage_Executor* outExec = new ResourceUsage_Executor(inExec);
-        product.mutable_executors()->AddAllocated(outExec);
+        SERENITY_VLOG(1) << "First iteration for Executor " << executor_id;
+        product.add_executors()->CopyFrom(inExec);
       }
     }
   }
@@ -117,12 +142,35 @@ Try<Nothing> CumulativeFilter::consume(const ResourceUsage& in) {
   product.mutable_total()->CopyFrom(in.total());
 
   // Continue pipeline.
-  SERENITY_LOG(INFO) << "Continuing with "
+  SERENITY_VLOG(1) << "Continuing with "
   << product.executors_size() << " executor(s).";
   produce(product);
 
   return Nothing();
 }
 
+
+
+void CumulativeFilter::checkpoint(FilterCheckpoint* checkpoint) const {
+  for (const ResourceUsage_Executor& previousSample : *this->previousSamples) {
+    FilterCheckpoint_Executor* executor = checkpoint->add_executors();
+    executor->mutable_work_id()->CopyFrom(
+        WID(previousSample.executor_info()).getWorkID());
+    executor->mutable_previous_sample()->CopyFrom(previousSample);
+  }
+}
+
+
+Try<Nothing> CumulativeFilter::restore(const FilterCheckpoint& checkpoint) {
+  this->previousSamples->clear();
+  for (const FilterCheckpoint_Executor& executor : checkpoint.executors()) {
+    if (executor.has_previous_sample()) {
+      this->previousSamples->insert(executor.previous_sample());
+    }
+  }
+
+  return Nothing();
+}
+
 }  // namespace serenity
 }  // namespace mesos
@@ -8,14 +8,22 @@
 
 #include "mesos/mesos.hpp"
 
+#include "serenity/checkpoint.hpp"
 #include "serenity/serenity.hpp"
 #include "serenity/executor_set.hpp"
 
 namespace mesos {
 namespace serenity {
 
+/**
+ * CumulativeFilter converts cumulative statistics of executors into the
+ * difference from previous sample: timestamp (into sampling duration),
+ * CPU times and network rx / tx bytes. Executors are passed unchanged in
+ * their first iteration.
+ */
 class CumulativeFilter :
-    public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
+    public Consumer<ResourceUsage>, public Producer<ResourceUsage>,
+    public Checkpointable {
  public:
   explicit CumulativeFilter(
      Consumer<ResourceUsage>* _consumer,
@@ -28,9 +36,17 @@ class CumulativeFilter :
 
   Try<Nothing> consume(const ResourceUsage& in);
 
+  void checkpoint(FilterCheckpoint* checkpoint) const override;
+
+  Try<Nothing> restore(const FilterCheckpoint& checkpoint) override;
+
  protected:
   const Tag tag;
   std::unique_ptr<ExecutorSet> previousSamples;
+
+  //! Reused between iterations - cleared protobuf executors are recycled
+  //! instead of allocated per executor every iteration.
+  ResourceUsage product;
 };
 
 }  // namespace serenity
@@ -33,6 +33,40 @@ double_t ExponentialMovingAverage::calculateEMA(
 }
 
 
+void ExponentialMovingAverage::checkpoint(
+    FilterCheckpoint_Executor* executor) const {
+  if (this->uninitialized) {
+    return;
+  }
+
+  executor->set_ema(this->prevEma);
+  executor->set_previous_value(this->prevSample);
+  executor->set_previous_timestamp(this->prevSampleTimestamp);
+}
+
+
+void ExponentialMovingAverage::restore(
+    const FilterCheckpoint_Executor& executor) {
+  if (!executor.has_ema()) {
+    this->uninitialized = true;
+    return;
+  }
+
+  this->prevEma = executor.ema();
+  this->prevSample = executor.previous_value();
+  this->prevSampleTimestamp = executor.previous_timestamp();
+  this->uninitialized = false;
+}
+
+
+void ExponentialMovingAverage::seed(double_t baseline) {
+  this->prevEma = baseline;
+  this->prevSample = baseline;
+  this->prevSampleTimestamp = 0;
+  this->uninitialized = false;
+}
+
+
 double_t ExponentialMovingAverage::exponentialMovingAverageIrregular(
     double_t sample, double_t sampleTimestamp) const {
   double_t deltaTime = sampleTimestamp - this->prevSampleTimestamp;
@@ -51,9 +85,9 @@ double_t ExponentialMovingAverage::exponentialMovingAverageRegular(
 
 
 Try<Nothing> EMAFilter::consume(const ResourceUsage& in) {
-  ResourceUsage product;
+  product.Clear();
 
-  for (ResourceUsage_Executor inExec : in.executors()) {
+  for (const ResourceUsage_Executor& inExec : in.executors()) {
     if (!inExec.has_executor_info()) {
       SERENITY_LOG(ERROR) << "Executor <unknown>"
                  << " does not include executor_info";
@@ -71,44 +105,58 @@ Try<Nothing> EMAFilter::consume(const ResourceUsage& in) {
     // Check if EMA for given executor exists.
     auto emaSample = this->emaSamples->find(inExec.executor_info());
     if (emaSample == this->emaSamples->end()) {
-      SERENITY_LOG(ERROR) << "First EMA iteration for: "
+      SERENITY_VLOG(1) << "First EMA iteration for: "
                           << WID(inExec.executor_info()).toString();
       // If not - insert new one.
       ExponentialMovingAverage ema(EMA_REGULAR_SERIES, this->alpha);
-      emaSamples->insert(std::pair<ExecutorInfo, ExponentialMovingAverage>(
-          inExec.executor_info(), ema));
-
-    } else {
-      // Get proper value.
-      Try<double_t> value = this->valueGetFunction(inExec);
-      if (value.isError()) {
-        SERENITY_LOG(ERROR) << value.error();
-        continue;
+      Option<double_t> baseline = None();
+      if (this->baselineFunction) {
+        baseline = this->baselineFunction(inExec.executor_info());
+      }
+
+      if (baseline.isSome()) {
+        SERENITY_VLOG(1) << "Starting EMA from workload baseline "
+                         << baseline.get();
+        ema.seed(baseline.get());
       }
 
-      // Perform EMA filtering.
-      double_t emaValue =
-        (emaSample->second).calculateEMA(
-            value.get(),
-            inExec.statistics().perf().timestamp());
-
-      // Store EMA value.
-      ResourceUsage_Executor* outExec = new ResourceUsage_Executor(inExec);
-      Try<Nothing> result = this->valueSetFunction(emaValue, outExec);
-      if (result.isError()) {
-        SERENITY_LOG(ERROR) << result.error();
-        delete outExec;
+      emaSample =
+        emaSamples->insert(std::pair<ExecutorInfo, ExponentialMovingAverage>(
+            inExec.executor_info(), ema)).first;
+
+      if (baseline.isNone()) {
         continue;
       }
+    }
 
-      // Add an executor only when there was no error.
-      product.mutable_executors()->AddAllocated(outExec);
+    // Get proper value.
+    Try<double_t> value = this->valueGetFunction(inExec);
+    if (value.isError()) {
+      SERENITY_LOG(ERROR) << value.error();
+      continue;
+    }
+
+    // Perform EMA filtering.
+    double_t emaValue =
+      (emaSample->second).calculateEMA(
+          value.get(),
+          inExec.statistics().perf().timestamp());
+
+    // Store EMA value.
+    ResourceUsage_Executor* outExec = product.add_executors();
+    outExec->CopyFrom(inExec);
+    Try<Nothing> result = this->valueSetFunction(emaValue, outExec);
+    if (result.isError()) {
+      SERENITY_LOG(ERROR) << result.error();
+      // Keep an executor only when there was no error.
+      product.mutable_executors()->RemoveLast();
+      continue;
     }
   }
 
   if (0 != product.executors_size()) {
-    SERENITY_LOG(INFO) << "Continuing with "
-                       << product.executors_size() << " executor(s).";
+    SERENITY_VLOG(1) << "Continuing with "
+                     << product.executors_size() << " executor(s).";
     // Continue pipeline.
     // Copy total agent's capacity.
     product.mutable_total()->CopyFrom(in.total());
@@ -118,5 +166,28 @@ Try<Nothing> EMAFilter::consume(const ResourceUsage& in) {
   return Nothing();
 }
 
+
+
+void EMAFilter::checkpoint(FilterCheckpoint* checkpoint) const {
+  for (const auto& emaSample : *this->emaSamples) {
+    FilterCheckpoint_Executor* executor = checkpoint->add_executors();
+    executor->mutable_work_id()->CopyFrom(WID(emaSample.first).getWorkID());
+    emaSample.second.checkpoint(executor);
+  }
+}
+
+
+Try<Nothing> EMAFilter::restore(const FilterCheckpoint& checkpoint) {
+  this->emaSamples->clear();
+  for (const FilterCheckpoint_Executor& executor : checkpoint.executors()) {
+    ExponentialMovingAverage ema(EMA_REGULAR_SERIES, this->alpha);
+    ema.restore(executor);
+    this->emaSamples->insert(std::pair<ExecutorInfo, ExponentialMovingAverage>(
+        WID(executor.work_id()).getExecutorInfo(), ema));
+  }
+
+  return Nothing();
+}
+
 }  // namespace serenity
 }  // namespace mesos
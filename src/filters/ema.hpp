@@ -9,14 +9,17 @@
 
 #include "messages/serenity.hpp"
 
+#include "serenity/checkpoint.hpp"
 #include "serenity/data_utils.hpp"
 #include "serenity/default_vars.hpp"
 #include "serenity/executor_map.hpp"
 #include "serenity/executor_set.hpp"
 #include "serenity/serenity.hpp"
+#include "serenity/workload_profile.hpp"
 
 #include "stout/lambda.hpp"
 #include "stout/nothing.hpp"
+#include "stout/option.hpp"
 
 namespace mesos {
 namespace serenity {
@@ -54,6 +57,18 @@ class ExponentialMovingAverage {
    */
   double_t calculateEMA(double_t sample, double_t sampleTimestamp);
 
+  /**
+   * Saves values needed for next calculation (if there are any).
+   */
+  void checkpoint(FilterCheckpoint_Executor* executor) const;
+
+  void restore(const FilterCheckpoint_Executor& executor);
+
+  /**
+   * Starts from known baseline instead of the first sample.
+   */
+  void seed(double_t baseline);
+
  private:
   //! Constant describing how the window weights decrease over time.
   //! It controls how long the moving average period is.
@@ -95,9 +110,13 @@ class ExponentialMovingAverage {
  * separate Resource Usage getter and setter function have to be
  * implemented to fetch specified value and store it. It can be defined
  * in serenity/data_utils.hpp
+ *
+ * First sample of new executor is used only to initialize EMA, unless
+ * baseline of its workload is known (see setBaseline()).
  */
 class EMAFilter :
-    public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
+    public Consumer<ResourceUsage>, public Producer<ResourceUsage>,
+    public Checkpointable {
  public:
   EMAFilter(
       Consumer<ResourceUsage>* _consumer,
@@ -115,12 +134,37 @@ class EMAFilter :
 
   Try<Nothing> consume(const ResourceUsage& in);
 
+  void checkpoint(FilterCheckpoint* checkpoint) const override;
+
+  Try<Nothing> restore(const FilterCheckpoint& checkpoint) override;
+
+  /**
+   * Forgets EMA of executors which are not in given (unfiltered) usage.
+   * Filter is usually fed with filtered usage, so it cannot do it itself.
+   */
+  void prune(const ResourceUsage& usage) {
+    pruneExecutors(usage, this->emaSamples.get());
+  }
+
+  /**
+   * EMA of new executors with known baseline (e.g. from workload profile)
+   * starts from it and first sample is passed.
+   */
+  void setBaseline(const lambda::function<BaselineFunction>& _baseline) {
+    this->baselineFunction = _baseline;
+  }
+
  protected:
   const Tag tag;
   double_t alpha;
+  lambda::function<BaselineFunction> baselineFunction;
   const lambda::function<usage::GetterFunction> valueGetFunction;
   const lambda::function<usage::SetterFunction> valueSetFunction;
   std::unique_ptr<ExecutorMap<ExponentialMovingAverage>> emaSamples;
+
+  //! Reused between iterations - cleared protobuf executors are recycled
+  //! instead of allocated per executor every iteration.
+  ResourceUsage product;
 };
 
 }  // namespace serenity
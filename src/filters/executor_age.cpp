@@ -7,6 +7,7 @@
 #include "mesos/mesos.hpp"
 
 #include "serenity/executor_map.hpp"
+#include "serenity/wid.hpp"
 
 #include "executor_age.hpp"
 
@@ -17,18 +18,23 @@ using std::map;
 using std::pair;
 using std::string;
 
-ExecutorAgeFilter::ExecutorAgeFilter() : started(new ExecutorMap<double_t>()) {}
+ExecutorAgeFilter::ExecutorAgeFilter(std::shared_ptr<PipelineClock> _clock)
+  : clock(_clock), started(new ExecutorMap<double_t>()) {}
 
 
-ExecutorAgeFilter::ExecutorAgeFilter(Consumer<ResourceUsage>* _consumer)
-  : Producer<ResourceUsage>(_consumer), started(new ExecutorMap<double_t>()) {}
+ExecutorAgeFilter::ExecutorAgeFilter(
+    Consumer<ResourceUsage>* _consumer,
+    std::shared_ptr<PipelineClock> _clock)
+  : Producer<ResourceUsage>(_consumer),
+    clock(_clock),
+    started(new ExecutorMap<double_t>()) {}
 
 
 ExecutorAgeFilter::~ExecutorAgeFilter() {}
 
 
 Try<Nothing> ExecutorAgeFilter::consume(const ResourceUsage& in) {
-  double_t now = time(NULL);
+  double_t now = this->clock->now();
 
   for (ResourceUsage_Executor executor : in.executors()) {
     auto startedTime = this->started->find(executor.executor_info());
@@ -39,7 +45,9 @@ Try<Nothing> ExecutorAgeFilter::consume(const ResourceUsage& in) {
       this->age(executor.executor_info());  // For test!
     }
   }
-  // TODO(nnielsen): Clean up finished frameworks and executors.
+
+  // Forget finished executors.
+  pruneExecutors(in, this->started.get());
 
   this->produce(in);
   return Nothing();
@@ -54,8 +62,33 @@ Try<double_t> ExecutorAgeFilter::age(const ExecutorInfo& executorInfo) {
         executorInfo.framework_id().value() + "' of framework '" +
         executorInfo.executor_id().value() + "': framework not present");
   } else {
-    return difftime(time(NULL), startedTime->second);
+    return this->clock->now() - startedTime->second;
+  }
+}
+
+
+
+void ExecutorAgeFilter::checkpoint(FilterCheckpoint* checkpoint) const {
+  for (const auto& startedTime : *this->started) {
+    FilterCheckpoint_Executor* executor = checkpoint->add_executors();
+    executor->mutable_work_id()->CopyFrom(
+        WID(startedTime.first).getWorkID());
+    executor->set_started(startedTime.second);
+  }
+}
+
+
+Try<Nothing> ExecutorAgeFilter::restore(const FilterCheckpoint& checkpoint) {
+  for (const FilterCheckpoint_Executor& executor : checkpoint.executors()) {
+    if (!executor.has_started()) {
+      continue;
+    }
+
+    (*this->started)[WID(executor.work_id()).getExecutorInfo()] =
+      executor.started();
   }
+
+  return Nothing();
 }
 
 }  // namespace serenity
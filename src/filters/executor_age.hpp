@@ -8,6 +8,8 @@
 
 #include "mesos/mesos.hpp"
 
+#include "serenity/checkpoint.hpp"
+#include "serenity/clock.hpp"
 #include "serenity/executor_map.hpp"
 #include "serenity/serenity.hpp"
 
@@ -16,22 +18,31 @@ namespace mesos {
 namespace serenity {
 
 class ExecutorAgeFilter :
-    public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
+    public Consumer<ResourceUsage>, public Producer<ResourceUsage>,
+    public Checkpointable {
  public:
-  ExecutorAgeFilter();
+  explicit ExecutorAgeFilter(
+      std::shared_ptr<PipelineClock> _clock = systemClock());
 
-  explicit ExecutorAgeFilter(Consumer<ResourceUsage>* _consumer);
+  explicit ExecutorAgeFilter(
+      Consumer<ResourceUsage>* _consumer,
+      std::shared_ptr<PipelineClock> _clock = systemClock());
 
   ~ExecutorAgeFilter();
 
   Try<Nothing> consume(const ResourceUsage& in);
 
   /**
-   * Returns the age of an executor in seconds.
+   * Returns the age of an executor in seconds of pipeline clock.
    */
   Try<double_t> age(const ExecutorInfo& exec_id);
 
+  void checkpoint(FilterCheckpoint* checkpoint) const override;
+
+  Try<Nothing> restore(const FilterCheckpoint& checkpoint) override;
+
  private:
+  std::shared_ptr<PipelineClock> clock;
   std::unique_ptr<ExecutorMap<double_t>> started;
 };
 
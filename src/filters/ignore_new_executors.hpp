@@ -9,6 +9,7 @@
 
 #include "messages/serenity.hpp"
 
+#include "serenity/clock.hpp"
 #include "serenity/default_vars.hpp"
 #include "serenity/executor_map.hpp"
 #include "serenity/serenity.hpp"
@@ -26,21 +27,25 @@ namespace serenity {
  * that run for less time than threshold (expressed in seconds).
  *
  * It's purpose is to cut away tasks that are warming up.
+ * Current time is taken from pipeline clock.
  */
 class IgnoreNewExecutorsFilter : public Consumer<ResourceUsage>,
                                  public Producer<ResourceUsage> {
  public:
   explicit IgnoreNewExecutorsFilter(
     Consumer<ResourceUsage>* _consumer = nullptr,
-    uint32_t _thresholdSeconds = new_executor::DEFAULT_THRESHOLD_SEC) :
+    uint32_t _thresholdSeconds = new_executor::DEFAULT_THRESHOLD_SEC,
+    std::shared_ptr<PipelineClock> _clock = systemClock()) :
       Producer<ResourceUsage>(_consumer),
       threshold(_thresholdSeconds),
+      clock(_clock),
       executorTimestamps(new ExecutorMap<time_t>) {}
 
   ~IgnoreNewExecutorsFilter() {}
 
   IgnoreNewExecutorsFilter(const IgnoreNewExecutorsFilter& other) :
-       threshold(other.threshold) {}
+       threshold(other.threshold),
+       clock(other.clock) {}
 
   Try<Nothing> consume(const ResourceUsage& usage) override;
 
@@ -50,13 +55,19 @@ class IgnoreNewExecutorsFilter : public Consumer<ResourceUsage>,
   }
 
  protected:
-  /// ctime function wrapped for mocking purposes.
+  /// Pipeline clock wrapped for mocking purposes.
   inline virtual time_t GetTime(time_t* arg) {
-    return time(arg);
+    time_t now = static_cast<time_t>(this->clock->now());
+    if (arg != nullptr) {
+      *arg = now;
+    }
+    return now;
   }
 
   uint32_t threshold;  //!< #seconds when executor is considered too fresh.
 
+  std::shared_ptr<PipelineClock> clock;
+
   std::unique_ptr<ExecutorMap<time_t>> executorTimestamps;
 
   static constexpr const char* name =
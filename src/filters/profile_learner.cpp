@@ -0,0 +1,79 @@
+#include <algorithm>
+
+#include "filters/profile_learner.hpp"
+
+#include "serenity/data_utils.hpp"
+#include "serenity/resource_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+
+Try<Nothing> ContendedExecutors::consume(const Contentions& in) {
+  this->victims.clear();
+  for (const Contention& contention : in) {
+    if (contention.has_victim()) {
+      this->victims.push_back(WID(contention.victim()));
+    }
+  }
+
+  return Nothing();
+}
+
+
+bool ContendedExecutors::contains(const ExecutorInfo& executorInfo) const {
+  return std::find(this->victims.begin(),
+                   this->victims.end(),
+                   WID(executorInfo)) != this->victims.end();
+}
+
+
+Try<Nothing> WorkloadProfileLearner::consume(const ResourceUsage& in) {
+  for (const ResourceUsage_Executor& executor : in.executors()) {
+    Try<bool> revocable = ResourceUsageHelper::isRevocableExecutor(executor);
+    if (revocable.isError()) {
+      SERENITY_LOG(ERROR) << revocable.error();
+      continue;
+    }
+
+    // Best effort executors are not protected - no need to learn them.
+    if (revocable.get()) {
+      continue;
+    }
+
+    // Contended executor does not show its normal behaviour.
+    if (this->contended.contains(executor.executor_info())) {
+      SERENITY_VLOG(1) << "Not learning contended executor "
+                       << executor.executor_info().executor_id();
+      continue;
+    }
+
+    Try<double_t> ipc = usage::getIpc(executor);
+    Try<double_t> cpuUsage = usage::getCpuUsage(executor);
+    if (ipc.isError() || cpuUsage.isError()) {
+      SERENITY_VLOG(1) << "No IPC or CPU usage for "
+                       << executor.executor_info().executor_id();
+      continue;
+    }
+
+    this->store->learn(
+        executor.executor_info(),
+        ipc.get(),
+        cpuUsage.get(),
+        executor.statistics().timestamp());
+  }
+
+  this->iterations++;
+  if (this->store->isEnabled() &&
+      this->saveInterval != 0 &&
+      this->iterations % this->saveInterval == 0) {
+    Try<Nothing> saved = this->store->save();
+    if (saved.isError()) {
+      SERENITY_LOG(ERROR) << saved.error();
+    }
+  }
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
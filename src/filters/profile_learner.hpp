@@ -0,0 +1,78 @@
+#ifndef SERENITY_PROFILE_LEARNER_FILTER_HPP
+#define SERENITY_PROFILE_LEARNER_FILTER_HPP
+
+#include <list>
+#include <memory>
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+#include "serenity/wid.hpp"
+#include "serenity/workload_profile.hpp"
+
+#include "stout/nothing.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Remembers victims of the last consumed contentions.
+ */
+class ContendedExecutors : public Consumer<Contentions> {
+ public:
+  Try<Nothing> consume(const Contentions& in) override;
+
+  bool contains(const ExecutorInfo& executorInfo) const;
+
+ protected:
+  std::list<WID> victims;
+};
+
+
+/**
+ * WorkloadProfileLearner learns IPC and CPU usage baselines of production
+ * executors' workloads and saves them periodically, so they survive agent
+ * restarts.
+ *
+ * It is a sink - should be fed with usage which represents normal
+ * behaviour, e.g. after TooLowUsageFilter. Contentions of the detector
+ * (e.g. IPC drop detector) should be fed to getContendedExecutors(), so
+ * executors which are victims in current iteration are not learned.
+ * Learner has to run after the detector (e.g. as best effort consumer).
+ */
+class WorkloadProfileLearner : public Consumer<ResourceUsage> {
+ public:
+  explicit WorkloadProfileLearner(
+      std::shared_ptr<WorkloadProfileStore> _store,
+      const SerenityConfig& _conf = SerenityConfig(),
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME))
+    : tag(_tag),
+      store(_store),
+      saveInterval(WorkloadProfileConfig(_conf).getU64(
+          workload_profile::SAVE_INTERVAL)),
+      iterations(0) {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  Consumer<Contentions>* getContendedExecutors() {
+    return &this->contended;
+  }
+
+  static const constexpr char* NAME = "WorkloadProfileLearner";
+
+ protected:
+  const Tag tag;
+  std::shared_ptr<WorkloadProfileStore> store;
+  const uint64_t saveInterval;
+  ContendedExecutors contended;
+
+  uint64_t iterations;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_PROFILE_LEARNER_FILTER_HPP
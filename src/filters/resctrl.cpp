@@ -0,0 +1,110 @@
+#include <string>
+#include <utility>
+
+#include "filters/resctrl.hpp"
+
+#include "glog/logging.h"
+
+#include "serenity/data_utils.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Counts bandwidth from two samples of a cumulative byte counter.
+ */
+static Option<double_t> countBandwidth(
+    const Option<uint64_t>& previous,
+    const Option<uint64_t>& current,
+    double_t duration) {
+  if (previous.isNone() || current.isNone() || duration <= 0) {
+    return None();
+  }
+
+  // Counter could be reset (e.g. monitoring group recreated).
+  if (current.get() < previous.get()) {
+    return None();
+  }
+
+  return (current.get() - previous.get()) / duration;
+}
+
+
+ResctrlFilter::ResctrlFilter(
+    Consumer<ResourceUsage>* _consumer,
+    const SerenityConfig& _conf,
+    const lambda::function<ResctrlGroupFunction>& _groupFunction,
+    const Tag& _tag)
+  : Producer<ResourceUsage>(_consumer),
+    tag(_tag),
+    groupFunction(_groupFunction),
+    monitor(ResctrlFilterConfig(_conf).getS(resctrl::ROOT_PATH)),
+    previousCounters(new ExecutorMap<PreviousCounters>()) {
+  if (!monitor.isAvailable()) {
+    SERENITY_LOG(INFO) << "Resctrl monitoring is not available. "
+                       << "Passing usage without LLC & MBM metrics.";
+  }
+}
+
+
+Try<Nothing> ResctrlFilter::consume(const ResourceUsage& in) {
+  if (!monitor.isAvailable()) {
+    produce(in);
+    return Nothing();
+  }
+
+  std::unique_ptr<ExecutorMap<PreviousCounters>> newCounters(
+    new ExecutorMap<PreviousCounters>());
+  product.CopyFrom(in);
+
+  for (ResourceUsage_Executor& exec : *product.mutable_executors()) {
+    if (!exec.has_executor_info() || !exec.has_statistics()) {
+      continue;
+    }
+
+    Try<ResctrlSample> sample =
+      monitor.read(this->groupFunction(exec.executor_info()));
+    if (sample.isError()) {
+      SERENITY_LOG(WARNING) << sample.error();
+      continue;
+    }
+
+    if (sample.get().llcOccupancy.isSome()) {
+      usage::setLlcOccupancy(sample.get().llcOccupancy.get(), &exec);
+    }
+
+    const double_t timestamp = exec.statistics().timestamp();
+    auto previous = this->previousCounters->find(exec.executor_info());
+    if (previous != this->previousCounters->end()) {
+      const double_t duration = timestamp - previous->second.timestamp;
+
+      Option<double_t> localBandwidth = countBandwidth(
+        previous->second.sample.mbmLocalBytes,
+        sample.get().mbmLocalBytes,
+        duration);
+      if (localBandwidth.isSome()) {
+        usage::setMbmLocalBandwidth(localBandwidth.get(), &exec);
+      }
+
+      Option<double_t> totalBandwidth = countBandwidth(
+        previous->second.sample.mbmTotalBytes,
+        sample.get().mbmTotalBytes,
+        duration);
+      if (totalBandwidth.isSome()) {
+        usage::setMbmTotalBandwidth(totalBandwidth.get(), &exec);
+      }
+    }
+
+    newCounters->insert(std::make_pair(
+      exec.executor_info(), PreviousCounters{timestamp, sample.get()}));
+  }
+
+  this->previousCounters = std::move(newCounters);
+
+  produce(product);
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,104 @@
+#ifndef SERENITY_RESCTRL_FILTER_HPP
+#define SERENITY_RESCTRL_FILTER_HPP
+
+#include <memory>
+#include <string>
+
+#include "mesos/mesos.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/executor_map.hpp"
+#include "serenity/resctrl.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class ResctrlFilterConfig : public SerenityConfig {
+ public:
+  ResctrlFilterConfig() {
+    this->initDefaults();
+  }
+
+  explicit ResctrlFilterConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Mount point of resctrl filesystem.
+    this->fields[resctrl::ROOT_PATH] = std::string(resctrl::DEFAULT_ROOT_PATH);
+  }
+};
+
+
+/**
+ * Maps executor to the name of its resctrl monitoring group.
+ * By default monitoring group is named after executor id.
+ */
+using ResctrlGroupFunction = std::string(const ExecutorInfo& info);
+
+inline std::string executorIdResctrlGroup(const ExecutorInfo& info) {
+  return info.executor_id().value();
+}
+
+
+/**
+ * ResctrlFilter attaches LLC occupancy and MBM local/total bandwidth read
+ * from resctrl monitoring groups to ResourceUsage as derived metrics
+ * (see usage::getLlcOccupancy, usage::getMbmLocalBandwidth and
+ * usage::getMbmTotalBandwidth).
+ *
+ * Bandwidth is counted from the difference of MBM byte counters between
+ * iterations, so first iteration for given executor has only occupancy.
+ * NOTE: Filter needs absolute timestamps - place it before CumulativeFilter.
+ *
+ * When resctrl monitoring is not available filter passes usage unchanged.
+ */
+class ResctrlFilter :
+    public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
+ public:
+  explicit ResctrlFilter(
+      Consumer<ResourceUsage>* _consumer,
+      const SerenityConfig& _conf = SerenityConfig(),
+      const lambda::function<ResctrlGroupFunction>& _groupFunction =
+        executorIdResctrlGroup,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME));
+
+  ~ResctrlFilter() {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  bool isAvailable() const {
+    return monitor.isAvailable();
+  }
+
+  static const constexpr char* NAME = "ResctrlFilter";
+
+ protected:
+  struct PreviousCounters {
+    double_t timestamp;
+    ResctrlSample sample;
+  };
+
+  const Tag tag;
+  const lambda::function<ResctrlGroupFunction> groupFunction;
+  ResctrlMonitor monitor;
+
+  std::unique_ptr<ExecutorMap<PreviousCounters>> previousCounters;
+
+  //! Reused between iterations - cleared protobuf executors are recycled
+  //! instead of allocated per executor every iteration.
+  ResourceUsage product;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_RESCTRL_FILTER_HPP
@@ -0,0 +1,251 @@
+#include <memory>
+#include <string>
+
+#include "filters/task_performance.hpp"
+
+#include "glog/logging.h"
+
+#include "process/help.hpp"
+#include "process/http.hpp"
+#include "process/limiter.hpp"
+#include "process/process.hpp"
+
+#include "serenity/data_utils.hpp"
+#include "serenity/resource_helper.hpp"
+
+#include "stout/json.hpp"
+#include "stout/protobuf.hpp"
+
+namespace mesos {
+namespace serenity {
+
+namespace http = process::http;
+
+using process::defer;
+using process::DESCRIPTION;
+using process::Future;
+using process::HELP;
+using process::Process;
+using process::ProcessBase;
+using process::RateLimiter;
+using process::spawn;
+using process::terminate;
+using process::TLDR;
+using process::USAGE;
+using process::wait;
+
+using std::string;
+
+static const string TASK_PERFORMANCE_ENDPOINT_HELP() {
+  return HELP(
+      TLDR(
+          "Push application performance of production task."),
+      USAGE(
+          TASK_PERFORMANCE_ROUTE),
+      DESCRIPTION(
+          "Production tasks POST their latency / throughput here, so ",
+          "QoS Controller can revoke Best Effort tasks when SLO degrades.",
+          "",
+          "Body is JSON TaskPerformance, e.g.:",
+          "{\"task\": {\"value\": \"task_id\"},",
+          " \"samples\": [{\"name\": \"latency\", \"value\": 12.5}]}"));
+}
+
+
+void TaskPerformanceStore::add(
+    const TaskPerformance& performance, double_t timestamp) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  Entry& entry = this->tasks[performance.task().value()];
+  entry.performance.CopyFrom(performance);
+  entry.timestamp = timestamp;
+}
+
+
+Option<double_t> TaskPerformanceStore::get(
+    const std::string& taskId,
+    const std::string& sampleName,
+    double_t notBefore) const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto entry = this->tasks.find(taskId);
+  if (entry == this->tasks.end() || entry->second.timestamp < notBefore) {
+    return None();
+  }
+
+  for (const TaskPerformance_Sample& sample :
+         entry->second.performance.samples()) {
+    if (sample.name() == sampleName) {
+      return sample.value();
+    }
+  }
+
+  return None();
+}
+
+
+void TaskPerformanceStore::expire(double_t notBefore) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto entry = this->tasks.begin(); entry != this->tasks.end();) {
+    if (entry->second.timestamp < notBefore) {
+      entry = this->tasks.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+}
+
+
+size_t TaskPerformanceStore::size() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->tasks.size();
+}
+
+
+class TaskPerformanceEndpointProcess
+  : public Process<TaskPerformanceEndpointProcess> {
+ public:
+  TaskPerformanceEndpointProcess(
+      const Tag& _tag,
+      const std::shared_ptr<TaskPerformanceStore>& _store,
+      const std::shared_ptr<PipelineClock>& _clock)
+    : ProcessBase(TASK_PERFORMANCE_PROCESS_BASE),
+      tag(_tag),
+      store(_store),
+      clock(_clock),
+      // Every production task pushes its samples - allow much more than
+      // for operator endpoints.
+      limiter(100, Seconds(1)) {}
+
+  virtual ~TaskPerformanceEndpointProcess() {}
+
+ protected:
+  virtual void initialize() {
+    route(TASK_PERFORMANCE_ROUTE,
+          TASK_PERFORMANCE_ENDPOINT_HELP(),
+          &TaskPerformanceEndpointProcess::performance);
+    SERENITY_LOG(INFO)
+      << "endpoint initialized "
+      << "on /" << TASK_PERFORMANCE_PROCESS_BASE << TASK_PERFORMANCE_ROUTE;
+  }
+
+ private:
+  Future<http::Response> performance(const http::Request& request) {
+    return limiter.acquire()
+      .then(defer(self(), &Self::_performance, request));
+  }
+
+  Future<http::Response> _performance(const http::Request& request) {
+    if (request.method != "POST") {
+      return http::BadRequest(tag.NAME() + "Expecting POST request.");
+    }
+
+    Try<JSON::Object> json = JSON::parse<JSON::Object>(request.body);
+    if (json.isError()) {
+      return http::BadRequest(
+          tag.NAME() + "Unable to parse body: " + json.error());
+    }
+
+    Try<TaskPerformance> performance =
+      ::protobuf::parse<TaskPerformance>(json.get());
+    if (performance.isError()) {
+      return http::BadRequest(
+          tag.NAME() + "Invalid TaskPerformance: " + performance.error());
+    }
+
+    this->store->add(performance.get(), this->clock->now());
+
+    return http::OK();
+  }
+
+  const Tag tag;
+  std::shared_ptr<TaskPerformanceStore> store;
+  std::shared_ptr<PipelineClock> clock;
+
+  //! Used to rate limit the endpoint.
+  RateLimiter limiter;
+};
+
+
+TaskPerformanceFilter::TaskPerformanceFilter(
+    Consumer<ResourceUsage>* _consumer,
+    const SerenityConfig& _conf,
+    std::shared_ptr<PipelineClock> _clock,
+    const lambda::function<TaskIdFunction>& _taskIdFunction,
+    const Tag& _tag)
+  : Producer<ResourceUsage>(_consumer),
+    tag(_tag),
+    sampleName(TaskPerformanceFilterConfig(_conf).getS(slo::SAMPLE)),
+    lowerIsBetter(TaskPerformanceFilterConfig(_conf).getB(
+        slo::LOWER_IS_BETTER)),
+    maxSampleAge(TaskPerformanceFilterConfig(_conf).getD(
+        slo::MAX_SAMPLE_AGE)),
+    clock(_clock),
+    taskIdFunction(_taskIdFunction),
+    store(new TaskPerformanceStore()) {
+  if (TaskPerformanceFilterConfig(_conf).getB(slo::ENDPOINT)) {
+    this->process.reset(
+        new TaskPerformanceEndpointProcess(_tag, store, _clock));
+    spawn(this->process.get());
+  }
+}
+
+
+TaskPerformanceFilter::~TaskPerformanceFilter() {
+  if (this->process.get() != nullptr) {
+    terminate(this->process.get());
+    wait(this->process.get());
+  }
+}
+
+
+Try<Nothing> TaskPerformanceFilter::consume(const ResourceUsage& in) {
+  const double_t notBefore = this->clock->now() - this->maxSampleAge;
+  this->store->expire(notBefore);
+
+  ResourceUsage product;
+  product.mutable_total()->CopyFrom(in.total());
+
+  for (const ResourceUsage_Executor& executor : in.executors()) {
+    Try<bool> revocable = ResourceUsageHelper::isRevocableExecutor(executor);
+    if (revocable.isError()) {
+      SERENITY_LOG(ERROR) << revocable.error();
+      continue;
+    }
+
+    if (revocable.get()) {
+      product.add_executors()->CopyFrom(executor);
+      continue;
+    }
+
+    Option<double_t> value = this->store->get(
+        this->taskIdFunction(executor.executor_info()),
+        this->sampleName,
+        notBefore);
+    if (value.isNone()) {
+      continue;
+    }
+
+    double_t signal = value.get();
+    if (this->lowerIsBetter) {
+      if (signal <= 0) {
+        SERENITY_VLOG(1) << "Ignoring non positive " << this->sampleName
+                         << " of " << executor.executor_info().executor_id();
+        continue;
+      }
+      signal = 1.0 / signal;
+    }
+
+    ResourceUsage_Executor* productExecutor = product.add_executors();
+    productExecutor->CopyFrom(executor);
+    usage::setSloSignal(signal, productExecutor);
+  }
+
+  SERENITY_VLOG(1) << "Passing " << product.executors_size()
+                   << " executors with SLO signal or revocable";
+
+  produce(product);
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,165 @@
+#ifndef SERENITY_TASK_PERFORMANCE_FILTER_HPP
+#define SERENITY_TASK_PERFORMANCE_FILTER_HPP
+
+#include <memory>
+#include <mutex>  // NOLINT [build/c++11]
+#include <string>
+#include <unordered_map>
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "process/owned.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/option.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+const std::string TASK_PERFORMANCE_ROUTE = "/performance";
+const std::string TASK_PERFORMANCE_PROCESS_BASE = "serenity_task_performance";
+
+
+class TaskPerformanceFilterConfig : public SerenityConfig {
+ public:
+  TaskPerformanceFilterConfig() {
+    this->initDefaults();
+  }
+
+  explicit TaskPerformanceFilterConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Name of TaskPerformance sample used as SLO signal.
+    this->fields[slo::SAMPLE] = std::string(slo::DEFAULT_SAMPLE);
+
+    //! bool
+    //! True for samples where lower is better (latency). Such samples are
+    //! inverted, so SLO degradation is always a drop of the signal.
+    this->fields[slo::LOWER_IS_BETTER] = slo::DEFAULT_LOWER_IS_BETTER;
+
+    //! double_t
+    //! Samples older than that (in seconds) are ignored.
+    this->fields[slo::MAX_SAMPLE_AGE] = slo::DEFAULT_MAX_SAMPLE_AGE;
+
+    //! bool
+    //! Serve /serenity_task_performance/performance endpoint.
+    this->fields[slo::ENDPOINT] = slo::DEFAULT_ENDPOINT;
+  }
+};
+
+
+/**
+ * Latest TaskPerformance of each task. Written by ingestion endpoint
+ * (libprocess thread) and read by TaskPerformanceFilter (pipeline thread).
+ */
+class TaskPerformanceStore {
+ public:
+  void add(const TaskPerformance& performance, double_t timestamp);
+
+  /**
+   * Returns value of given sample of the task, if it was received not
+   * earlier than given time.
+   */
+  Option<double_t> get(const std::string& taskId,
+                       const std::string& sampleName,
+                       double_t notBefore) const;
+
+  /**
+   * Removes performance of tasks not updated since given time.
+   */
+  void expire(double_t notBefore);
+
+  size_t size() const;
+
+ protected:
+  struct Entry {
+    TaskPerformance performance;
+    double_t timestamp;
+  };
+
+  mutable std::mutex mutex;
+  std::unordered_map<std::string, Entry> tasks;
+};
+
+
+/**
+ * Maps executor to the task which reports its performance.
+ * By default it is executor id (true for command executor).
+ */
+using TaskIdFunction = std::string(const ExecutorInfo& info);
+
+inline std::string executorIdTask(const ExecutorInfo& info) {
+  return info.executor_id().value();
+}
+
+
+// Forward declaration
+class TaskPerformanceEndpointProcess;
+
+
+/**
+ * TaskPerformanceFilter attaches application SLO signal, pushed by
+ * production tasks as TaskPerformance, to ResourceUsage as derived metric
+ * (see usage::getSloSignal), so it can be analyzed by SignalBasedDetector
+ * like any other signal.
+ *
+ * Production executors without fresh sample are filtered out, so detector
+ * does not see them at all. Revocable executors are passed unchanged.
+ *
+ * When SLO_ENDPOINT is enabled, tasks push samples as JSON TaskPerformance
+ * with POST to /serenity_task_performance/performance, e.g.
+ * {"task": {"value": "id"}, "samples": [{"name": "latency", "value": 12}]}
+ */
+class TaskPerformanceFilter :
+    public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
+ public:
+  explicit TaskPerformanceFilter(
+      Consumer<ResourceUsage>* _consumer,
+      const SerenityConfig& _conf = SerenityConfig(),
+      std::shared_ptr<PipelineClock> _clock = systemClock(),
+      const lambda::function<TaskIdFunction>& _taskIdFunction =
+        executorIdTask,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME));
+
+  ~TaskPerformanceFilter();
+
+  Try<Nothing> consume(const ResourceUsage& in) override;
+
+  /**
+   * Samples are received here - by endpoint or directly.
+   */
+  std::shared_ptr<TaskPerformanceStore> getStore() const {
+    return store;
+  }
+
+  static const constexpr char* NAME = "TaskPerformanceFilter";
+
+ protected:
+  const Tag tag;
+  const std::string sampleName;
+  const bool lowerIsBetter;
+  const double_t maxSampleAge;
+  std::shared_ptr<PipelineClock> clock;
+  const lambda::function<TaskIdFunction> taskIdFunction;
+
+  std::shared_ptr<TaskPerformanceStore> store;
+  process::Owned<TaskPerformanceEndpointProcess> process;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_TASK_PERFORMANCE_FILTER_HPP
@@ -14,6 +14,42 @@ namespace serenity {
 
 using std::string;
 
+void UtilizationThresholdFilter::updateState(double_t utilization) {
+  if (this->smoothedUtilization.isNone()) {
+    this->smoothedUtilization = utilization;
+  } else {
+    this->smoothedUtilization = (this->alpha * utilization) +
+      ((1 - this->alpha) * this->smoothedUtilization.get());
+  }
+
+  this->iterationsInState++;
+  if (this->iterationsInState < this->minDwellIterations) {
+    return;
+  }
+
+  const double_t smoothed = this->smoothedUtilization.get();
+  if (this->oversubscriptionEnabled &&
+      smoothed >= this->utilizationThreshold) {
+    this->oversubscriptionEnabled = false;
+    this->disabledTransitions++;
+    this->iterationsInState = 0;
+    SERENITY_LOG(INFO) << "Disabling oversubscription (utilization "
+                       << smoothed << "). Transitions: "
+                       << this->disabledTransitions << " disabled, "
+                       << this->enabledTransitions << " enabled.";
+  } else if (!this->oversubscriptionEnabled &&
+             smoothed < this->lowUtilizationThreshold) {
+    this->oversubscriptionEnabled = true;
+    this->enabledTransitions++;
+    this->iterationsInState = 0;
+    SERENITY_LOG(INFO) << "Enabling oversubscription (utilization "
+                       << smoothed << "). Transitions: "
+                       << this->disabledTransitions << " disabled, "
+                       << this->enabledTransitions << " enabled.";
+  }
+}
+
+
 Try<Nothing> UtilizationThresholdFilter::consume(const ResourceUsage& product) {
   std::unique_ptr<ExecutorSet> newSamples(new ExecutorSet());
   double_t totalCpuUsage = 0;
@@ -94,8 +130,10 @@ Try<Nothing> UtilizationThresholdFilter::consume(const ResourceUsage& product) {
   Resources totalSlaveResources(product.total());
   Option<double_t> totalSlaveCpus = totalSlaveResources.cpus();
   if (totalSlaveCpus.isSome() && this->previousSamples->size() > 0) {
+    this->updateState(totalCpuUsage / totalSlaveCpus.get());
+
     // Send only when node utilization is not too high.
-    if ((totalCpuUsage / totalSlaveCpus.get()) < this->utilizationThreshold) {
+    if (this->oversubscriptionEnabled) {
       // Continue pipeline.
       SERENITY_LOG(INFO) << "Continuing with "
                          << product.executors_size() << " executor(s).";
@@ -103,7 +141,8 @@ Try<Nothing> UtilizationThresholdFilter::consume(const ResourceUsage& product) {
     } else {
       SERENITY_LOG(ERROR) << "Stopping the oversubscription - load "
           "is too high." << "CpuUsage: " << totalCpuUsage <<
-          ", Slave capacity:" << totalSlaveCpus.get();
+          ", Slave capacity:" << totalSlaveCpus.get() <<
+          ", Smoothed utilization: " << this->smoothedUtilization.get();
     }
   } else {
     SERENITY_LOG(WARNING) << "Does not have sufficient data to process;";
@@ -4,19 +4,56 @@
 #include <string>
 #include <memory>
 
+#include "serenity/config.hpp"
 #include "serenity/default_vars.hpp"
 #include "serenity/executor_set.hpp"
 #include "serenity/serenity.hpp"
 
 #include "stout/lambda.hpp"
 #include "stout/nothing.hpp"
+#include "stout/option.hpp"
 
 namespace mesos {
 namespace serenity {
 
+class UtilizationThresholdFilterConfig : public SerenityConfig {
+ public:
+  UtilizationThresholdFilterConfig() {
+    this->initDefaults();
+  }
+
+  explicit UtilizationThresholdFilterConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! double_t
+    //! Oversubscription is enabled again when utilization drops below
+    //! (utilizationThreshold - hysteresis).
+    this->fields[utilization::HYSTERESIS] = utilization::DEFAULT_HYSTERESIS;
+
+    //! uint64_t
+    //! Minimum number of iterations between enabling and disabling
+    //! oversubscription.
+    this->fields[utilization::MIN_DWELL_ITERATIONS] =
+      utilization::DEFAULT_MIN_DWELL_ITERATIONS;
+
+    //! double_t
+    //! EMA alpha of smoothed utilization. 1.0 means no smoothing.
+    this->fields[utilization::ALPHA] = utilization::DEFAULT_ALPHA;
+  }
+};
+
+
 /**
  * UtilizationThresholdFilter disables oversubscription when node
  * utilization is too high.
+ * Utilization is smoothed with EMA. Oversubscription is disabled when it
+ * reaches utilizationThreshold (high watermark) and enabled again only
+ * when it drops below (utilizationThreshold - hysteresis) (low watermark).
+ * Both transitions require at least minDwellIterations in current state,
+ * so hosts near the threshold do not flap oversubscription on and off.
  * NOTE: This filter should be the first filter in pipeline. It should have
  * the overview of all tasks running on the node.
  * NOTE: In case of lack of the usage for given executor,
@@ -28,28 +65,79 @@ class UtilizationThresholdFilter :
  public:
   UtilizationThresholdFilter(
         double_t _utilizationThreshold = utilization::DEFAULT_THRESHOLD,
-        const Tag& _tag = Tag(UNDEFINED, "utilizationFilter"))
+        const Tag& _tag = Tag(UNDEFINED, "utilizationFilter"),
+        const SerenityConfig& _conf = SerenityConfig())
       : tag(_tag),
         utilizationThreshold(_utilizationThreshold),
-        previousSamples(new ExecutorSet) {}
+        previousSamples(new ExecutorSet) {
+    this->init(_conf);
+  }
 
   UtilizationThresholdFilter(
       Consumer<ResourceUsage>* _consumer,
       double_t _utilizationThreshold = utilization::DEFAULT_THRESHOLD,
-      const Tag& _tag = Tag(UNDEFINED, "utilizationFilter"))
+      const Tag& _tag = Tag(UNDEFINED, "utilizationFilter"),
+      const SerenityConfig& _conf = SerenityConfig())
       : tag(_tag), Producer<ResourceUsage>(_consumer),
         utilizationThreshold(_utilizationThreshold),
-        previousSamples(new ExecutorSet) {}
+        previousSamples(new ExecutorSet) {
+    this->init(_conf);
+  }
 
   ~UtilizationThresholdFilter() {}
 
   Try<Nothing> consume(const ResourceUsage& in);
 
+  bool isOversubscriptionEnabled() const {
+    return oversubscriptionEnabled;
+  }
+
+  //! Number of transitions from disabled to enabled oversubscription.
+  uint64_t getEnabledTransitions() const {
+    return enabledTransitions;
+  }
+
+  //! Number of transitions from enabled to disabled oversubscription.
+  uint64_t getDisabledTransitions() const {
+    return disabledTransitions;
+  }
+
+  static const constexpr char* NAME = "UtilizationThresholdFilter";
+
  protected:
+  void init(const SerenityConfig& _conf) {
+    SerenityConfig config = UtilizationThresholdFilterConfig(_conf);
+    this->lowUtilizationThreshold =
+      this->utilizationThreshold - config.getD(utilization::HYSTERESIS);
+    this->minDwellIterations = config.getU64(utilization::MIN_DWELL_ITERATIONS);
+    this->alpha = config.getD(utilization::ALPHA);
+
+    this->oversubscriptionEnabled = true;
+    // First transition does not need to wait.
+    this->iterationsInState = this->minDwellIterations;
+    this->enabledTransitions = 0;
+    this->disabledTransitions = 0;
+  }
+
+  /**
+   * Updates oversubscription state with new utilization sample.
+   */
+  void updateState(double_t utilization);
+
   const Tag tag;
   double_t utilizationThreshold;
+  double_t lowUtilizationThreshold;
   std::unique_ptr<ExecutorSet> previousSamples;
 
+  uint64_t minDwellIterations;
+  double_t alpha;
+  Option<double_t> smoothedUtilization;
+
+  bool oversubscriptionEnabled;
+  uint64_t iterationsInState;
+  uint64_t enabledTransitions;
+  uint64_t disabledTransitions;
+
   const std::string UTILIZATION_THRESHOLD_FILTER_ERROR = "Filter is not able" \
     " to calculate total cpu usage and cut off oversubscription if needed.";
 
@@ -1,4 +1,4 @@
-#include <atomic>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -17,7 +17,7 @@
 #include "process/process.hpp"
 
 #include "stout/lambda.hpp"
-#include "stout/synchronized.hpp"
+#include "stout/numify.hpp"
 
 #include "valve.hpp"
 
@@ -27,7 +27,6 @@ namespace serenity {
 // TODO(bplotka): Break into explicit using-declarations.
 using namespace process;  // NOLINT(build/namespaces)
 
-using std::atomic_int;
 using std::string;
 
 static const string ESTIMATOR_VALVE_ENDPOINT_HELP() {
@@ -41,7 +40,10 @@ static const string ESTIMATOR_VALVE_ENDPOINT_HELP() {
           "When turned off it stops estimating new slack resources. ",
           "",
           "The following field should be supplied in a POST:",
-          "1. " + PIPELINE_ENABLE_KEY + " - true / false."));
+          "1. " + PIPELINE_ENABLE_KEY + " - true / false.",
+          "or, for partial estimations:",
+          "2. " + PIPELINE_SCALE_KEY + " - fraction of estimated slack to "
+          "offer (0 - 1)."));
 }
 
 
@@ -60,7 +62,10 @@ static const string CONTROLLER_VALVE_ENDPOINT_HELP() {
           "tasks. ",
           "",
           "The following field should be supplied in a POST:",
-          "1. " + PIPELINE_ENABLE_KEY + " - true / false."));
+          "1. " + PIPELINE_ENABLE_KEY + " - true / false.",
+          "or, for partial assurance:",
+          "2. " + PIPELINE_SCALE_KEY + " - fraction of iterations to run "
+          "(0 - 1)."));
 }
 
 
@@ -87,15 +92,37 @@ Try<string> getFormValue(
   return decodedValue.get();
 }
 
-#define IS_OPENED_THRESHOLD 1
+
+/**
+ * Returns value of given param from query or (POST) form.
+ */
+static Option<string> getParam(
+    const string& key,
+    const http::Request& request,
+    const hashmap<string, string>& formValues) {
+  Option<string> param = request.url.query.get(key);
+  if (param.isSome()) {
+    return param;
+  }
+
+  Try<string> formParam = getFormValue(key, formValues);
+  if (formParam.isError()) {
+    return None();
+  }
+
+  return formParam.get();
+}
+
 
 class ValveFilterEndpointProcess
   : public ProtobufProcess<ValveFilterEndpointProcess> {
  public:
-  explicit ValveFilterEndpointProcess(const Tag& _tag, bool _opened)
+  ValveFilterEndpointProcess(
+      const Tag& _tag,
+      const std::shared_ptr<ValveState>& _state)
     : tag(_tag),
       ProcessBase(getValveProcessBaseName(_tag.TYPE())),
-      openedCounter(_opened ?  IS_OPENED_THRESHOLD : IS_OPENED_THRESHOLD - 1),
+      state(_state),
       // 2 permits per second.
       limiter(2, Seconds(1)) {
     switch (this->tag.TYPE()) {
@@ -119,23 +146,22 @@ class ValveFilterEndpointProcess
     std::string action = open ? "Enabling" : "Disabling";
     SERENITY_LOG(INFO) << action << "  pipeline";
 
-    if (open) {
-      ++openedCounter;
-    } else {
-      --openedCounter;
-    }
+    state->setOpen(open);
   }
 
-  void setOpenHandle(const OversubscriptionCtrlEvent& msg) {
-    this->setOpen(msg.enable());
-  }
+  void setScale(double_t scale) {
+    SERENITY_LOG(INFO) << "Setting pipeline scale to " << scale;
 
-  Future<bool> isOpened() {
-    return (openedCounter >= IS_OPENED_THRESHOLD);
+    state->setScale(scale);
   }
 
-  const lambda::function<Future<bool>()> getIsOpenedFunction() {
-    return defer(self(), &Self::isOpened);
+  void setOpenHandle(const OversubscriptionCtrlEvent& msg) {
+    // Graduated throttling is applied by SlackResourceObserver.
+    if (msg.has_slack_scale()) {
+      return;
+    }
+
+    this->setOpen(msg.enable());
   }
 
  protected:
@@ -168,31 +194,35 @@ class ValveFilterEndpointProcess
     }
     hashmap<string, string> values = decode.get();
 
-    string enabled_param;
-    Option<string> pipeline_enable = request.url.query.get(PIPELINE_ENABLE_KEY);
-
-    if (pipeline_enable.isSome()) {
-      enabled_param = pipeline_enable.get();
-    } else {
-      // Get params via POST method.
-      Try<string> pipeline_enable_form =
-          getFormValue(PIPELINE_ENABLE_KEY, values);
-
-      if (pipeline_enable_form.isError()) {
-        // There is no 'enabled' param.
-        const string message =
-          tag.NAME() + "Missed 'enabled' param.";
-        return http::BadRequest(message);
+    Option<string> scale_param = getParam(PIPELINE_SCALE_KEY, request, values);
+    if (scale_param.isSome()) {
+      Try<double_t> scale = numify<double_t>(scale_param.get());
+      if (scale.isError() || scale.get() < 0.0 || scale.get() > 1.0) {
+        return http::BadRequest(tag.NAME() + "Wrong value of 'scale' param. "
+                                + "Possible values: 0 - 1");
       }
-      enabled_param = pipeline_enable_form.get();
+
+      this->setScale(scale.get());
+
+      return http::OK(tag.NAME() + "Scale set to " + scale_param.get() + ".");
     }
+
+    Option<string> enabled_param =
+      getParam(PIPELINE_ENABLE_KEY, request, values);
+    if (enabled_param.isNone()) {
+      // There is no 'enabled' param.
+      const string message =
+        tag.NAME() + "Missed 'enabled' param.";
+      return http::BadRequest(message);
+    }
+
     bool pipeline_enable_decision;
     string message = "";
 
-    if (!enabled_param.compare("true")) {
+    if (!enabled_param.get().compare("true")) {
       pipeline_enable_decision = true;
       message = tag.NAME() + "Enabled.";
-    } else if (!enabled_param.compare("false")) {
+    } else if (!enabled_param.get().compare("false")) {
       pipeline_enable_decision = false;
       message = tag.NAME() + "Disabled.";
     } else {
@@ -207,46 +237,68 @@ class ValveFilterEndpointProcess
     return http::OK(message);
   }
 
-  // Since there could be a lot of potential operators we need counter.
-  // If counter is >= IS_OPENED_THRESHOLD than valve will be opened.
-  atomic_int openedCounter;
+  //! Shared with ValveFilter which reads it without actor round-trip.
+  std::shared_ptr<ValveState> state;
 
   //! Used to rate limit the endpoint.
   RateLimiter limiter;
 };
 
 
-ValveFilter::ValveFilter(bool _opened, const Tag& _tag)
-  : process(new ValveFilterEndpointProcess(_tag, _opened)), tag(_tag) {
-  isOpened = process.get()->getIsOpenedFunction();
-  spawn(process.get());
+ValveFilter::ValveFilter(bool _opened, const Tag& _tag, bool _endpoint)
+  : tag(_tag),
+    state(new ValveState(_opened)),
+    scaleCredit(0.0) {
+  if (_endpoint) {
+    process.reset(new ValveFilterEndpointProcess(_tag, state));
+    spawn(process.get());
+  }
 }
 
 
 ValveFilter::ValveFilter(
     Consumer<ResourceUsage>* _consumer,
     bool _opened,
-    const Tag& _tag)
+    const Tag& _tag,
+    bool _endpoint)
   : Producer<ResourceUsage>(_consumer),
-    process(new ValveFilterEndpointProcess(_tag, _opened)),
-    tag(_tag) {
-  isOpened = process.get()->getIsOpenedFunction();
-  spawn(process.get());
+    tag(_tag),
+    state(new ValveState(_opened)),
+    scaleCredit(0.0) {
+  if (_endpoint) {
+    process.reset(new ValveFilterEndpointProcess(_tag, state));
+    spawn(process.get());
+  }
 }
 
 
 ValveFilter::~ValveFilter() {
-  terminate(process.get());
-  wait(process.get());
+  if (process.get() != nullptr) {
+    terminate(process.get());
+    wait(process.get());
+  }
 }
 
 
 Try<Nothing> ValveFilter::consume(const ResourceUsage& in) {
-  if (this->isOpened().get()) {
+  if (!this->state->isOpened()) {
+    // Currently we are not continuing pipeline in case of closed valve.
+    SERENITY_LOG_EVERY_N_SEC(INFO, 60) << "Pipeline is closed";
+    return Nothing();
+  }
+
+  // Estimator pipeline scales the slack itself.
+  if (this->tag.TYPE() == RESOURCE_ESTIMATOR) {
+    this->produce(in);
+    return Nothing();
+  }
+
+  this->scaleCredit += this->state->getScale();
+  if (this->scaleCredit >= 1.0) {
+    this->scaleCredit -= 1.0;
     this->produce(in);
   } else {
-    // Currently we are not continuing pipeline in case of closed valve.
-    SERENITY_LOG(INFO) << "Pipeline is closed";
+    SERENITY_VLOG(1) << "Pipeline is partially opened - skipping iteration";
   }
 
   return Nothing();
@@ -1,11 +1,13 @@
 #ifndef SERENITY_VALVE_FILTER_HPP
 #define SERENITY_VALVE_FILTER_HPP
 
+#include <atomic>
+#include <cmath>
+#include <memory>
 #include <string>
 
 #include "mesos/mesos.hpp"
 
-#include "process/future.hpp"
 #include "process/owned.hpp"
 
 #include "serenity/serenity.hpp"
@@ -16,6 +18,7 @@ namespace mesos {
 namespace serenity {
 
 const std::string PIPELINE_ENABLE_KEY = "enabled";
+const std::string PIPELINE_SCALE_KEY = "scale";
 const std::string VALVE_ROUTE = "/valve";
 const std::string RESOURCE_ESTIMATOR_VALVE_PROCESS_BASE =
     "serenity_resource_estimator";
@@ -35,28 +38,107 @@ static const std::string getValveProcessBaseName(const ModuleType type) {
 }
 
 
+constexpr int VALVE_OPENED_THRESHOLD = 1;
+
+/**
+ * Valve state shared between ValveFilter (reader, pipeline thread) and
+ * ValveFilterEndpointProcess (writer, libprocess thread). It is lock free,
+ * so reading it does not block pipeline iteration.
+ *
+ * Since there could be a lot of potential operators we need counter.
+ * If counter is >= VALVE_OPENED_THRESHOLD than valve is opened.
+ * Scale is a fraction of QoS Controller iterations passed by opened valve
+ * or a fraction of estimated slack offered by Resource Estimator.
+ */
+class ValveState {
+ public:
+  explicit ValveState(bool _opened)
+    : openedCounter(_opened ? VALVE_OPENED_THRESHOLD
+                            : VALVE_OPENED_THRESHOLD - 1),
+      scale(1.0) {}
+
+  void setOpen(bool open) {
+    if (open) {
+      ++openedCounter;
+    } else {
+      --openedCounter;
+    }
+  }
+
+  /**
+   * Sets fraction of iterations to pass. Value is clamped to [0, 1].
+   */
+  void setScale(double_t _scale) {
+    if (_scale < 0.0) {
+      _scale = 0.0;
+    } else if (_scale > 1.0) {
+      _scale = 1.0;
+    }
+    scale.store(_scale);
+  }
+
+  bool isOpened() const {
+    return openedCounter.load() >= VALVE_OPENED_THRESHOLD;
+  }
+
+  double_t getScale() const {
+    return scale.load();
+  }
+
+ private:
+  std::atomic_int openedCounter;
+  std::atomic<double_t> scale;
+};
+
+
 // Forward declaration
 class ValveFilterEndpointProcess;
 
+
+/**
+ * ValveFilter passes ResourceUsage when it is opened.
+ * With scale lower than 1 QoS Controller valve passes only that fraction
+ * of iterations (e.g. every second iteration for 0.5). Resource Estimator
+ * valve passes every iteration - skipped iteration would offer no slack at
+ * all - and the estimator pipeline multiplies slack by the scale.
+ *
+ * State can be changed via http endpoint and (for Resource Estimator)
+ * via OversubscriptionCtrlEvent. Valve without endpoint (e.g. in shadow
+ * pipeline) keeps its initial state.
+ */
 class ValveFilter :
     public Consumer<ResourceUsage>, public Producer<ResourceUsage> {
  public:
   explicit ValveFilter(bool _opened = true,
-                       const Tag& _tag = Tag(UNDEFINED, "valveFilter"));
+                       const Tag& _tag = Tag(UNDEFINED, "valveFilter"),
+                       bool _endpoint = true);
 
   ValveFilter(
       Consumer<ResourceUsage>* _consumer,
       bool _opened = true,
-      const Tag& _tag = Tag(UNDEFINED, "valveFilter"));
+      const Tag& _tag = Tag(UNDEFINED, "valveFilter"),
+      bool _endpoint = true);
 
   ~ValveFilter();
 
   Try<Nothing> consume(const ResourceUsage& in);
 
+  bool isOpened() const {
+    return state->isOpened();
+  }
+
+  double_t getScale() const {
+    return state->getScale();
+  }
+
  private:
   const Tag tag;
-  lambda::function<process::Future<bool>()> isOpened;
+  std::shared_ptr<ValveState> state;
   process::Owned<ValveFilterEndpointProcess> process;
+
+  //!< Accumulated scale. Iteration is passed when it reaches 1
+  //!< (QoS Controller only).
+  double_t scaleCredit;
 };
 
 }  // namespace serenity
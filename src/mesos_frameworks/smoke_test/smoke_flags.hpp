@@ -36,6 +36,14 @@ public:
         "Framework name.",
         "Serenity Smoke Test Framework");
 
+    add(&pack_offers,
+        "pack_offers",
+        "Whether to fill each offer with all jobs which fit into it\n"
+          "(best fit by size and shares) and launch tasks for all offers\n"
+          "from the same agent in one call. Otherwise scheduling of an offer\n"
+          "stops on the first job which does not fit (false by default).",
+        false);
+
     add(&principal,
         "principal",
         "To enable authentication, both --principal and --secret\n"
@@ -102,6 +110,7 @@ public:
 
   Option<std::string> master;
   bool checkpoint;
+  bool pack_offers;
   Option<std::string> principal;
   Option<std::string> secret;
   std::string command;
@@ -1,13 +1,17 @@
 #ifndef SERENITY_SMOKE_QUEUE_HPP
 #define SERENITY_SMOKE_QUEUE_HPP
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <random>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <mesos/resources.hpp>
 
+#include <stout/bytes.hpp>
 #include <stout/json.hpp>
 #include <stout/option.hpp>
 
@@ -179,4 +183,234 @@ class SmokeAliasQueue {
 };
 
 
+/**
+ * Dynamic weighted sampler based on Fenwick (binary indexed) tree over
+ * job shares. Job is selected with probability shares / totalShares.
+ *
+ * Insert, remove and select are O(log n) (insert is amortized, since tree
+ * is rebuilt in O(n) when capacity is doubled).
+ * Shares are integers, so sums are exact and removals do not accumulate
+ * floating point errors.
+ */
+class SmokeWeightedQueue {
+ public:
+  SmokeWeightedQueue() : finished(true), totalShares(0), jobsCount(0) {}
+
+  void add(std::shared_ptr<SmokeJob> job) {
+    if (slotById.find(job->id) != slotById.end()) {
+      LOG(ERROR) << "Job(" << job->id << ") is already in queue.";
+      return;
+    }
+
+    if (slots.size() == capacity()) {
+      this->grow();
+    }
+
+    finished = false;
+    size_t slot = slots.size();
+    slots.push_back(job);
+    slotById[job->id] = slot;
+    this->update(slot, job->shares);
+    totalShares += job->shares;
+    jobsCount++;
+  }
+
+  // Selecting is O(log n).
+  std::shared_ptr<SmokeJob> selectJob() {
+    if (jobsCount == 0 || totalShares == 0) {
+      LOG(ERROR) << "Cannot select job when there is no job in queue";
+      return nullptr;
+    }
+
+    std::uniform_int_distribution<uint64_t> sharesRand(0, totalShares - 1);
+    return slots[this->find(sharesRand(generator))];
+  }
+
+  // Removing is O(log n).
+  void remove(std::shared_ptr<SmokeJob> job) {
+    auto slot = slotById.find(job->id);
+    if (slot == slotById.end()) {
+      LOG(ERROR) << "Requested job not found.";
+      return;
+    }
+
+    if (suspended.erase(job->id) == 0) {
+      this->update(slot->second, -static_cast<int64_t>(job->shares));
+      totalShares -= job->shares;
+    }
+    slots[slot->second] = nullptr;
+    slotById.erase(slot);
+    jobsCount--;
+
+    if (jobsCount == 0) {
+      finished = true;
+    }
+  }
+
+  /**
+   * Bin packing selection. Among selectable jobs which fit into remaining
+   * resources returns the one with the highest shares multiplied by
+   * dominant fraction of remaining resources taken by its task, so large
+   * jobs are packed first and shares still decide between similar ones.
+   * Returns nullptr when no job fits. O(n).
+   */
+  std::shared_ptr<SmokeJob> selectBestFit(
+      const mesos::Resources& remaining) const {
+    std::shared_ptr<SmokeJob> bestJob = nullptr;
+    double_t bestScore = -1;
+    for (const std::shared_ptr<SmokeJob>& job : slots) {
+      if (job == nullptr || suspended.count(job->id) > 0 ||
+          !remaining.contains(job->taskResources)) {
+        continue;
+      }
+
+      double_t score =
+        job->shares * dominantFraction(job->taskResources, remaining);
+      if (score > bestScore) {
+        bestScore = score;
+        bestJob = job;
+      }
+    }
+
+    return bestJob;
+  }
+
+  /**
+   * Temporarily excludes job from selection (e.g. when it does not fit
+   * into current offer). O(log n).
+   */
+  void suspend(std::shared_ptr<SmokeJob> job) {
+    auto slot = slotById.find(job->id);
+    if (slot == slotById.end() || !suspended.insert(job->id).second) {
+      return;
+    }
+
+    this->update(slot->second, -static_cast<int64_t>(job->shares));
+    totalShares -= job->shares;
+  }
+
+  /**
+   * Brings back all suspended jobs. O(k log n) for k suspended jobs.
+   */
+  void resumeAll() {
+    for (size_t id : suspended) {
+      auto slot = slotById.find(id);
+      if (slot == slotById.end()) continue;
+
+      size_t shares = slots[slot->second]->shares;
+      this->update(slot->second, shares);
+      totalShares += shares;
+    }
+    suspended.clear();
+  }
+
+  // True when there is a job which can be selected.
+  bool hasSelectable() const {
+    return totalShares > 0;
+  }
+
+  // Kept for compatibility with SmokeAliasQueue interface.
+  void removeAndReset(std::shared_ptr<SmokeJob> job) {
+    this->remove(job);
+  }
+
+  size_t size() const {
+    return jobsCount;
+  }
+
+  bool finished;
+
+ protected:
+  uint64_t totalShares;
+  size_t jobsCount;
+
+  //! Fenwick tree (1-indexed, tree[0] unused) of shares per slot.
+  std::vector<uint64_t> tree;
+  std::vector<std::shared_ptr<SmokeJob>> slots;
+  std::unordered_map<size_t, size_t> slotById;
+  std::unordered_set<size_t> suspended;
+  std::default_random_engine generator;
+
+  /**
+   * Returns the largest fraction of remaining cpus or memory taken by
+   * task resources.
+   */
+  static double_t dominantFraction(
+      const mesos::Resources& task,
+      const mesos::Resources& remaining) {
+    double_t fraction = 0;
+
+    Option<double> cpus = task.cpus();
+    Option<double> remainingCpus = remaining.cpus();
+    if (cpus.isSome() && remainingCpus.isSome() && remainingCpus.get() > 0) {
+      fraction = std::max(fraction, cpus.get() / remainingCpus.get());
+    }
+
+    Option<Bytes> mem = task.mem();
+    Option<Bytes> remainingMem = remaining.mem();
+    if (mem.isSome() && remainingMem.isSome() &&
+        remainingMem.get().bytes() > 0) {
+      double_t memFraction = mem.get().bytes() /
+        static_cast<double_t>(remainingMem.get().bytes());
+      fraction = std::max(fraction, memFraction);
+    }
+
+    return fraction;
+  }
+
+  size_t capacity() const {
+    return tree.empty() ? 0 : tree.size() - 1;
+  }
+
+  void update(size_t slot, int64_t delta) {
+    for (size_t i = slot + 1; i < tree.size(); i += i & (~i + 1)) {
+      tree[i] += delta;
+    }
+  }
+
+  /**
+   * Returns slot with smallest index for which prefix sum of shares
+   * is greater than given value.
+   */
+  size_t find(uint64_t value) const {
+    size_t position = 0;
+    size_t step = 1;
+    while (step * 2 <= capacity()) step *= 2;
+
+    for (; step > 0; step /= 2) {
+      if (position + step <= capacity() && tree[position + step] <= value) {
+        position += step;
+        value -= tree[position];
+      }
+    }
+
+    // position is count of slots with prefix sum <= value.
+    return position;
+  }
+
+  /**
+   * Doubles capacity and rebuilds tree in O(n). Suspended jobs stay out
+   * of the tree, so it keeps matching totalShares.
+   */
+  void grow() {
+    size_t newCapacity = capacity() == 0 ? 16 : capacity() * 2;
+    tree.assign(newCapacity + 1, 0);
+
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+      if (slots[slot] != nullptr &&
+          suspended.count(slots[slot]->id) == 0) {
+        tree[slot + 1] += slots[slot]->shares;
+      }
+    }
+
+    for (size_t i = 1; i < tree.size(); i++) {
+      size_t parent = i + (i & (~i + 1));
+      if (parent < tree.size()) {
+        tree[parent] += tree[i];
+      }
+    }
+  }
+};
+
+
 #endif // SERENITY_SMOKE_QUEUE_HPP
@@ -0,0 +1,97 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <mesos/resources.hpp>
+
+#include "logging/logging.hpp"
+
+#include "smoke_job.hpp"
+#include "smoke_queue.hpp"
+
+/**
+ * Compares SmokeAliasQueue with SmokeWeightedQueue in scenario modelled
+ * after SerenityNoExecutorScheduler::resourceOffers: jobs are selected
+ * and each of them is removed from the queue when it finishes.
+ *
+ * Usage: smoke_queue_benchmark
+ */
+
+static std::vector<std::shared_ptr<SmokeJob>> createJobs(size_t count) {
+  std::vector<std::shared_ptr<SmokeJob>> jobs;
+  mesos::Resources resources = mesos::Resources::parse("cpus:1").get();
+  for (size_t i = 0; i < count; i++) {
+    jobs.push_back(std::shared_ptr<SmokeJob>(
+      new SmokeJob(i, "sleep 1", resources, 1, "job", None(), None(),
+                   i % 10 + 1)));
+  }
+  return jobs;
+}
+
+
+template <typename Queue>
+static double_t benchmark(
+    const std::vector<std::shared_ptr<SmokeJob>>& jobs,
+    size_t selectsPerRemove) {
+  auto start = std::chrono::steady_clock::now();
+
+  Queue queue;
+  for (auto& job : jobs) {
+    queue.add(job);
+  }
+
+  for (auto& job : jobs) {
+    for (size_t i = 0; i < selectsPerRemove; i++) {
+      queue.selectJob();
+    }
+    queue.removeAndReset(job);
+  }
+
+  std::chrono::duration<double_t, std::milli> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+
+int main(int argc, char** argv) {
+  // Alias method logs every rebuild - measure algorithms only.
+  FLAGS_minloglevel = google::WARNING;
+  mesos::internal::logging::initialize(argv[0], false);
+
+  const size_t SELECTS_PER_REMOVE = 10;
+
+  std::cout << "jobs\talias [ms]\tfenwick [ms]" << std::endl;
+  for (size_t count : {100, 500, 1000, 2000, 5000}) {
+    std::vector<std::shared_ptr<SmokeJob>> jobs = createJobs(count);
+
+    double_t aliasTime =
+      benchmark<SmokeAliasQueue>(jobs, SELECTS_PER_REMOVE);
+    double_t weightedTime =
+      benchmark<SmokeWeightedQueue>(jobs, SELECTS_PER_REMOVE);
+
+    std::cout << count << "\t" << aliasTime << "\t" << weightedTime
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -159,27 +159,21 @@ class SerenityNoExecutorScheduler : public Scheduler
  public:
   SerenityNoExecutorScheduler(
       const FrameworkInfo& _frameworkInfo,
-      const list<std::shared_ptr<SmokeJob>>& _jobs)
+      const list<std::shared_ptr<SmokeJob>>& _jobs,
+      bool _packOffers = false)
     : frameworkInfo(_frameworkInfo),
       tasksLaunched(0u),
       tasksFinished(0u),
       tasksTerminated(0u),
       jobsScheduled(0u),
-      jobs(_jobs) {
-    anyHostnameQueue = SmokeAliasQueue();
-
+      jobs(_jobs),
+      packOffers(_packOffers) {
     // For all jobs with specified target hostname.
     for (auto& job : jobs) {
       if (job->targetHostname.isNone()) continue;
 
-      // Add job for targeted queue.
-      auto jobQueue = queue.find(job->targetHostname.get());
-      if (jobQueue == queue.end()) {
-        queue[job->targetHostname.get()] = SmokeAliasQueue();
-      }
-
-      queue[job->targetHostname.get()]
-        .add(job);
+      // Add job for targeted queue (created in place when missing).
+      queue[job->targetHostname.get()].add(job);
     }
 
     // For all jobs with not specified target hostname.
@@ -187,8 +181,8 @@ class SerenityNoExecutorScheduler : public Scheduler
       if (job->targetHostname.isSome()) continue;
 
       // Add job to all targeted queues.
-      for (std::pair<string, SmokeAliasQueue> jobQueue : queue) {
-        queue[jobQueue.first].add(job);
+      for (auto& jobQueue : queue) {
+        jobQueue.second.add(job);
       }
 
       // Additionaly add job to anyHostname queue.
@@ -237,14 +231,16 @@ class SerenityNoExecutorScheduler : public Scheduler
       SchedulerDriver* driver,
       const vector<Offer>& offers)
   {
+    if (packOffers) {
+      packResourceOffers(driver, offers);
+      return;
+    }
+
     for (const Offer& offer : offers) {
       // Check each offer.
       if (allJobsScheduled()) {
         // In case of end of our scheduling - fully resign from any offer.
-        LOG(INFO) << "End of scheduling. Decling offers";
-        Filters filters;
-        filters.set_refuse_seconds(Duration::max().secs());
-        driver->declineOffer(offer.id(), filters);
+        declineOffer(driver, offer);
         continue;
       }
       LOG(INFO) << " ---- Received offer " << offer.id() << " from slave "
@@ -253,60 +249,127 @@ class SerenityNoExecutorScheduler : public Scheduler
 
       Resources remaining = offer.resources();
       vector<TaskInfo> tasks;
-      while(!allJobsScheduled()) {
+      fillOffer(offer.slave_id(), offer.hostname(), &remaining, &tasks);
 
-        auto jobQueuePair = queue.find(offer.hostname());
-        SmokeAliasQueue* jobQueue = &anyHostnameQueue;
-        if (jobQueuePair != queue.end()) {
-          jobQueue = &jobQueuePair->second;
-          LOG(INFO) << "Found jobQueue of size: " << jobQueue->size();
-        }
+      if (tasks.size() > 0)
+        LOG(INFO) << " ---- Launching these " << tasks.size() << " tasks.";
+      driver->acceptOffers({offer.id()}, {LAUNCH(tasks)});
+    }
+  }
 
-        if (jobQueue->finished) break;
-        std::shared_ptr<SmokeJob> job = jobQueue->selectJob();
-        if (job == nullptr) break;
-        if (job->finished()) {
-          jobQueue->removeAndReset(job);
-          continue;
-        }
+  /**
+   * Packing mode: offers from the same agent are merged, filled with all
+   * jobs which fit (best fit by size and shares) and accepted in one call.
+   */
+  void packResourceOffers(
+      SchedulerDriver* driver,
+      const vector<Offer>& offers)
+  {
+    map<string, vector<Offer>> offersBySlave;
+    for (const Offer& offer : offers) {
+      offersBySlave[offer.slave_id().value()].push_back(offer);
+    }
 
-        // Check if there are still resources for next task.
-        if (!remaining.contains(job->taskResources)) {
-          LOG(INFO) << "Not enough resources for "
-          << stringify(job->id) + "_"
-             + stringify(job->tasksLaunched)
-          << "( " << stringify(job->command) << ") "
-          << "job. Needed: " << job->taskResources
-          << " Offered: " << remaining;
-          break;
+    for (const auto& slaveOffers : offersBySlave) {
+      const Offer& firstOffer = slaveOffers.second.front();
+      if (allJobsScheduled()) {
+        for (const Offer& offer : slaveOffers.second) {
+          declineOffer(driver, offer);
         }
+        continue;
+      }
 
-        remaining -= job->taskResources;
+      Resources remaining;
+      vector<OfferID> offerIds;
+      for (const Offer& offer : slaveOffers.second) {
+        remaining += offer.resources();
+        offerIds.push_back(offer.id());
+      }
 
-        tasks.push_back(job->createTask(offer.slave_id()));
+      LOG(INFO) << " ---- Received " << offerIds.size() << " offers from slave "
+                << firstOffer.slave_id() << " (" << firstOffer.hostname()
+                << ") with " << remaining;
 
-        this->activeTasks.insert(std::pair<TaskID, SmokeTask>(
-            tasks.back().task_id(), SmokeTask(job, offer.hostname())));
+      vector<TaskInfo> tasks;
+      fillOffer(firstOffer.slave_id(), firstOffer.hostname(),
+                &remaining, &tasks);
 
-        job->tasksLaunched++;
-        tasksLaunched++;
-        LOG(INFO) << "Prepared " << tasks.back().task_id()
-                  << " ( " << stringify(job->command) << ")";
+      if (tasks.size() > 0)
+        LOG(INFO) << " ---- Launching these " << tasks.size() << " tasks. "
+                  << "Unused: " << remaining;
+      driver->acceptOffers(offerIds, {LAUNCH(tasks)});
+    }
+  }
 
-        if (job->finished()) {
-          // In case of limited jobs stop when scheduled totalTasks.
-          this->jobsScheduled++;
-          // Recalculate Alias alghoritm.
-          jobQueue->removeAndReset(job);
-        }
+  /**
+   * Prepares tasks for jobs chosen from queue of given host until
+   * remaining resources are used.
+   * Without packing jobs are chosen randomly by shares and it stops on the
+   * first job which does not fit. With packing the best fitting job
+   * (by size and shares) is chosen until no job fits.
+   */
+  void fillOffer(
+      const SlaveID& slaveId,
+      const string& hostname,
+      Resources* remaining,
+      vector<TaskInfo>* tasks)
+  {
+    auto jobQueuePair = queue.find(hostname);
+    SmokeWeightedQueue* jobQueue = &anyHostnameQueue;
+    if (jobQueuePair != queue.end()) {
+      jobQueue = &jobQueuePair->second;
+      LOG(INFO) << "Found jobQueue of size: " << jobQueue->size();
+    }
+
+    while(!allJobsScheduled()) {
+      if (jobQueue->finished || !jobQueue->hasSelectable()) break;
+      std::shared_ptr<SmokeJob> job = packOffers ?
+        jobQueue->selectBestFit(*remaining) : jobQueue->selectJob();
+      if (job == nullptr) break;
+      if (job->finished()) {
+        jobQueue->remove(job);
+        continue;
       }
 
-      if (tasks.size() > 0)
-        LOG(INFO) << " ---- Launching these " << tasks.size() << " tasks.";
-      driver->acceptOffers({offer.id()}, {LAUNCH(tasks)});
+      // Check if there are still resources for next task.
+      if (!remaining->contains(job->taskResources)) {
+        LOG(INFO) << "Not enough resources for "
+        << stringify(job->id) + "_"
+           + stringify(job->tasksLaunched)
+        << "( " << stringify(job->command) << ") "
+        << "job. Needed: " << job->taskResources
+        << " Offered: " << *remaining;
+        break;
+      }
+
+      *remaining -= job->taskResources;
+
+      tasks->push_back(job->createTask(slaveId));
+
+      this->activeTasks.insert(std::pair<TaskID, SmokeTask>(
+          tasks->back().task_id(), SmokeTask(job, hostname)));
+
+      job->tasksLaunched++;
+      tasksLaunched++;
+      LOG(INFO) << "Prepared " << tasks->back().task_id()
+                << " ( " << stringify(job->command) << ")";
+
+      if (job->finished()) {
+        // In case of limited jobs stop when scheduled totalTasks.
+        this->jobsScheduled++;
+        jobQueue->remove(job);
+      }
     }
   }
 
+  void declineOffer(SchedulerDriver* driver, const Offer& offer)
+  {
+    LOG(INFO) << "End of scheduling. Decling offers";
+    Filters filters;
+    filters.set_refuse_seconds(Duration::max().secs());
+    driver->declineOffer(offer.id(), filters);
+  }
+
   virtual void offerRescinded(
       SchedulerDriver* driver,
       const OfferID& offerId)
@@ -451,13 +514,14 @@ class SerenityNoExecutorScheduler : public Scheduler
 private:
   FrameworkInfo frameworkInfo;
   list<std::shared_ptr<SmokeJob>> jobs;
-  map<string, SmokeAliasQueue> queue;
-  SmokeAliasQueue anyHostnameQueue;
+  map<string, SmokeWeightedQueue> queue;
+  SmokeWeightedQueue anyHostnameQueue;
   size_t tasksLaunched;
   size_t tasksFinished;
   size_t tasksTerminated;
   hashmap<TaskID, SmokeTask> activeTasks;
   size_t jobsScheduled;
+  const bool packOffers;
 
   process::Owned<SerenityNoExecutorSchedulerProcess> process;
 
@@ -561,7 +625,7 @@ int main(int argc, char** argv)
     framework.set_principal(flags.principal.get());
   }
 
-  SerenityNoExecutorScheduler scheduler(framework, jobs);
+  SerenityNoExecutorScheduler scheduler(framework, jobs, flags.pack_offers);
 
   MesosSchedulerDriver* driver;
 
@@ -1,5 +1,7 @@
+#include <chrono>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "glog/logging.h"
 
@@ -33,10 +35,14 @@ class SerenityControllerProcess :
   SerenityControllerProcess(
       const lambda::function<Future<ResourceUsage>()>& _usage,
       std::shared_ptr<QoSControllerPipeline> _pipeline,
-      double _onEmptyCorrectionInterval)
+      double _onEmptyCorrectionInterval,
+      std::shared_ptr<PipelineClock> _clock,
+      std::shared_ptr<ShadowQoSPipelines> _shadows)
     : usage(_usage),
       pipeline(_pipeline),
-      onEmptyCorrectionInterval(_onEmptyCorrectionInterval) {}
+      onEmptyCorrectionInterval(_onEmptyCorrectionInterval),
+      clock(_clock),
+      shadows(_shadows) {}
 
   Future<QoSCorrections> corrections() {
     return this->usage()
@@ -45,6 +51,8 @@ class SerenityControllerProcess :
 
   Future<QoSCorrections> _corrections(
       const Future<ResourceUsage>& _resourceUsage) {
+    this->liveIterations.clear();
+    this->liveCost = 0;
     QoSCorrections corrections = this->__corrections(_resourceUsage);
 
     // TODO(bplotka): We don't want to spam slave with empty corrections.
@@ -54,19 +62,31 @@ class SerenityControllerProcess :
     this->iterations = 0;
     // TODO(bplotka): Filter out the same corrections as in previous message
     while (corrections.empty() && this->iterations < 20) {
-      // TODO(bplotka): For tests we need ability to mock sleep.
-      os::sleep(Duration::create(onEmptyCorrectionInterval).get());
+      this->clock->sleep(Duration::create(onEmptyCorrectionInterval).get());
 
       ResourceUsage usage = this->usage().get();
       corrections = this->__corrections(usage);
       this->iterations++;
     }
+
+    // Shadow pipelines are dispatched once per call (sharing one time
+    // budget), so they run after live corrections are returned to the agent
+    // and do not queue ahead of the next corrections call.
+    if (this->shadows.get() != nullptr) {
+      dispatch(self(),
+               &Self::runShadows,
+               this->liveIterations,
+               this->liveCost);
+    }
+
     return corrections;
   }
 
   QoSCorrections __corrections(
       const Future<ResourceUsage>& _resourceUsage) {
     LOG(INFO) << "[SerenityQoS] -------- Starting QoS pipeline --------";
+    const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
     Result<QoSCorrections> ret = this->pipeline->run(_resourceUsage.get());
 
     QoSCorrections corrections;
@@ -79,9 +99,26 @@ class SerenityControllerProcess :
 
     LOG(INFO) << "[SerenityQoS] ------- Ending QoS pipeline with "
               << corrections.size() << " corrections. --------";
+
+    if (this->shadows.get() != nullptr) {
+      this->liveCost += std::chrono::duration<double_t>(
+          std::chrono::steady_clock::now() - start).count();
+
+      LiveIteration iteration;
+      iteration.usage = _resourceUsage.get();
+      iteration.corrections = corrections;
+      this->liveIterations.push_back(iteration);
+    }
+
     return corrections;
   }
 
+  void runShadows(
+      const std::vector<LiveIteration>& _liveIterations,
+      double_t _liveCost) {
+    this->shadows->run(_liveIterations, _liveCost);
+  }
+
  private:
   const lambda::function<Future<ResourceUsage>()> usage;
   std::shared_ptr<QoSControllerPipeline> pipeline;
@@ -89,6 +126,14 @@ class SerenityControllerProcess :
   //! This value should be near the perf interval since it is useless
   //! to rerun QoS pipeline on the same perf's counter collection.
   double onEmptyCorrectionInterval;
+  //! Pipeline clock. Does not block when replaying usage (UsageClock).
+  std::shared_ptr<PipelineClock> clock;
+  //! Optional pipelines evaluated side by side with the live one.
+  std::shared_ptr<ShadowQoSPipelines> shadows;
+  //! Live iterations of current corrections call, replayed by shadows.
+  std::vector<LiveIteration> liveIterations;
+  //! Time (in seconds) live pipeline spent in current corrections call.
+  double_t liveCost = 0;
   //! Safeguard against infinite loop.
   uint64_t iterations = 0;
 };
@@ -109,7 +154,11 @@ Try<Nothing> SerenityController::initialize(
   }
 
   process.reset(new SerenityControllerProcess(
-      usage, this->pipeline, this->onEmptyCorrectionInterval));
+      usage,
+      this->pipeline,
+      this->onEmptyCorrectionInterval,
+      this->clock,
+      this->shadows));
   spawn(process.get());
 
   return Nothing();
@@ -9,7 +9,9 @@
 #include "mesos/slave/qos_controller.hpp"
 
 #include "pipeline/qos_pipeline.hpp"
+#include "pipeline/shadow_pipelines.hpp"
 
+#include "serenity/clock.hpp"
 #include "serenity/serenity.hpp"
 
 #include "stout/lambda.hpp"
@@ -23,18 +25,74 @@ namespace serenity {
 class SerenityControllerProcess;
 
 
+/**
+ * Hardcoded configuration of QoS pipeline used by the module. Offline
+ * tools (e.g. parameter sweep) use it as a base.
+ */
+inline SerenityConfig createSerenityControllerConfig() {
+  SerenityConfig conf;
+  // AssuranceDropAnalyzer configuration:
+  // How far we look back in samples.
+  conf[SIGNAL_DROP_ANALYZER_NAME].set(detector::WINDOW_SIZE, (uint64_t) 10);
+  // Defines how much (relatively to base point) value must drop to trigger
+  // contention.
+  // Most signal_analyzer will use that.
+  conf[SIGNAL_DROP_ANALYZER_NAME].set(
+      detector::FRACTIONAL_THRESHOLD, (double_t) 0.3);
+  conf[SIGNAL_DROP_ANALYZER_NAME].set(
+      detector::SEVERITY_FRACTION, (double_t) 2.1);
+
+  // How many iterations observers will wait with creating another
+  // correction.
+  conf[CpuContentionStrategy::NAME].set(
+      strategy::CONTENTION_COOLDOWN, (uint64_t) 10);
+  conf[SeniorityStrategy::NAME].set(
+      strategy::CONTENTION_COOLDOWN, (uint64_t) 10);
+
+  // UtilizationDetector configuration:
+  // CPU utilization threshold.
+  conf[detector::THRESHOLD].set(detector::THRESHOLD, (double_t) 0.72);
+
+  conf[TooLowUsageFilter::NAME].set(
+      too_low_usage::MINIMAL_CPU_USAGE, (double_t) 0.25);
+
+  conf.set(ema::ALPHA_CPU, (double_t) 0.9);
+  conf.set(ema::ALPHA_IPC, (double_t) 0.9);
+  conf.set(qos_pipeline::ENABLED_VISUALISATION, false);
+  conf.set(qos_pipeline::VALVE_OPENED, true);
+
+  return conf;
+}
+
+
+/**
+ * Waits between retries on empty corrections using given clock. With
+ * UsageClock (the one used by pipeline) retries do not block, so recorded
+ * traces can be replayed faster than real time.
+ *
+ * Optional shadow pipelines consume the same usage as the live pipeline.
+ * Their corrections are only compared with the live ones. They run after
+ * live corrections are returned, so they never delay the agent.
+ */
 class SerenityController: public slave::QoSController {
  public:
   explicit SerenityController(
       std::shared_ptr<QoSControllerPipeline> _pipeline,
-      double _onEmptyCorrectionInterval)
+      double _onEmptyCorrectionInterval,
+      std::shared_ptr<PipelineClock> _clock = systemClock(),
+      std::shared_ptr<ShadowQoSPipelines> _shadows = nullptr)
     : pipeline(_pipeline),
-      onEmptyCorrectionInterval(_onEmptyCorrectionInterval) {}
+      onEmptyCorrectionInterval(_onEmptyCorrectionInterval),
+      clock(_clock),
+      shadows(_shadows) {}
 
   static Try<slave::QoSController*> create(
       std::shared_ptr<QoSControllerPipeline> _pipeline,
-      double _onEmptyCorrectionInterval = 5) {
-    return new SerenityController(_pipeline, _onEmptyCorrectionInterval);
+      double _onEmptyCorrectionInterval = 5,
+      std::shared_ptr<PipelineClock> _clock = systemClock(),
+      std::shared_ptr<ShadowQoSPipelines> _shadows = nullptr) {
+    return new SerenityController(
+        _pipeline, _onEmptyCorrectionInterval, _clock, _shadows);
   }
 
   virtual ~SerenityController();
@@ -48,6 +106,8 @@ class SerenityController: public slave::QoSController {
   process::Owned<SerenityControllerProcess> process;
   std::shared_ptr<QoSControllerPipeline> pipeline;
   double onEmptyCorrectionInterval;
+  std::shared_ptr<PipelineClock> clock;
+  std::shared_ptr<ShadowQoSPipelines> shadows;
 };
 
 }  // namespace serenity
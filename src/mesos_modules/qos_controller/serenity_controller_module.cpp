@@ -10,9 +10,16 @@
 #include "mesos_modules/qos_controller/serenity_controller.hpp"
 
 #include "pipeline/qos_pipeline.hpp"
+#include "pipeline/shadow_pipelines.hpp"
 
+#include "serenity/checkpoint.hpp"
 #include "serenity/config.hpp"
+#include "serenity/journal.hpp"
+#include "serenity/os_utils.hpp"
 
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+#include "stout/strings.hpp"
 #include "stout/try.hpp"
 
 // TODO(nnielsen): Should be explicit using-directives.
@@ -25,15 +32,156 @@ using namespace mesos::serenity::qos_pipeline;  // NOLINT(build/namespaces)
 
 using mesos::serenity::CpuContentionStrategy;
 using mesos::serenity::CpuQoSPipeline;
+using mesos::serenity::DecisionJournal;
+using mesos::serenity::createSerenityControllerConfig;
+using mesos::serenity::createShadowQoSPipelineConfig;
+using mesos::serenity::GetEnviromentVariable;
+using mesos::serenity::PipelineCheckpointer;
 using mesos::serenity::SerenityConfig;
 using mesos::serenity::SerenityController;
 using mesos::serenity::SeniorityStrategy;
+using mesos::serenity::ShadowQoSPipelines;
 using mesos::serenity::SignalBasedDetector;
+using mesos::serenity::TaskPerformanceFilter;
 using mesos::serenity::TooLowUsageFilter;
+using mesos::serenity::WorkloadProfileStore;
 using mesos::serenity::QoSControllerPipeline;
 
 using mesos::slave::QoSController;
 
+// Module parameters.
+const char WORK_DIR_PARAMETER[] = "work_dir";
+const char CHECKPOINT_PATH_PARAMETER[] = "checkpoint_path";
+const char JOURNAL_PATH_PARAMETER[] = "journal_path";
+const char PROFILE_PATH_PARAMETER[] = "profile_path";
+const char SLO_ENDPOINT_PARAMETER[] = "slo_endpoint";
+const char SHADOW_PARAMETER_PREFIX[] = "shadow.";
+
+//!< Default work dir of Mesos agent.
+const char DEFAULT_AGENT_WORK_DIR[] = "/tmp/mesos";
+
+
+/**
+ * Returns value of module parameter, if it was given.
+ */
+static Option<std::string> getParameter(
+    const Parameters& parameters,
+    const std::string& key) {
+  for (const Parameter& parameter : parameters.parameter()) {
+    if (parameter.key() == key) {
+      return parameter.value();
+    }
+  }
+  return None();
+}
+
+
+/**
+ * Creates serenity directory under agent work dir (taken from work_dir
+ * parameter or MESOS_WORK_DIR).
+ */
+static Try<std::string> getSerenityDirectory(const Parameters& parameters) {
+  std::string workDir = DEFAULT_AGENT_WORK_DIR;
+  Option<std::string> workDirParameter =
+    getParameter(parameters, WORK_DIR_PARAMETER);
+  Option<std::string> workDirEnv = GetEnviromentVariable("MESOS_WORK_DIR");
+  if (workDirParameter.isSome()) {
+    workDir = workDirParameter.get();
+  } else if (workDirEnv.isSome()) {
+    workDir = workDirEnv.get();
+  }
+
+  const std::string directory = path::join(workDir, "serenity");
+  Try<Nothing> mkdir = os::mkdir(directory);
+  if (mkdir.isError()) {
+    return Error("Failed to create " + directory + ": " + mkdir.error());
+  }
+
+  return directory;
+}
+
+
+/**
+ * Pipeline state is checkpointed under agent work dir, so restarted agent
+ * continues with warm filters and detectors. checkpoint_path parameter
+ * overrides the path - empty one disables checkpointing.
+ */
+static std::string getCheckpointPath(const Parameters& parameters) {
+  Option<std::string> checkpointPath =
+    getParameter(parameters, CHECKPOINT_PATH_PARAMETER);
+  if (checkpointPath.isSome()) {
+    return checkpointPath.get();
+  }
+
+  Try<std::string> directory = getSerenityDirectory(parameters);
+  if (directory.isError()) {
+    LOG(WARNING) << "[SerenityQoS] Checkpointing disabled. "
+                 << directory.error();
+    return "";
+  }
+
+  return path::join(directory.get(), "qos_pipeline.checkpoint");
+}
+
+
+/**
+ * QoS decisions are journaled under agent work dir. journal_path parameter
+ * overrides the path - empty one disables journaling.
+ */
+static std::string getJournalPath(const Parameters& parameters) {
+  Option<std::string> journalPath =
+    getParameter(parameters, JOURNAL_PATH_PARAMETER);
+  if (journalPath.isSome()) {
+    return journalPath.get();
+  }
+
+  Try<std::string> directory = getSerenityDirectory(parameters);
+  if (directory.isError()) {
+    LOG(WARNING) << "[SerenityQoS] Journaling disabled. "
+                 << directory.error();
+    return "";
+  }
+
+  return path::join(directory.get(), "qos_decisions.journal");
+}
+
+
+/**
+ * Every shadow.<name> parameter adds shadow pipeline running live
+ * configuration with overrides given in parameter value, e.g.
+ * shadow.strict = "AssuranceDropAnalyzer.FRACTIONAL_THRESHOLD=0.2".
+ * Returns nullptr when there are no (valid) shadow pipelines.
+ */
+static std::shared_ptr<ShadowQoSPipelines> createShadowPipelines(
+    const Parameters& parameters,
+    const SerenityConfig& liveConf) {
+  std::shared_ptr<ShadowQoSPipelines> shadows(new ShadowQoSPipelines());
+  for (const Parameter& parameter : parameters.parameter()) {
+    if (!strings::startsWith(parameter.key(), SHADOW_PARAMETER_PREFIX)) {
+      continue;
+    }
+
+    const std::string name = strings::remove(
+        parameter.key(), SHADOW_PARAMETER_PREFIX, strings::PREFIX);
+    Try<SerenityConfig> shadowConf =
+      createShadowQoSPipelineConfig(liveConf, parameter.value());
+    if (shadowConf.isError()) {
+      LOG(ERROR) << "[SerenityQoS] Skipping shadow pipeline " << name
+                 << ": " << shadowConf.error();
+      continue;
+    }
+
+    LOG(INFO) << "[SerenityQoS] Adding shadow pipeline " << name;
+    shadows->add(name, std::shared_ptr<QoSControllerPipeline>(
+        new CpuQoSPipeline(shadowConf.get())));
+  }
+
+  if (shadows->size() == 0) {
+    return nullptr;
+  }
+  return shadows;
+}
+
 
 // IPC QoS pipeline.
 static QoSController* createSerenityController(
@@ -43,31 +191,27 @@ static QoSController* createSerenityController(
   //
   // --Hardcoded configuration for Serenity QoS Controller---
 
-  SerenityConfig conf;
-  // AssuranceDropAnalyzer configuration:
-  // How far we look back in samples.
-  conf[SIGNAL_DROP_ANALYZER_NAME].set(WINDOW_SIZE, (uint64_t) 10);
-  // Defines how much (relatively to base point) value must drop to trigger
-  // contention.
-  // Most signal_analyzer will use that.
-  conf[SIGNAL_DROP_ANALYZER_NAME].set(FRACTIONAL_THRESHOLD, (double_t) 0.3);
-  conf[SIGNAL_DROP_ANALYZER_NAME].set(SEVERITY_FRACTION, (double_t) 2.1);
-
-  // How many iterations observers will wait with creating another
-  // correction.
-  conf[CpuContentionStrategy::NAME].set(CONTENTION_COOLDOWN, (uint64_t) 10);
-  conf[SeniorityStrategy::NAME].set(CONTENTION_COOLDOWN, (uint64_t) 10);
-
-  // UtilizationDetector configuration:
-  // CPU utilization threshold.
-  conf[THRESHOLD].set(THRESHOLD, (double_t) 0.72);
-
-  conf[TooLowUsageFilter::NAME].set(MINIMAL_CPU_USAGE, (double_t) 0.25);
+  SerenityConfig conf = createSerenityControllerConfig();
+  conf[PipelineCheckpointer::NAME].set(
+      mesos::serenity::checkpoint::PATH, getCheckpointPath(parameters));
+  conf[DecisionJournal::NAME].set(
+      mesos::serenity::journal::PATH, getJournalPath(parameters));
+
+  // Workload profiles are learned only when profile_path is given.
+  Option<std::string> profilePath =
+    getParameter(parameters, PROFILE_PATH_PARAMETER);
+  if (profilePath.isSome()) {
+    conf[WorkloadProfileStore::NAME].set(
+        mesos::serenity::workload_profile::PATH, profilePath.get());
+  }
 
-  conf.set(ALPHA_CPU, (double_t) 0.9);
-  conf.set(ALPHA_IPC, (double_t) 0.9);
-  conf.set(ENABLED_VISUALISATION, false);
-  conf.set(VALVE_OPENED, true);
+  // Production tasks push their SLO samples to TaskPerformanceFilter
+  // endpoint. It can be disabled with slo_endpoint=false parameter.
+  Option<std::string> sloEndpoint =
+    getParameter(parameters, SLO_ENDPOINT_PARAMETER);
+  conf[TaskPerformanceFilter::NAME].set(
+      mesos::serenity::slo::ENDPOINT,
+      sloEndpoint.isNone() || sloEndpoint.get() != "false");
 
   // Since slave is configured for 5 second perf interval, it is useless to
   // check correction more often then 5 sec.
@@ -80,7 +224,9 @@ static QoSController* createSerenityController(
     SerenityController::create(
       std::shared_ptr<QoSControllerPipeline>(
           new CpuQoSPipeline(conf)),
-          onEmptyCorrectionInterval);
+          onEmptyCorrectionInterval,
+          mesos::serenity::systemClock(),
+          createShadowPipelines(parameters, conf));
 
   if (result.isError()) {
     return NULL;
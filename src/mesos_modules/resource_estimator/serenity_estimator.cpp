@@ -7,9 +7,12 @@
 
 #include "pipeline/estimator_pipeline.hpp"
 
+#include "process/clock.hpp"
 #include "process/defer.hpp"
+#include "process/delay.hpp"
 #include "process/dispatch.hpp"
 #include "process/process.hpp"
+#include "process/time.hpp"
 
 #include "stout/error.hpp"
 
@@ -24,38 +27,103 @@ class SerenityEstimatorProcess :
  public:
   SerenityEstimatorProcess(
       const lambda::function<Future<ResourceUsage>()>& _usage,
-      std::shared_ptr<ResourceEstimatorPipeline> _pipeline)
+      std::shared_ptr<ResourceEstimatorPipeline> _pipeline,
+      const Duration& _estimationInterval,
+      const Duration& _maxStaleness)
     : usage(_usage),
-      pipeline(_pipeline) {}
-
+      pipeline(_pipeline),
+      estimationInterval(_estimationInterval),
+      maxStaleness(_maxStaleness) {}
+
+  /**
+   * Returns cached slack when it is fresh enough (reduced by revocable
+   * resources allocated since it was estimated).
+   * Otherwise runs estimation on demand.
+   */
   Future<Resources> oversubscribable() {
+    if (this->slack.isSome() &&
+        (Clock::now() - this->slackTime) <= this->maxStaleness) {
+      return this->usage()
+        .then(defer(self(), &Self::_oversubscribable, lambda::_1));
+    }
+
+    return this->estimate();
+  }
+
+ protected:
+  virtual void initialize() {
+    if (this->estimationInterval > Duration::zero()) {
+      this->backgroundEstimate();
+    }
+  }
+
+  Future<Resources> estimate() {
     return this->usage()
-      .then(defer(self(), &Self::_oversubscribable, lambda::_1));
+      .then(defer(self(), &Self::_estimate, lambda::_1));
   }
 
   Future<Resources> _oversubscribable(
       const Future<ResourceUsage>& _resourceUsage) {
-    Resources allocatedRevocable;
-    foreach(auto& executor, _resourceUsage.get().executors()) {
-      allocatedRevocable += Resources(executor.allocated()).revocable();
-    }
+    return this->withoutAllocated(this->slack.get(), _resourceUsage.get());
+  }
 
+  Future<Resources> _estimate(
+      const Future<ResourceUsage>& _resourceUsage) {
     Result<Resources> ret = this->pipeline->run(_resourceUsage.get());
 
+    Resources estimated;
     if (ret.isError()) {
       LOG(ERROR) << ret.error();
-      return Resources();
-    } else if (ret.isNone()) {
-      return Resources();
+    } else if (ret.isSome()) {
+      estimated = ret.get();
     }
+
+    // Cache estimated slack for oversubscribable() calls. Allocation is
+    // subtracted when serving it, since it changes between estimations.
+    this->slack = estimated;
+    this->slackTime = Clock::now();
+
+    return this->withoutAllocated(estimated, _resourceUsage.get());
+  }
+
+  Resources withoutAllocated(
+      const Resources& estimated,
+      const ResourceUsage& resourceUsage) const {
+    // Add revocable resources one by one instead of building temporary
+    // Resources for every executor.
+    Resources allocatedRevocable;
+    foreach(auto& executor, resourceUsage.executors()) {
+      foreach(const Resource& resource, executor.allocated()) {
+        if (resource.has_revocable()) {
+          allocatedRevocable += resource;
+        }
+      }
+    }
+
     LOG(INFO) << "[SerenityEstimator] Considering allocated revocable "
               << "resources: " << allocatedRevocable;
-    return (ret.get() - allocatedRevocable);
+    return estimated - allocatedRevocable;
+  }
+
+  void backgroundEstimate() {
+    this->estimate()
+      .onAny(defer(self(), &Self::scheduleBackgroundEstimate));
+  }
+
+  void scheduleBackgroundEstimate() {
+    delay(this->estimationInterval, self(), &Self::backgroundEstimate);
   }
 
  private:
   const lambda::function<Future<ResourceUsage>()> usage;
   std::shared_ptr<ResourceEstimatorPipeline> pipeline;
+
+  const Duration estimationInterval;
+  const Duration maxStaleness;
+
+  //! Last pipeline estimate (without allocation) and time of estimation.
+  Option<Resources> slack;
+  Time slackTime;
 };
 
 
@@ -73,7 +141,8 @@ Try<Nothing> SerenityEstimator::initialize(
     return Error("Serenity estimator has already been initialized");
   }
 
-  process.reset(new SerenityEstimatorProcess(usage, this->pipeline));
+  process.reset(new SerenityEstimatorProcess(
+      usage, this->pipeline, this->estimationInterval, this->maxStaleness));
   spawn(process.get());
 
   return Nothing();
@@ -5,12 +5,15 @@
 
 #include "mesos/slave/resource_estimator.hpp"
 
+#include "stout/duration.hpp"
 #include "stout/lambda.hpp"
 #include "stout/nothing.hpp"
 #include "stout/try.hpp"
 
 #include "pipeline/estimator_pipeline.hpp"
 
+#include "serenity/default_vars.hpp"
+
 #include "process/future.hpp"
 #include "process/owned.hpp"
 
@@ -21,15 +24,34 @@ namespace serenity {
 class SerenityEstimatorProcess;
 
 
+/**
+ * SerenityEstimator runs estimation pipeline in background every
+ * estimationInterval and answers oversubscribable() from the last
+ * estimation (reduced by currently allocated revocable resources), as
+ * long as it is not older than maxStaleness.
+ * Otherwise (or when background estimation is disabled by zero interval)
+ * pipeline is run on demand.
+ */
 class SerenityEstimator : public slave::ResourceEstimator {
  public:
   explicit SerenityEstimator(
-      std::shared_ptr<ResourceEstimatorPipeline> _pipeline)
-    : pipeline(_pipeline) {}
+      std::shared_ptr<ResourceEstimatorPipeline> _pipeline,
+      const Duration& _estimationInterval =
+        Seconds(estimator::DEFAULT_ESTIMATION_INTERVAL_SEC),
+      const Duration& _maxStaleness =
+        Seconds(estimator::DEFAULT_MAX_STALENESS_SEC))
+    : pipeline(_pipeline),
+      estimationInterval(_estimationInterval),
+      maxStaleness(_maxStaleness) {}
 
   static Try<slave::ResourceEstimator*> create(
-      std::shared_ptr<ResourceEstimatorPipeline> _pipeline) {
-    return new SerenityEstimator(_pipeline);
+      std::shared_ptr<ResourceEstimatorPipeline> _pipeline,
+      const Duration& _estimationInterval =
+        Seconds(estimator::DEFAULT_ESTIMATION_INTERVAL_SEC),
+      const Duration& _maxStaleness =
+        Seconds(estimator::DEFAULT_MAX_STALENESS_SEC)) {
+    return new SerenityEstimator(
+      _pipeline, _estimationInterval, _maxStaleness);
   }
 
   virtual ~SerenityEstimator();
@@ -42,6 +64,8 @@ class SerenityEstimator : public slave::ResourceEstimator {
  protected:
   process::Owned<SerenityEstimatorProcess> process;
   std::shared_ptr<ResourceEstimatorPipeline> pipeline;
+  const Duration estimationInterval;
+  const Duration maxStaleness;
 };
 
 }  // namespace serenity
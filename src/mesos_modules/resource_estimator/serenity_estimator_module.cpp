@@ -1,3 +1,4 @@
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -11,6 +12,12 @@
 
 #include "pipeline/estimator_pipeline.hpp"
 
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+
+#include "stout/duration.hpp"
+#include "stout/numify.hpp"
+#include "stout/option.hpp"
 #include "stout/try.hpp"
 
 // TODO(nnielsen): Break up into explicit using-declarations instead.
@@ -18,18 +25,81 @@ using namespace mesos;  // NOLINT(build/namespaces).
 
 using mesos::serenity::CpuEstimatorPipeline;
 using mesos::serenity::ResourceEstimatorPipeline;
+using mesos::serenity::SerenityConfig;
 using mesos::serenity::SerenityEstimator;
 
 using mesos::slave::ResourceEstimator;
 
+// Module parameters.
+const char MEMORY_SLACK_PARAMETER[] = "memory_slack";
+const char ESTIMATION_INTERVAL_PARAMETER[] = "estimation_interval";
+const char MAX_STALENESS_PARAMETER[] = "max_staleness";
+
+
+/**
+ * Returns value of module parameter, if it was given.
+ */
+static Option<std::string> getParameter(
+    const Parameters& parameters,
+    const std::string& key) {
+  for (const Parameter& parameter : parameters.parameter()) {
+    if (parameter.key() == key) {
+      return parameter.value();
+    }
+  }
+  return None();
+}
+
+
+/**
+ * Returns duration given in seconds by module parameter or default one,
+ * when parameter is missing or invalid.
+ */
+static Duration getSecondsParameter(
+    const Parameters& parameters,
+    const std::string& key,
+    double_t defaultSeconds) {
+  Option<std::string> value = getParameter(parameters, key);
+  if (value.isNone()) {
+    return Seconds(defaultSeconds);
+  }
+
+  Try<double_t> seconds = numify<double_t>(value.get());
+  if (seconds.isError() || seconds.get() < 0) {
+    LOG(ERROR) << "[SerenityEstimator] Invalid " << key << " parameter '"
+               << value.get() << "'. Using " << defaultSeconds << " s";
+    return Seconds(defaultSeconds);
+  }
+
+  return Seconds(seconds.get());
+}
+
+
 static ResourceEstimator* createSerenityEstimator(
     const Parameters& parameters) {
   LOG(INFO) << "Loading Serenity Estimator module";
   // TODO(bplotka) Obtain the type of pipeline from parameters.
+  SerenityConfig conf;
+
+  // Revocable memory is estimated only with memory_slack=true parameter.
+  Option<std::string> memorySlack =
+    getParameter(parameters, MEMORY_SLACK_PARAMETER);
+  conf.set(mesos::serenity::estimator::MEMORY_SLACK,
+           memorySlack.isSome() && memorySlack.get() == "true");
 
+  // Slack is estimated in background every estimation_interval seconds
+  // (0 disables it) and served until it is max_staleness seconds old.
   Try<ResourceEstimator*> result = SerenityEstimator::create(
     std::shared_ptr<ResourceEstimatorPipeline>(
-        new CpuEstimatorPipeline(false, true)));
+        new CpuEstimatorPipeline(false, true, false, true, conf)),
+    getSecondsParameter(
+        parameters,
+        ESTIMATION_INTERVAL_PARAMETER,
+        mesos::serenity::estimator::DEFAULT_ESTIMATION_INTERVAL_SEC),
+    getSecondsParameter(
+        parameters,
+        MAX_STALENESS_PARAMETER,
+        mesos::serenity::estimator::DEFAULT_MAX_STALENESS_SEC));
   if (result.isError()) {
     return NULL;
   }
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <string>
+
+#include "glog/logging.h"
+
+#include "observers/memory_slack.hpp"
+#include "observers/slack_resource.hpp"
+
+#include "stout/bytes.hpp"
+
+namespace mesos {
+namespace serenity {
+
+MemorySlackObserver::MemorySlackObserver(
+    const SerenityConfig& _conf,
+    const Tag& _tag)
+  : tag(_tag),
+    defaultRole(getDefaultRole()) {
+  this->init(_conf);
+}
+
+
+MemorySlackObserver::MemorySlackObserver(
+    Consumer<Resources>* _consumer,
+    const SerenityConfig& _conf,
+    const Tag& _tag)
+  : Producer<Resources>(_consumer),
+    tag(_tag),
+    defaultRole(getDefaultRole()) {
+  this->init(_conf);
+}
+
+
+void MemorySlackObserver::init(const SerenityConfig& _conf) {
+  SerenityConfig config = MemorySlackObserverConfig(_conf);
+  this->cfgMaxOversubscriptionFraction =
+    config.getD(memory_slack::MAX_OVERSUBSCRIPTION_FRACTION);
+  this->cfgSafetyMargin = config.getD(memory_slack::SAFETY_MARGIN);
+}
+
+
+Try<Nothing> MemorySlackObserver::consume(const ResourceUsage& usage) {
+  Option<Bytes> totalAgentMem = Resources(usage.total()).mem();
+  if (totalAgentMem.isNone()) {
+    return Error(std::string(NAME) + ": Cannot estimate slack resources. " +
+                 "ResourceUsage does not contain Agent's total memory.");
+  }
+
+  double_t usedBytes = 0;
+  double_t slackBytes = 0;
+  uint64_t oversubscribedExecutors = 0;
+
+  for (const ResourceUsage_Executor& executor : usage.executors()) {
+    if (!executor.has_statistics() ||
+        !executor.statistics().has_mem_limit_bytes() ||
+        !executor.statistics().has_mem_rss_bytes()) {
+      continue;
+    }
+
+    const double_t limit = executor.statistics().mem_limit_bytes();
+    const double_t rss = executor.statistics().mem_rss_bytes();
+
+    usedBytes += rss;
+    slackBytes += std::max(0.0, limit - rss - (this->cfgSafetyMargin * limit));
+    oversubscribedExecutors++;
+  }
+
+  const double_t maxSlackBytes =
+    (this->cfgMaxOversubscriptionFraction * totalAgentMem.get().bytes()) -
+    usedBytes;
+  slackBytes = std::max(0.0, std::min(slackBytes, maxSlackBytes));
+
+  double_t slackMegabytes = slackBytes / Megabytes(1).bytes();
+  if (slackMegabytes < SLACK_EPSILON) {
+    slackMegabytes = 0.0;
+  }
+
+  SERENITY_LOG(INFO) << "Reporting memory slack: " << slackMegabytes
+                     << " MB from " << oversubscribedExecutors
+                     << " executors.";
+
+  Resource slackResult;
+  slackResult.set_name("mem");
+  slackResult.set_role(this->defaultRole);
+  slackResult.set_type(Value::SCALAR);
+  slackResult.mutable_scalar()->set_value(slackMegabytes);
+  slackResult.mutable_revocable();
+
+  produce(Resources(slackResult));
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
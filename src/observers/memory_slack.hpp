@@ -0,0 +1,92 @@
+#ifndef SERENITY_MEMORY_SLACK_HPP
+#define SERENITY_MEMORY_SLACK_HPP
+
+#include <string>
+
+#include "mesos/mesos.hpp"
+#include "mesos/resources.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/nothing.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class MemorySlackObserverConfig : public SerenityConfig {
+ public:
+  MemorySlackObserverConfig() {
+    this->initDefaults();
+  }
+
+  explicit MemorySlackObserverConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! double_t
+    //! Report up to this fraction of Agent's total memory
+    //! (minus used memory) as slack.
+    this->fields[memory_slack::MAX_OVERSUBSCRIPTION_FRACTION] =
+      memory_slack::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION;
+
+    //! double_t
+    //! Fraction of executor's memory limit which is never reported as slack.
+    this->fields[memory_slack::SAFETY_MARGIN] =
+      memory_slack::DEFAULT_SAFETY_MARGIN;
+  }
+};
+
+
+/**
+ * MemorySlackObserver observes incoming ResourceUsage and produces
+ * revocable memory (in MB) not used by executors.
+ *
+ * Executor's slack is its mem_limit_bytes reduced by RSS and safety margin.
+ * Page cache is not counted as used - kernel reclaims it under pressure.
+ * Slack is capped by maxOversubscriptionFraction of Agent's total memory.
+ *
+ * Usually it is placed after PrExecutorPassFilter, so only memory of
+ * PR executors is reported.
+ */
+class MemorySlackObserver :
+    public Consumer<ResourceUsage>, public Producer<Resources> {
+ public:
+  explicit MemorySlackObserver(
+      const SerenityConfig& _conf = SerenityConfig(),
+      const Tag& _tag = Tag(RESOURCE_ESTIMATOR, NAME));
+
+  explicit MemorySlackObserver(
+      Consumer<Resources>* _consumer,
+      const SerenityConfig& _conf = SerenityConfig(),
+      const Tag& _tag = Tag(RESOURCE_ESTIMATOR, NAME));
+
+  ~MemorySlackObserver() {}
+
+  Try<Nothing> consume(const ResourceUsage& usage) override;
+
+  static const constexpr char* NAME = "MemorySlackObserver";
+
+ protected:
+  const Tag tag;
+  const std::string defaultRole;
+
+  // cfg parameters.
+  double_t cfgMaxOversubscriptionFraction;
+  double_t cfgSafetyMargin;
+
+  /** Don't report slack when it's less than this value [MB] */
+  static constexpr const double_t SLACK_EPSILON = 1.0;
+
+ private:
+  void init(const SerenityConfig& _conf);
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_MEMORY_SLACK_HPP
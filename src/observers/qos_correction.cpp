@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <list>
 #include <vector>
 #include <utility>
@@ -8,21 +10,52 @@
 
 #include "serenity/resource_helper.hpp"
 #include "serenity/utils.hpp"
+#include "serenity/wid.hpp"
 
 namespace mesos {
 namespace serenity {
 
-QoSCorrectionObserver::~QoSCorrectionObserver() {}
+namespace {
+
+const ResourceUsage_Executor* findExecutor(
+    const ResourceUsage& usage,
+    const WID& wid) {
+  for (const ResourceUsage_Executor& executor : usage.executors()) {
+    if (WID(executor.executor_info()) == wid) {
+      return &executor;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+
+QoSCorrectionObserver::~QoSCorrectionObserver() {
+  // Do not leave Estimator pipeline throttled by destroyed observer.
+  if (publishedSlackScale.isSome() && this->publishSlackScale) {
+    StaticEventBus::publishSlackScaleEvent(1.0, eventSource);
+  }
+}
 
 void QoSCorrectionObserver::allProductsReady() {
   Contentions contentions = flattenListsInsideVector<Contentions>(
       Consumer<Contentions>::getConsumables());
   Option<ResourceUsage> usage = Consumer<ResourceUsage>::getConsumable();
 
+  if (this->aggressorScores != nullptr && usage.isSome()) {
+    evaluateCorrections(contentions, usage.get());
+  }
+
   if (contentions.size() == 0  ||
       ResourceUsageHelper::getRevocableExecutors(usage.get()).empty()) {
-    SERENITY_LOG(INFO) << "Empty contentions received.";
+    SERENITY_VLOG(1) << "Empty contentions received.";
+    const bool active =
+      iterationCooldownCounter.isSome() || publishedSlackScale.isSome();
     emptyContentionsReceived();
+    if (active) {
+      journalDecision(JournalOutcome::CONTENTIONS_GONE, contentions);
+    }
 
     // Produce empty corrections and contentions
     produceResults();
@@ -33,6 +66,7 @@ void QoSCorrectionObserver::allProductsReady() {
   if (iterationCooldownCounter.isSome()) {
     SERENITY_LOG(INFO) << "QoS Correction observer is in cooldown phase";
     cooldownPhase();
+    journalDecision(JournalOutcome::COOLDOWN, contentions);
 
     // Produce empty corrections and contentions
     produceResults();
@@ -42,6 +76,7 @@ void QoSCorrectionObserver::allProductsReady() {
   Try<QoSCorrections> corrections = newContentionsReceived();
   if (corrections.isError()) {
     SERENITY_LOG(INFO) << "corrections returned error: " << corrections.error();
+    journalDecision(JournalOutcome::STRATEGY_ERROR, contentions);
     // Produce empty corrections and contentions
     produceResults();
     return;
@@ -49,6 +84,7 @@ void QoSCorrectionObserver::allProductsReady() {
 
   if (corrections.get().empty()) {
     SERENITY_LOG(INFO) << "Strategy didn't found aggressors";
+    journalDecision(JournalOutcome::NO_AGGRESSORS, contentions);
     // Strategy didn't found aggressors.
     // Passing contentions to next QoS Controller.
     produceResults(QoSCorrections(), contentions);
@@ -58,9 +94,112 @@ void QoSCorrectionObserver::allProductsReady() {
   // Strategy has pointed aggressors, so don't pass
   // current contentions to next QoS Controller.
   iterationCooldownCounter = this->cooldownIterations;
+  if (this->aggressorScores != nullptr) {
+    trackCorrection(corrections.get(), contentions, usage.get());
+  }
+  journalDecision(JournalOutcome::CORRECTED, contentions, corrections.get());
   produceResults(corrections.get(), Contentions());
 }
 
+void QoSCorrectionObserver::setAggressorScores(
+    std::shared_ptr<AggressorScores> _scores,
+    const lambda::function<usage::GetterFunction>& _victimSignal) {
+  this->aggressorScores = _scores;
+  this->victimSignal = _victimSignal;
+  this->revocationStrategy->setAggressorScores(_scores);
+}
+
+
+void QoSCorrectionObserver::trackCorrection(
+    const QoSCorrections& corrections,
+    const Contentions& contentions,
+    const ResourceUsage& usage) {
+  PendingCorrection pending;
+  for (const slave::QoSCorrection& correction : corrections) {
+    if (!correction.has_kill()) {
+      continue;
+    }
+
+    const ResourceUsage_Executor* aggressor =
+      findExecutor(usage, WID(correction.kill()));
+    if (aggressor != nullptr) {
+      pending.aggressors.push_back(aggressor->executor_info());
+    }
+  }
+
+  if (pending.aggressors.empty()) {
+    return;
+  }
+
+  for (const Contention& contention : contentions) {
+    if (!contention.has_victim() || !this->victimSignal) {
+      continue;
+    }
+
+    const ResourceUsage_Executor* victim =
+      findExecutor(usage, WID(contention.victim()));
+    if (victim == nullptr) {
+      continue;
+    }
+
+    Try<double_t> signal = this->victimSignal(*victim);
+    if (signal.isSome() && signal.get() > 0) {
+      pending.victims.push_back(
+          std::make_pair(contention.victim(), signal.get()));
+    }
+  }
+
+  this->pendingCorrections.push_back(pending);
+}
+
+
+void QoSCorrectionObserver::evaluateCorrections(
+    const Contentions& contentions,
+    const ResourceUsage& usage) {
+  auto pending = this->pendingCorrections.begin();
+  while (pending != this->pendingCorrections.end()) {
+    pending->iterations++;
+    if (contentions.empty()) {
+      pending->quietIterations++;
+    }
+
+    if (pending->iterations < this->aggressorScores->window()) {
+      ++pending;
+      continue;
+    }
+
+    // Relative change of signal of victims which are still running.
+    double_t signalChange = 0;
+    uint64_t measuredVictims = 0;
+    for (const auto& victim : pending->victims) {
+      const ResourceUsage_Executor* executor =
+        findExecutor(usage, WID(victim.first));
+      if (executor == nullptr) {
+        continue;
+      }
+
+      Try<double_t> signal = this->victimSignal(*executor);
+      if (signal.isError()) {
+        continue;
+      }
+
+      signalChange += (signal.get() - victim.second) / victim.second;
+      measuredVictims++;
+    }
+
+    const double_t effectiveness = measuredVictims > 0 ?
+      signalChange / measuredVictims :
+      2.0 * pending->quietIterations / pending->iterations - 1.0;
+
+    for (const ExecutorInfo& aggressor : pending->aggressors) {
+      this->aggressorScores->update(aggressor, effectiveness);
+    }
+
+    pending = this->pendingCorrections.erase(pending);
+  }
+}
+
+
 void QoSCorrectionObserver::produceResults(
     QoSCorrections _qosCorrections,
     Contentions _contentions) {
@@ -68,14 +207,42 @@ void QoSCorrectionObserver::produceResults(
   produce<Contentions>(_contentions);
 }
 
+void QoSCorrectionObserver::journalDecision(
+    JournalOutcome outcome,
+    const Contentions& contentions,
+    const QoSCorrections& corrections) {
+  if (this->journal == nullptr) {
+    return;
+  }
+
+  JournalRecord record = JournalRecord();
+  record.setSource(this->journalSource);
+  record.outcome = outcome;
+  record.cooldown = iterationCooldownCounter.getOrElse(0);
+  record.slackScale = publishedSlackScale.getOrElse(-1.0);
+  for (const Contention& contention : contentions) {
+    record.addContention(contention);
+  }
+  for (const slave::QoSCorrection& correction : corrections) {
+    record.addCorrection(correction);
+  }
+
+  this->journal->append(&record);
+}
+
+
 void QoSCorrectionObserver::emptyContentionsReceived() {
   // Restart state of QoSCorrection observer
   if (iterationCooldownCounter.isSome()) {
     iterationCooldownCounter = None();
   }
-  if (estimatorPipelineDisabled) {
-    StaticEventBus::publishOversubscriptionCtrlEvent(true);
-    estimatorPipelineDisabled = false;
+  if (publishedSlackScale.isSome()) {
+    // Restore full slack in Estimator pipeline.
+    if (this->publishSlackScale) {
+      StaticEventBus::publishSlackScaleEvent(1.0, eventSource);
+    }
+    publishedSlackScale = None();
+    publishedMemoryContention = false;
   }
 }
 
@@ -95,19 +262,64 @@ void QoSCorrectionObserver::cooldownPhase() {
 }
 
 Try<QoSCorrections> QoSCorrectionObserver::newContentionsReceived() {
-  if (!estimatorPipelineDisabled) {
-    // Disable Estimator pipeline.
-    StaticEventBus::publishOversubscriptionCtrlEvent(false);
-    estimatorPipelineDisabled = true;
-  }
-
   Contentions contentions = flattenListsInsideVector<Contentions>(
       Consumer<Contentions>::getConsumables());
   Option<ResourceUsage> usage = Consumer<ResourceUsage>::getConsumable();
+
+  // Throttle slack in Estimator pipeline according to severity. Memory
+  // slack is not offered at all during MEMORY contention.
+  double_t slackScale = countSlackScale(contentions, usage.get());
+  const bool memoryContention = std::any_of(
+      contentions.begin(),
+      contentions.end(),
+      [](const Contention& contention) {
+        return contention.type() == Contention_Type_MEMORY;
+      });
+  if (publishedSlackScale.isNone() ||
+      publishedSlackScale.get() != slackScale ||
+      publishedMemoryContention != memoryContention) {
+    SERENITY_LOG(INFO) << "Scaling estimated slack to " << slackScale;
+    if (this->publishSlackScale) {
+      StaticEventBus::publishSlackScaleEvent(
+          slackScale, eventSource, memoryContention);
+    }
+    publishedSlackScale = slackScale;
+    publishedMemoryContention = memoryContention;
+  }
+
   return this->revocationStrategy->decide(this->executorAgeFilter,
                                           contentions,
                                           usage.get());
 }
 
+
+double_t QoSCorrectionObserver::countSlackScale(
+    const Contentions& contentions,
+    const ResourceUsage& usage) const {
+  Option<double_t> totalAgentCpus = Resources(usage.total()).cpus();
+
+  double_t maxSeverity = 0.0;
+  for (const Contention& contention : contentions) {
+    if (!contention.has_severity()) {
+      // Unknown severity - stop offering slack.
+      return 0.0;
+    }
+
+    double_t severity = std::abs(contention.severity());
+    if (contention.type() == Contention_Type_CPU) {
+      if (totalAgentCpus.isNone() || totalAgentCpus.get() <= 0) {
+        return 0.0;
+      }
+      severity /= totalAgentCpus.get();
+    }
+
+    maxSeverity = std::max(maxSeverity, severity);
+  }
+
+  double_t scale =
+    1.0 - strategy::DEFAULT_SLACK_SCALE_SEVERITY_WEIGHT * maxSeverity;
+  return std::min(1.0, std::max(0.0, scale));
+}
+
 }  // namespace serenity
 }  // namespace mesos
@@ -2,7 +2,9 @@
 #define SERENITY_QOS_CORRECTION_HPP
 
 #include <list>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "filters/executor_age.hpp"
@@ -16,7 +18,14 @@
 
 #include "messages/serenity.hpp"
 
+#include "process/id.hpp"
+
+#include "stout/lambda.hpp"
+
+#include "serenity/aggressor_scores.hpp"
 #include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/journal.hpp"
 #include "serenity/serenity.hpp"
 
 #include "observers/strategies/base.hpp"
@@ -31,8 +40,10 @@ namespace serenity {
  * QoSCorrection consumes Contentions and passes them to Strategy
  * to produce revocations.
  *
- * When new contention appears, it sends "Disable" message to
- * Estimator pipeline to make environment stable.
+ * When new contention appears, it sends slack scale derived from
+ * contentions severity to Estimator pipeline, so less slack is offered
+ * until environment is stable. When contentions are gone, it sends full
+ * (1.0) scale back.
  *
  * When strategy generates QoSCorrections, OoSCorrectionObserver starts
  * CooldownCounter, to give platform time to stabilize.
@@ -41,6 +52,21 @@ namespace serenity {
  * When strategy does not yield any Corrections, QoSCorrectionObserver
  * passes Contentions to next QoSCorrectionObserver in pipeline (and,
  * produces empty Corrections).
+ *
+ * When AggressorScores are given, outcome of each correction is evaluated
+ * after AggressorScores::window() iterations and updates scores of
+ * revoked workloads (which the strategy uses for ranking). Effectiveness
+ * is the relative change of victims' signal since the correction (e.g.
+ * +1 when IPC dropped by half recovered), or - when there is no victim
+ * signal - the fraction of iterations without contentions mapped to
+ * [-1, 1].
+ *
+ * Slack scale events can be disabled (e.g. in shadow pipeline, which
+ * must not throttle live Estimator) - scale is then only recorded.
+ *
+ * When DecisionJournal is given, every decision about non empty
+ * contentions (and reset of observer state) is appended to it under
+ * journalSource name.
  */
 class QoSCorrectionObserver : public Consumer<Contentions>,
                               public Consumer<ResourceUsage>,
@@ -53,12 +79,19 @@ class QoSCorrectionObserver : public Consumer<Contentions>,
       RevocationStrategy* _revStrategy =
           new SeniorityStrategy(SerenityConfig()),
       uint32_t _cooldownIterations = strategy::DEFAULT_CONTENTION_COOLDOWN,
-      const Tag& _tag = Tag(QOS_CONTROLLER, NAME)) :
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME),
+      std::shared_ptr<DecisionJournal> _journal = nullptr,
+      const std::string& _journalSource = NAME) :
         Producer<QoSCorrections>(_consumer),
         revocationStrategy(_revStrategy),
         executorAgeFilter(_ageFilter),
         cooldownIterations(_cooldownIterations),
-        tag(_tag) {}
+        tag(_tag),
+        eventSource(process::ID::generate(NAME)),
+        publishSlackScale(true),
+        journal(_journal),
+        journalSource(_journalSource),
+        publishedMemoryContention(false) {}
 
   ~QoSCorrectionObserver();
 
@@ -67,20 +100,68 @@ class QoSCorrectionObserver : public Consumer<Contentions>,
     return Producer<T>::addConsumer(consumer);
   }
 
+  /**
+   * Enables evaluation of corrections. Victim signal is optional.
+   */
+  void setAggressorScores(
+      std::shared_ptr<AggressorScores> _scores,
+      const lambda::function<usage::GetterFunction>& _victimSignal = nullptr);
+
+  /**
+   * Enables or disables sending slack scale events to Estimator pipeline.
+   */
+  void setSlackScalePublishing(bool enabled) {
+    this->publishSlackScale = enabled;
+  }
+
   static constexpr const char* NAME = "QoSCorrectionObserver";
 
  protected:
+  //! Correction which outcome is not evaluated yet.
+  struct PendingCorrection {
+    PendingCorrection() : iterations(0), quietIterations(0) {}
+
+    std::list<ExecutorInfo> aggressors;
+    //! Victims with their signal at the time of correction.
+    std::list<std::pair<WorkID, double_t>> victims;
+    uint64_t iterations;
+    uint64_t quietIterations;
+  };
+
+  void trackCorrection(const QoSCorrections& corrections,
+                       const Contentions& contentions,
+                       const ResourceUsage& usage);
+
+  void evaluateCorrections(const Contentions& contentions,
+                           const ResourceUsage& usage);
+
   void allProductsReady() override;
 
   void emptyContentionsReceived();
 
   Try<QoSCorrections> newContentionsReceived();
 
+  /**
+   * Counts fraction of slack which should be still offered for given
+   * contentions: 1 - weight * max(normalized severity), clamped to [0, 1].
+   * CPU contention severity (in CPUs) is normalized by total Agent's CPUs.
+   */
+  double_t countSlackScale(const Contentions& contentions,
+                           const ResourceUsage& usage) const;
+
   void cooldownPhase();
 
   void produceResults(QoSCorrections _corrections = QoSCorrections(),
                       Contentions _contentions = Contentions());
 
+  /**
+   * Appends decision with current cooldown and slack scale to the journal
+   * (if any).
+   */
+  void journalDecision(JournalOutcome outcome,
+                       const Contentions& contentions,
+                       const QoSCorrections& corrections = QoSCorrections());
+
   RevocationStrategy* revocationStrategy;
 
   ExecutorAgeFilter* executorAgeFilter;
@@ -88,17 +169,28 @@ class QoSCorrectionObserver : public Consumer<Contentions>,
   const Tag tag;
 
   template <typename T>
-  Try<Nothing> produce(T product) {
+  Try<Nothing> produce(const T& product) {
     return Producer<T>::produce(product);
   }
 
+  //! Source name of slack scale events sent by this observer.
+  const std::string eventSource;
+  bool publishSlackScale;
+
+  std::shared_ptr<DecisionJournal> journal;
+
+  //! Name of this observer in journal records.
+  const std::string journalSource;
+
   /**
-   *  QoSCorrectionObserver correction observer sends 'disable'
-   *  message to valve in Estimator pipeline when contention arises.
+   *  QoSCorrectionObserver correction observer sends slack scale
+   *  to Estimator pipeline when contention arises.
    *
-   *  If this happens, this variable is 'TRUE'
+   *  If this happens, this variable holds last sent scale.
    */
-  bool estimatorPipelineDisabled;
+  Option<double_t> publishedSlackScale;
+  //! Whether last sent scale was caused by MEMORY contention.
+  bool publishedMemoryContention;
 
   /**
    * Counter (in iterations) until next revocation.
@@ -106,6 +198,13 @@ class QoSCorrectionObserver : public Consumer<Contentions>,
    */
   Option<uint64_t> iterationCooldownCounter;
 
+  std::shared_ptr<AggressorScores> aggressorScores;
+
+  //! Signal of victims (higher is better) used to evaluate corrections.
+  lambda::function<usage::GetterFunction> victimSignal;
+
+  std::list<PendingCorrection> pendingCorrections;
+
   // Configuration parameters.
 
   /**
@@ -1,20 +1,202 @@
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "bus/event_bus.hpp"
+
 #include "glog/logging.h"
 
 #include "mesos/mesos.hpp"
 
 #include "observers/slack_resource.hpp"
 
+#include "process/id.hpp"
+#include "process/process.hpp"
+#include "process/protobuf.hpp"
+
 #include "serenity/metrics_helper.hpp"
 
+#include "stout/hashmap.hpp"
+#include "stout/hashset.hpp"
+
 namespace mesos {
 namespace serenity {
 
+/**
+ * Receives slack scale from OversubscriptionCtrlEvent and keeps minimum
+ * scale from all sources in target shared with SlackResourceObserver.
+ * Memory target is the same, but it is zero while any source reports
+ * MEMORY contention.
+ */
+class SlackScaleEventProcess
+  : public ProtobufProcess<SlackScaleEventProcess> {
+ public:
+  SlackScaleEventProcess(
+      const std::shared_ptr<std::atomic<double_t>>& _target,
+      const std::shared_ptr<std::atomic<double_t>>& _memoryTarget)
+    : ProcessBase(process::ID::generate("serenity_slack_scale")),
+      target(_target),
+      memoryTarget(_memoryTarget) {
+    install<OversubscriptionCtrlEventEnvelope>(
+      &SlackScaleEventProcess::slackScaleHandle,
+      &OversubscriptionCtrlEventEnvelope::message);
+
+    // Subscribe for OversubscriptionCtrlEventEnvelope messages.
+    StaticEventBus::subscribe<OversubscriptionCtrlEventEnvelope>(self());
+  }
+
+  virtual ~SlackScaleEventProcess() {}
+
+  void slackScaleHandle(const OversubscriptionCtrlEvent& msg) {
+    if (!msg.has_slack_scale()) {
+      return;
+    }
+
+    // Full scale does not throttle, so such source is forgotten (e.g.
+    // observer restored slack when it was destroyed).
+    const double_t sourceScale =
+      std::min(1.0, std::max(0.0, msg.slack_scale()));
+    if (sourceScale < 1.0) {
+      scales[msg.source()] = sourceScale;
+    } else {
+      scales.erase(msg.source());
+    }
+    if (msg.memory_contention()) {
+      memoryContentions.insert(msg.source());
+    } else {
+      memoryContentions.erase(msg.source());
+    }
+
+    double_t minScale = 1.0;
+    for (const auto& scale : scales) {
+      minScale = std::min(minScale, scale.second);
+    }
+
+    target->store(minScale);
+    memoryTarget->store(memoryContentions.empty() ? minScale : 0.0);
+  }
+
+ private:
+  std::shared_ptr<std::atomic<double_t>> target;
+  std::shared_ptr<std::atomic<double_t>> memoryTarget;
+
+  //! Last slack scale for each source.
+  hashmap<std::string, double_t> scales;
+  //! Sources which reported MEMORY contention in their last event.
+  hashset<std::string> memoryContentions;
+};
+
+
+SlackResourceObserver::SlackResourceObserver(
+    double_t _maxOversubscriptionFraction,
+    double_t _slackScaleRecoveryStep,
+    const SerenityConfig& _conf)
+  : previousSamples(new ExecutorSet()),
+    maxOversubscriptionFraction(_maxOversubscriptionFraction),
+    slackScaleTarget(new std::atomic<double_t>(1.0)),
+    memorySlackScaleTarget(new std::atomic<double_t>(1.0)),
+    slackScaleProcess(new SlackScaleEventProcess(
+        slackScaleTarget, memorySlackScaleTarget)),
+    slackScale(1.0),
+    memorySlackScale(1.0),
+    slackScaleRecoveryStep(_slackScaleRecoveryStep),
+    usageSketches(new ExecutorMap<QuantileSketch>()),
+    default_role(getDefaultRole()) {
+  SlackObserverConfig conf(_conf);
+  this->percentileMode =
+    conf.getS(slack_observer::MODE) == slack_observer::PERCENTILE_MODE;
+  this->percentile = conf.getD(slack_observer::PERCENTILE);
+  this->horizon = conf.getU64(slack_observer::HORIZON);
+
+  process::spawn(slackScaleProcess.get());
+}
+
+
+SlackResourceObserver::SlackResourceObserver(
+    Consumer<Resources>* _consumer,
+    double_t _maxOversubscriptionFraction,
+    double_t _slackScaleRecoveryStep,
+    const SerenityConfig& _conf)
+  : Producer<Resources>(_consumer),
+    previousSamples(new ExecutorSet()),
+    maxOversubscriptionFraction(_maxOversubscriptionFraction),
+    slackScaleTarget(new std::atomic<double_t>(1.0)),
+    memorySlackScaleTarget(new std::atomic<double_t>(1.0)),
+    slackScaleProcess(new SlackScaleEventProcess(
+        slackScaleTarget, memorySlackScaleTarget)),
+    slackScale(1.0),
+    memorySlackScale(1.0),
+    slackScaleRecoveryStep(_slackScaleRecoveryStep),
+    usageSketches(new ExecutorMap<QuantileSketch>()),
+    default_role(getDefaultRole()) {
+  SlackObserverConfig conf(_conf);
+  this->percentileMode =
+    conf.getS(slack_observer::MODE) == slack_observer::PERCENTILE_MODE;
+  this->percentile = conf.getD(slack_observer::PERCENTILE);
+  this->horizon = conf.getU64(slack_observer::HORIZON);
+
+  process::spawn(slackScaleProcess.get());
+}
+
+
+SlackResourceObserver::~SlackResourceObserver() {
+  process::terminate(slackScaleProcess.get());
+  process::wait(slackScaleProcess.get());
+}
+
+
+void SlackResourceObserver::updateSlackScale() {
+  rampSlackScale(slackScaleTarget->load(), &slackScale);
+  rampSlackScale(memorySlackScaleTarget->load(), &memorySlackScale);
+}
+
+
+void SlackResourceObserver::rampSlackScale(double_t target, double_t* scale) {
+  if (target < *scale) {
+    // Throttle immediately.
+    *scale = target;
+  } else {
+    // Recover slowly.
+    *scale = std::min(target, *scale + slackScaleRecoveryStep);
+  }
+}
+
+
+double_t SlackResourceObserver::estimateCpuUsage(
+    const ResourceUsage_Executor& executor,
+    double_t cpuUsage,
+    ExecutorMap<QuantileSketch>* newSketches) {
+  if (!this->percentileMode) {
+    return cpuUsage;
+  }
+
+  auto previousSketch = this->usageSketches->find(executor.executor_info());
+  QuantileSketch sketch =
+    (previousSketch != this->usageSketches->end()) ?
+      std::move(previousSketch->second) :
+      QuantileSketch(quantile_sketch::DEFAULT_RELATIVE_ACCURACY,
+                     this->horizon);
+
+  sketch.add(cpuUsage);
+  Option<double_t> usagePercentile = sketch.quantile(this->percentile);
+
+  newSketches->insert(
+    std::make_pair(executor.executor_info(), std::move(sketch)));
+
+  // Never count less usage than current one.
+  if (usagePercentile.isNone()) {
+    return cpuUsage;
+  }
+  return std::max(cpuUsage, usagePercentile.get());
+}
+
+
 Try<Nothing> SlackResourceObserver::consume(const ResourceUsage& usage) {
   std::unique_ptr<ExecutorSet> newSamples(new ExecutorSet());
+  std::unique_ptr<ExecutorMap<QuantileSketch>> newSketches(
+    new ExecutorMap<QuantileSketch>());
   double_t cpuUsage = 0;
   double_t slackResources = 0;
   uint64_t oversubscrivedExecutors = 0;
@@ -47,7 +229,10 @@ Try<Nothing> SlackResourceObserver::consume(const ResourceUsage& usage) {
           LOG(ERROR) << std::string(NAME) << ": " << executorCpuUsage.error();
           continue;
         }
-        cpuUsage += executorCpuUsage.get();
+        const double_t executorCpuEstimate = this->estimateCpuUsage(
+            executor, executorCpuUsage.get(), newSketches.get());
+
+        cpuUsage += executorCpuEstimate;
         oversubscrivedExecutors++;
 
         if (!executor.statistics().has_cpus_limit()) {
@@ -56,7 +241,7 @@ Try<Nothing> SlackResourceObserver::consume(const ResourceUsage& usage) {
         }
 
         double_t executorCpuLimit = executor.statistics().cpus_limit();
-        double_t executorCpuSlack = executorCpuLimit - executorCpuUsage.get();
+        double_t executorCpuSlack = executorCpuLimit - executorCpuEstimate;
 
         slackResources += executorCpuSlack;
       }
@@ -67,13 +252,18 @@ Try<Nothing> SlackResourceObserver::consume(const ResourceUsage& usage) {
       (maxOversubscriptionFraction * totalAgentCpus.get()) - cpuUsage;
   if (maxSlack < slackResources) {
     slackResources = maxSlack;
-  } else if (slackResources < SLACK_EPSILON) {
+  }
+
+  this->updateSlackScale();
+  slackResources *= slackScale;
+
+  if (slackResources < SLACK_EPSILON) {
     slackResources = 0.0;
   }
 
   LOG(INFO) << std::string(NAME) << "Reporting slack value: " << slackResources
             << ", maxSlack: " << maxSlack << " from " << oversubscrivedExecutors
-            << " executors.";
+            << " executors (slack scale: " << slackScale << ").";
 
   Resource slackResult;
   Value_Scalar *cpuSlackScalar = new Value_Scalar();
@@ -91,6 +281,7 @@ Try<Nothing> SlackResourceObserver::consume(const ResourceUsage& usage) {
 
   this->previousSamples->clear();
   this->previousSamples = std::move(newSamples);
+  this->usageSketches = std::move(newSketches);
 
   return Nothing();
 }
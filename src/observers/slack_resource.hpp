@@ -1,6 +1,7 @@
 #ifndef SERENITY_SLACK_RESOURCE_HPP
 #define SERENITY_SLACK_RESOURCE_HPP
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -9,10 +10,15 @@
 #include "mesos/mesos.hpp"
 #include "mesos/resources.hpp"
 
+#include "process/owned.hpp"
+
 #include "stout/result.hpp"
 
+#include "serenity/config.hpp"
 #include "serenity/default_vars.hpp"
+#include "serenity/executor_map.hpp"
 #include "serenity/executor_set.hpp"
+#include "serenity/quantile_sketch.hpp"
 #include "serenity/serenity.hpp"
 
 namespace mesos {
@@ -28,10 +34,57 @@ inline std::string getDefaultRole() {
 }
 
 
+// Forward declaration
+class SlackScaleEventProcess;
+
+
+class SlackObserverConfig : public SerenityConfig {
+ public:
+  SlackObserverConfig() {
+    this->initDefaults();
+  }
+
+  explicit SlackObserverConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! INSTANTANEOUS: slack is counted from last CPU usage sample.
+    //! PERCENTILE: slack is counted from high percentile of executor's
+    //! CPU usage over horizon.
+    this->fields[slack_observer::MODE] =
+      std::string(slack_observer::DEFAULT_MODE);
+
+    //! double_t
+    //! Percentile of CPU usage used in PERCENTILE mode.
+    this->fields[slack_observer::PERCENTILE] =
+      slack_observer::DEFAULT_PERCENTILE;
+
+    //! uint64_t
+    //! Approximate number of last samples considered in PERCENTILE mode.
+    this->fields[slack_observer::HORIZON] = slack_observer::DEFAULT_HORIZON;
+  }
+};
+
+
 /**
  * SlackResourceObserver observes incoming ResourceUsage
  * and produces Resource with revocable flag set (Slack Resources).
  *
+ * Estimated slack is multiplied by slack scale received in
+ * OversubscriptionCtrlEvent (graduated throttling during contention).
+ * Scale drops immediately, but recovers by at most
+ * slackScaleRecoveryStep per iteration. Memory slack scale (see
+ * getMemorySlackScale) follows the same scale, but drops to zero during
+ * MEMORY contention.
+ *
+ * In PERCENTILE mode executor's CPU usage is not taken from last sample,
+ * but as a high percentile of its usage over horizon (kept in bounded
+ * QuantileSketch per executor). Single quiet sample does not produce
+ * slack which PR tasks reclaim few seconds later.
+ *
  * Currently it only counts CPU slack
  */
 class SlackResourceObserver : public Consumer<ResourceUsage>,
@@ -39,25 +92,55 @@ class SlackResourceObserver : public Consumer<ResourceUsage>,
  public:
   explicit SlackResourceObserver(
       double_t _maxOversubscriptionFraction =
-        slack_observer::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION)
-      : previousSamples(new ExecutorSet()),
-        maxOversubscriptionFraction(_maxOversubscriptionFraction),
-        default_role(getDefaultRole()) {}
+        slack_observer::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION,
+      double_t _slackScaleRecoveryStep =
+        slack_observer::DEFAULT_SLACK_SCALE_RECOVERY_STEP,
+      const SerenityConfig& _conf = SerenityConfig());
 
   SlackResourceObserver(
       Consumer<Resources>* _consumer,
       double_t _maxOversubscriptionFraction =
-        slack_observer::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION) :
-      Producer<Resources>(_consumer),
-      maxOversubscriptionFraction(_maxOversubscriptionFraction),
-      previousSamples(new ExecutorSet()),
-      default_role(getDefaultRole()) {}
+        slack_observer::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION,
+      double_t _slackScaleRecoveryStep =
+        slack_observer::DEFAULT_SLACK_SCALE_RECOVERY_STEP,
+      const SerenityConfig& _conf = SerenityConfig());
 
-  ~SlackResourceObserver() {}
+  ~SlackResourceObserver();
 
   Try<Nothing> consume(const ResourceUsage& usage) override;
 
+  /**
+   * Slack scale applied in last iteration.
+   */
+  double_t getSlackScale() const {
+    return slackScale;
+  }
+
+  /**
+   * Scale of memory slack (estimated by other observer) applied in last
+   * iteration.
+   */
+  double_t getMemorySlackScale() const {
+    return memorySlackScale;
+  }
+
  protected:
+  /**
+   * Moves slack scales towards received targets (with recovery ramp).
+   */
+  void updateSlackScale();
+
+  void rampSlackScale(double_t target, double_t* scale);
+
+  /**
+   * Returns CPU usage used for slack counting. In PERCENTILE mode adds
+   * sample to executor's sketch and moves the sketch to newSketches.
+   */
+  double_t estimateCpuUsage(
+      const ResourceUsage_Executor& executor,
+      double_t cpuUsage,
+      ExecutorMap<QuantileSketch>* newSketches);
+
   std::unique_ptr<ExecutorSet> previousSamples;
 
   /**
@@ -69,12 +152,35 @@ class SlackResourceObserver : public Consumer<ResourceUsage>,
   /** Don't report slack when it's less than this value */
   static constexpr const double_t SLACK_EPSILON = 0.001;
 
+  /**
+   * Target slack scale written by SlackScaleEventProcess.
+   */
+  std::shared_ptr<std::atomic<double_t>> slackScaleTarget;
+  std::shared_ptr<std::atomic<double_t>> memorySlackScaleTarget;
+  process::Owned<SlackScaleEventProcess> slackScaleProcess;
+
+  //!< Currently applied slack scale.
+  double_t slackScale;
+  //!< Currently applied memory slack scale.
+  double_t memorySlackScale;
+  double_t slackScaleRecoveryStep;
+
+  bool percentileMode;
+  double_t percentile;
+  uint64_t horizon;
+
+  //! CPU usage sketches of executors (PERCENTILE mode only).
+  std::unique_ptr<ExecutorMap<QuantileSketch>> usageSketches;
+
   /** Name of the class for logging purposes */
   static constexpr const char* NAME = "[Serenity] SlackObserver: ";
 
+ public:
+  /** Name of config section */
+  static constexpr const char* CONFIG_NAME = "SlackResourceObserver";
+
  private:
-  SlackResourceObserver(const SlackResourceObserver& other)
-      : default_role(getDefaultRole()) {}
+  SlackResourceObserver(const SlackResourceObserver& other) = delete;
   std::string default_role;
 };
 
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "observers/strategies/bandwidth.hpp"
+
+#include "serenity/resource_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::list;
+using std::pair;
+using std::vector;
+
+Try<QoSCorrections> BandwidthStrategy::decide(
+    ExecutorAgeFilter* ageFilter,
+    const Contentions& currentContentions,
+    const ResourceUsage& currentUsage) {
+  QoSCorrections corrections;
+
+  double_t maxSeverity = 0.0;
+  for (const Contention& contention : currentContentions) {
+    if (contention.type() != this->contentionType) {
+      SERENITY_LOG(ERROR) << "Cannot decide about contentions type other than"
+                          << " " << Contention_Type_Name(this->contentionType)
+                          << ". Omitting instance";
+      continue;
+    }
+
+    maxSeverity = std::max(maxSeverity, contention.severity());
+  }
+
+  if (maxSeverity <= 0 || this->cfgMaxBandwidth.isNone()) {
+    return corrections;
+  }
+
+  double_t bandwidthToRecover = maxSeverity * this->cfgMaxBandwidth.get();
+  SERENITY_LOG(INFO) << "Bandwidth to recover from revocable tasks: "
+                     << bandwidthToRecover << " B/s";
+
+  list<ResourceUsage_Executor> revocableExecutors =
+    ResourceUsageHelper::getRevocableExecutors(currentUsage);
+
+  vector<pair<double_t, const ResourceUsage_Executor*>> consumers;
+  for (const ResourceUsage_Executor& executor : revocableExecutors) {
+    Try<double_t> bandwidth = this->bandwidthGetFunction(executor);
+    if (bandwidth.isError() || bandwidth.get() <= 0) {
+      continue;
+    }
+
+    consumers.push_back(std::make_pair(bandwidth.get(), &executor));
+  }
+
+  // Heaviest consumers first.
+  std::sort(consumers.begin(), consumers.end(), [](
+      const pair<double_t, const ResourceUsage_Executor*>& left,
+      const pair<double_t, const ResourceUsage_Executor*>& right) {
+    return left.first > right.first;
+  });
+
+  for (const auto& consumer : consumers) {
+    if (bandwidthToRecover <= 0) break;
+
+    const ExecutorInfo& executorInfo = consumer.second->executor_info();
+    SERENITY_LOG(INFO) << "Marked executor '" << executorInfo.executor_id()
+                       << "' of framework '" << executorInfo.framework_id()
+                       << "' using " << consumer.first << " B/s for removal";
+
+    corrections.push_back(createKillQosCorrection(executorInfo));
+    bandwidthToRecover -= consumer.first;
+  }
+
+  return corrections;
+}
+
+}  // namespace serenity
+}  // namespace mesos
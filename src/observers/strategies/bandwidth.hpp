@@ -0,0 +1,50 @@
+#ifndef SERENITY_STRATEGIES_BANDWIDTH_HPP
+#define SERENITY_STRATEGIES_BANDWIDTH_HPP
+
+#include "contention_detectors/bandwidth.hpp"
+
+#include "glog/logging.h"
+
+#include "observers/strategies/base.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/lambda.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Bandwidth Strategy accepts only contentions of its type (NETWORK).
+ * Severity means fraction of maximum bandwidth (MAX_BANDWIDTH of the
+ * detector's config) to recover. Without MAX_BANDWIDTH nothing is revoked.
+ * It revokes BE executors with the biggest bandwidth of contended resource
+ * first, until enough bandwidth is recovered.
+ */
+class BandwidthStrategy : public RevocationStrategy {
+ public:
+  BandwidthStrategy(const SerenityConfig& _config,
+                    Contention_Type _contentionType)
+    : RevocationStrategy(Tag(QOS_CONTROLLER, NAME)),
+      contentionType(_contentionType),
+      bandwidthGetFunction(bandwidthGetter(_contentionType)),
+      cfgMaxBandwidth(maxBandwidth(_config)) {}
+
+  Try<QoSCorrections> decide(ExecutorAgeFilter* ageFilter,
+                             const Contentions& currentContentions,
+                             const ResourceUsage& currentUsage);
+
+  static const constexpr char* NAME = "BandwidthStrategy";
+
+ protected:
+  const Contention_Type contentionType;
+  const lambda::function<usage::GetterFunction> bandwidthGetFunction;
+  const Option<double_t> cfgMaxBandwidth;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_STRATEGIES_BANDWIDTH_HPP
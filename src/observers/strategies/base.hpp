@@ -2,6 +2,7 @@
 #define SERENITY_STRATEGIES_DECIDER_BASE_HPP
 
 #include <list>
+#include <memory>
 #include <string>
 
 #include "filters/executor_age.hpp"
@@ -13,8 +14,11 @@
 
 #include "messages/serenity.hpp"
 
+#include "serenity/aggressor_scores.hpp"
 #include "serenity/serenity.hpp"
+#include "serenity/topology.hpp"
 
+#include "stout/lambda.hpp"
 #include "stout/try.hpp"
 
 namespace mesos {
@@ -23,11 +27,21 @@ namespace serenity {
 /**
  * Base class for contention interpretations.
  * It converts contentions & usage to QoSCorrections.
+ *
+ * Socket function maps executors to sockets (NUMA nodes), so strategies
+ * can choose aggressors only among executors co-located with the
+ * contention (see colocatedExecutors).
+ *
+ * When aggressor scores are given, strategies prefer executors of
+ * workloads which revocation resolved contentions before.
  */
 class RevocationStrategy {
  public:
   // TODO(skonefal): Abstract classes should not have tag.
-  explicit RevocationStrategy(const Tag& _tag) : tag(_tag) {}
+  explicit RevocationStrategy(
+      const Tag& _tag,
+      const lambda::function<SocketFunction>& _getSocket = unknownSocket)
+    : tag(_tag), getSocket(_getSocket) {}
 
   virtual ~RevocationStrategy() {}
 
@@ -36,8 +50,15 @@ class RevocationStrategy {
       ExecutorAgeFilter* exeutorAge,
       const Contentions& contentions,
       const ResourceUsage& usage) = 0;
+
+  void setAggressorScores(std::shared_ptr<AggressorScores> _scores) {
+    this->aggressorScores = _scores;
+  }
+
  protected:
   const Tag tag;
+  const lambda::function<SocketFunction> getSocket;
+  std::shared_ptr<AggressorScores> aggressorScores;
 };
 
 }  // namespace serenity
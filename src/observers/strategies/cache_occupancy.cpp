@@ -8,6 +8,7 @@
 #include "observers/strategies/cache_occupancy.hpp"
 #include "observers/strategies/seniority.hpp"
 
+#include "serenity/data_utils.hpp"
 #include "serenity/resource_helper.hpp"
 
 
@@ -23,7 +24,11 @@ Try<QoSCorrections> CacheOccupancyStrategy::decide(
     const ResourceUsage& usage) {
 
   std::vector<ResourceUsage_Executor> beCmtEnabledExecutors
-    = getCmtEnabledExecutors(ResourceUsageHelper::getRevocableExecutors(usage));
+    = getCmtEnabledExecutors(colocatedExecutors(
+        ResourceUsageHelper::getRevocableExecutors(usage),
+        contentions,
+        usage,
+        this->getSocket));
 
   if (beCmtEnabledExecutors.empty()) {
     return QoSCorrections();
@@ -34,6 +39,20 @@ Try<QoSCorrections> CacheOccupancyStrategy::decide(
   getExecutorsAboveMinimalAndMeanOccupancy(beCmtEnabledExecutors,
                                            meanCacheOccupancy);
 
+  if (this->aggressorScores != nullptr) {
+    // Revoking known aggressors alone resolved contentions before.
+    std::vector<ResourceUsage_Executor> confident;
+    for (const ResourceUsage_Executor& aggressor : aggressors) {
+      if (this->aggressorScores->isConfident(aggressor.executor_info())) {
+        confident.push_back(aggressor);
+      }
+    }
+
+    if (!confident.empty()) {
+      aggressors = confident;
+    }
+  }
+
   SERENITY_LOG(INFO) << "Revoking " << aggressors.size() << " executors";
   QoSCorrections corrections;
   for (auto aggressor : aggressors) {
@@ -51,26 +70,21 @@ std::vector<ResourceUsage_Executor>
 CacheOccupancyStrategy::getCmtEnabledExecutors(
     const std::list<ResourceUsage_Executor>& _executors) const {
   std::vector<ResourceUsage_Executor> executors;
-#ifdef CMT_ENABLED
   for (const ResourceUsage_Executor& executor : _executors) {
     if (executor.has_statistics() &&
-        executor.statistics().has_perf() &&
-        executor.statistics().perf().has_llc_occupancy()) {
+        usage::getLlcOccupancy(executor).isSome()) {
       executors.push_back(executor);
     }
   }
-#endif
   return executors;
 }
 
 double_t CacheOccupancyStrategy::countMeanCacheOccupancy(
     const std::vector<ResourceUsage_Executor>& _executors) const {
   double_t cacheOccupacySum = 0.0;
-#ifdef CMT_ENABLED
   for (const ResourceUsage_Executor& executor : _executors) {
-    cacheOccupacySum += executor.statistics().perf().llc_occupancy();
+    cacheOccupacySum += usage::getLlcOccupancy(executor).get();
   }
-#endif
   return cacheOccupacySum / _executors.size();
 }
 
@@ -79,15 +93,13 @@ CacheOccupancyStrategy::getExecutorsAboveMinimalAndMeanOccupancy(
     const std::vector<ResourceUsage_Executor>& _executors,
     const double_t _cacheOccupancyMean) const {
   std::vector<ResourceUsage_Executor> product;
-#ifdef CMT_ENABLED
   for (const ResourceUsage_Executor& executor : _executors) {
-    uint64_t cacheOccupancy = executor.statistics().perf().llc_occupancy();
+    double_t cacheOccupancy = usage::getLlcOccupancy(executor).get();
     if (cacheOccupancy >= _cacheOccupancyMean &&
         cacheOccupancy > this->minimalCacheOccupancy) {
       product.push_back(executor);
     }
   }
-#endif
   return product;
 }
 
@@ -19,8 +19,18 @@ namespace serenity {
  * Cache Occupancy Strategy looks at executor's LLC_OCCUPANCY and revokes
  * revocable jobs that are above (inclusive) mean LLC_OCCUPANCY for node.
  *
+ * LLC occupancy is taken from usage::getLlcOccupancy, so it works both
+ * with resctrl data attached by ResctrlFilter and with perf llc_occupancy
+ * (Mesos built with CMT_ENABLED).
+ *
+ * LLC is shared per socket, so when socket of contentions is known only
+ * BE executors on that socket (or with unknown socket) are considered.
+ *
+ * When some of these executors belong to known aggressor workloads (see
+ * AggressorScores), only they are revoked.
+ *
  * It returns empty QoSCorrections when there is zero BE tasks that
- * has llc_occupancy field in perf statistics.
+ * has LLC occupancy filled.
  */
 class CacheOccupancyStrategy : public RevocationStrategy {
  public:
@@ -28,8 +38,10 @@ class CacheOccupancyStrategy : public RevocationStrategy {
     init();
   }
 
-  explicit CacheOccupancyStrategy(const SerenityConfig& _config)
-  : RevocationStrategy(Tag(QOS_CONTROLLER, NAME)) {
+  explicit CacheOccupancyStrategy(
+      const SerenityConfig& _config,
+      const lambda::function<SocketFunction>& _getSocket = unknownSocket)
+  : RevocationStrategy(Tag(QOS_CONTROLLER, NAME), _getSocket) {
     init();
   }
 
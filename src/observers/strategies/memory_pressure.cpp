@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <list>
+
+#include "observers/strategies/memory_pressure.hpp"
+
+#include "serenity/resource_helper.hpp"
+
+#include "stout/bytes.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::list;
+
+Try<QoSCorrections> MemoryPressureStrategy::decide(
+    ExecutorAgeFilter* ageFilter,
+    const Contentions& currentContentions,
+    const ResourceUsage& currentUsage) {
+  QoSCorrections corrections;
+
+  double_t maxSeverity = 0.0;
+  for (const Contention& contention : currentContentions) {
+    if (contention.type() != Contention_Type_MEMORY) {
+      SERENITY_LOG(ERROR) << "Cannot decide about contentions type other than"
+                          << " MEMORY. Omitting instance";
+      continue;
+    }
+
+    maxSeverity = std::max(maxSeverity, contention.severity());
+  }
+
+  Option<Bytes> totalAgentMem = Resources(currentUsage.total()).mem();
+  if (maxSeverity <= 0 || totalAgentMem.isNone()) {
+    return corrections;
+  }
+
+  double_t bytesToRecover = maxSeverity * totalAgentMem.get().bytes();
+  SERENITY_LOG(INFO) << "Memory to recover from revocable tasks: "
+                     << bytesToRecover << " B";
+
+  list<ResourceUsage_Executor> revocableExecutors =
+    ResourceUsageHelper::getRevocableExecutors(currentUsage);
+
+  // Biggest memory consumers first.
+  revocableExecutors.sort([](
+      const ResourceUsage_Executor& left,
+      const ResourceUsage_Executor& right) {
+    return left.statistics().mem_rss_bytes() >
+           right.statistics().mem_rss_bytes();
+  });
+
+  for (const ResourceUsage_Executor& executor : revocableExecutors) {
+    if (bytesToRecover <= 0) break;
+
+    const ExecutorInfo& executorInfo = executor.executor_info();
+    SERENITY_LOG(INFO) << "Marked executor '" << executorInfo.executor_id()
+                       << "' of framework '" << executorInfo.framework_id()
+                       << "' using " << executor.statistics().mem_rss_bytes()
+                       << " B for removal";
+
+    corrections.push_back(createKillQosCorrection(executorInfo));
+    bytesToRecover -= executor.statistics().mem_rss_bytes();
+  }
+
+  return corrections;
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,37 @@
+#ifndef SERENITY_STRATEGIES_MEMORY_PRESSURE_HPP
+#define SERENITY_STRATEGIES_MEMORY_PRESSURE_HPP
+
+#include "glog/logging.h"
+
+#include "observers/strategies/base.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/wid.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Memory Pressure Strategy accepts only Contention_Type_MEMORY.
+ * Severity means fraction of Agent's total memory to recover.
+ * It revokes BE executors with the biggest RSS first, until enough memory
+ * is recovered, so as few executors as possible are killed.
+ */
+class MemoryPressureStrategy : public RevocationStrategy {
+ public:
+  MemoryPressureStrategy() : RevocationStrategy(Tag(QOS_CONTROLLER, NAME)) {}
+
+  explicit MemoryPressureStrategy(const SerenityConfig& _config)
+    : RevocationStrategy(Tag(QOS_CONTROLLER, NAME)) {}
+
+  Try<QoSCorrections> decide(ExecutorAgeFilter* ageFilter,
+                             const Contentions& currentContentions,
+                             const ResourceUsage& currentUsage);
+
+  static const constexpr char* NAME = "MemoryPressureStrategy";
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_STRATEGIES_MEMORY_PRESSURE_HPP
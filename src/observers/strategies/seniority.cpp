@@ -21,9 +21,12 @@ Try<QoSCorrections> SeniorityStrategy::decide(
     const Contentions& currentContentions,
     const ResourceUsage& currentUsage) {
 
-  // List of BE executors.
-  list<ResourceUsage_Executor> possibleAggressors =
-  ResourceUsageHelper::getRevocableExecutors(currentUsage);
+  // List of BE executors co-located with the contention.
+  list<ResourceUsage_Executor> possibleAggressors = colocatedExecutors(
+      ResourceUsageHelper::getRevocableExecutors(currentUsage),
+      currentContentions,
+      currentUsage,
+      this->getSocket);
 
   // Aggressors to be killed. (empty for now).
   std::list<slave::QoSCorrection_Kill> aggressorsToKill;
@@ -63,6 +66,31 @@ Try<QoSCorrections> SeniorityStrategy::decide(
     return left.first < right.first;
   });
 
+  if (this->aggressorScores != nullptr) {
+    // Known aggressors first (sort is stable, so the rest stays by age).
+    executors.sort([this](
+      const pair<double_t, ResourceUsage_Executor>& left,
+      const pair<double_t, ResourceUsage_Executor>& right){
+      return this->aggressorScores->score(left.second.executor_info()) >
+             this->aggressorScores->score(right.second.executor_info());
+    });
+
+    // Revoking known aggressors alone resolved contentions before.
+    size_t confident = 0;
+    for (const auto& pair : executors) {
+      if (!this->aggressorScores->isConfident(pair.second.executor_info())) {
+        break;
+      }
+      confident++;
+    }
+
+    if (confident > 0 && confident < executorsToRevokeCnt) {
+      SERENITY_LOG(INFO) << "Revoking only " << confident
+                         << " known aggressor(s)";
+      executorsToRevokeCnt = confident;
+    }
+  }
+
   QoSCorrections corrections;
   SERENITY_LOG(INFO) << "Revoking " << executorsToRevokeCnt << " executors";
   for (const auto& pair : executors) {
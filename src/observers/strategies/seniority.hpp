@@ -15,6 +15,10 @@ namespace serenity {
  * Checks contentions and choose executors to kill.
  * Currently it calculates mean contention and based on that estimates how
  * many executors we should kill. Executors are sorted by age.
+ * Only BE executors co-located with the contention (see
+ * colocatedExecutors) are considered.
+ * Executors of known aggressor workloads (see AggressorScores) go first
+ * and, when there are any, only they are revoked.
  *
  * It also steers the valve filter using EventBus.
  */
@@ -28,8 +32,10 @@ class SeniorityStrategy : public RevocationStrategy {
    * TODO(skonefal): SerenityConfig should have const methods inside.
    *                 Currently, it cannot be passed as const.
    */
-  explicit SeniorityStrategy(SerenityConfig _config)
-      : RevocationStrategy(Tag(QOS_CONTROLLER, NAME)) {
+  explicit SeniorityStrategy(
+      SerenityConfig _config,
+      const lambda::function<SocketFunction>& _getSocket = unknownSocket)
+      : RevocationStrategy(Tag(QOS_CONTROLLER, NAME), _getSocket) {
     initialize();
     if (_config.hasKey(STARTING_SEVERITY_KEY)) {
        severity = _config.getD(STARTING_SEVERITY_KEY);
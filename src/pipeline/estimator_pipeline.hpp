@@ -9,10 +9,14 @@
 #include "mesos/mesos.hpp"
 #include "mesos/resources.hpp"
 
+#include "observers/memory_slack.hpp"
 #include "observers/slack_resource.hpp"
 
 #include "pipeline/pipeline.hpp"
+#include "pipeline/scheduler.hpp"
 
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
 #include "serenity/default_vars.hpp"
 #include "serenity/serenity.hpp"
 
@@ -45,12 +49,21 @@ using ResourceEstimatorPipeline = Pipeline<ResourceUsage, Resources>;
  *            |
  *      |ResourceUsage|
  *            |
- *    {{ Slack Observer }} // Last item.
- *            |         \
- *       |Resources|   [Resources]
- *            |                |
+ *    {{ Slack Observer }} // Last item.  [{{ Memory Slack Observer }}]
+ *            |         \                          |
+ *       |Resources|   [Resources]            [Resources]
+ *            |                |                    |
  *     {{ PIPELINE SINK }}  {{ Slack Time Series Export }}
  *
+ * Memory Slack Observer is connected only when estimator::MEMORY_SLACK
+ * is enabled. Pipeline sink sums CPU and memory slack then. Memory slack
+ * is scaled by memory slack scale of Slack Observer (QoS slack scale, zero
+ * during MEMORY contention).
+ * Valve scale lower than 1 (partial estimation) scales the slack.
+ * New executors are recognized using given pipeline clock.
+ * Slack Time Series Export is a best effort consumer - it runs after the
+ * slack is estimated, when it fits before the iteration deadline.
+ *
  * For detailed schema please see: docs/pipeline.md
  */
 class CpuEstimatorPipeline : public ResourceEstimatorPipeline {
@@ -59,20 +72,36 @@ class CpuEstimatorPipeline : public ResourceEstimatorPipeline {
       double_t _newExecutorsThreshold = new_executor::DEFAULT_THRESHOLD_SEC,
       double_t _utilizationThreshold = utilization::DEFAULT_THRESHOLD,
       bool _visualisation = false,
-      bool _valveOpened = true) :
+      bool _valveOpened = true,
+      const SerenityConfig& _conf = SerenityConfig(),
+      std::shared_ptr<PipelineClock> _clock = systemClock()) :
+      clock(_clock),
+      scheduler(
+          SerenityConfig(_conf)[PipelineScheduler::NAME],
+          Tag(RESOURCE_ESTIMATOR, PipelineScheduler::NAME)),
       // Time series exporters.
       slackTimeSeriesExporter(),
-      // Last item in pipeline.
-      slackObserver(this, 0.7),
+      // Last items in pipeline.
+      memorySlackObserver(
+          SerenityConfig(_conf)[MemorySlackObserver::NAME]),
+      slackObserver(
+          this,
+          0.7,
+          slack_observer::DEFAULT_SLACK_SCALE_RECOVERY_STEP,
+          SerenityConfig(_conf)[SlackResourceObserver::CONFIG_NAME]),
       // 4th item in pipeline.
-      ignoreNewExecutorsFilter(&slackObserver),
+      ignoreNewExecutorsFilter(
+          &slackObserver,
+          new_executor::DEFAULT_THRESHOLD_SEC,
+          _clock),
       // 3rd item in pipeline.
       prExecutorPassFilter(&ignoreNewExecutorsFilter),
       // 2nd item in pipeline.
       utilizationFilter(
           &prExecutorPassFilter,
           _utilizationThreshold,
-          Tag(RESOURCE_ESTIMATOR, "utilizationFilter")),
+          Tag(RESOURCE_ESTIMATOR, "utilizationFilter"),
+          SerenityConfig(_conf)[UtilizationThresholdFilter::NAME]),
       // First item in pipeline.
       valveFilter(
           &utilizationFilter,
@@ -81,19 +110,77 @@ class CpuEstimatorPipeline : public ResourceEstimatorPipeline {
     // NOTE(bplotka): Currently we wait one minute for testing purposes.
     // However in production env 5 minutes is a better value.
     this->ignoreNewExecutorsFilter.setThreshold(_newExecutorsThreshold);
+    if (SerenityConfig(_conf).hasKey(estimator::MEMORY_SLACK) &&
+        SerenityConfig(_conf).getB(estimator::MEMORY_SLACK)) {
+      this->ignoreNewExecutorsFilter.addConsumer(&memorySlackObserver);
+      this->memorySlackObserver.addConsumer(this);
+    }
     // Setup beginning producer.
     this->addConsumer(&valveFilter);
     // Setup Time Series Exports
     if (_visualisation) {
-      slackObserver.addConsumer(&slackTimeSeriesExporter);
+      slackObserver.addBestEffortConsumer(
+          &slackTimeSeriesExporter, &scheduler, "slackTimeSeriesExporter");
     }
   }
 
+  Result<Resources> run(const ResourceUsage& _usage) override {
+    this->clock->update(_usage);
+    this->scheduler.startIteration();
+
+    Result<Resources> result = ResourceEstimatorPipeline::run(_usage);
+
+    this->scheduler.runDeferred();
+    return result;
+  }
+
+  /**
+   * Sums slack from all observers connected to the sink. Slack is
+   * multiplied by the valve scale (partial estimation) and memory slack
+   * by memory slack scale.
+   */
+  Try<Nothing> consume(const Resources& in) override {
+    Resources slack = scaleSlack(in, this->valveFilter.getScale());
+    // Memory Slack Observer produces only memory slack.
+    if (slack.mem().isSome()) {
+      slack = scaleSlack(slack, this->slackObserver.getMemorySlackScale());
+    }
+
+    if (this->result.isSome()) {
+      this->result = this->result.get() + slack;
+    } else {
+      this->result = slack;
+    }
+
+    return Nothing();
+  }
+
  private:
+  static Resources scaleSlack(const Resources& slack, double_t scale) {
+    if (scale >= 1.0) {
+      return slack;
+    }
+
+    Resources scaled;
+    for (Resource resource : slack) {
+      if (resource.type() == Value::SCALAR) {
+        resource.mutable_scalar()->set_value(
+            resource.scalar().value() * scale);
+      }
+      scaled += resource;
+    }
+
+    return scaled;
+  }
+
+  std::shared_ptr<PipelineClock> clock;
+  PipelineScheduler scheduler;
+
   // --- Time Series Exporters ---
   SlackTimeSeriesExporter slackTimeSeriesExporter;
 
   // --- Observers ---
+  MemorySlackObserver memorySlackObserver;
   SlackResourceObserver slackObserver;
 
   // --- Filters ---
@@ -1,15 +1,23 @@
 #ifndef SERENITY_QOS_PIPELINE_HPP
 #define SERENITY_QOS_PIPELINE_HPP
 
+#include "contention_detectors/aggregated_signal.hpp"
+#include "contention_detectors/bandwidth.hpp"
+#include "contention_detectors/memory_bandwidth.hpp"
+#include "contention_detectors/memory_pressure.hpp"
 #include "contention_detectors/signal_based.hpp"
 #include "contention_detectors/overload.hpp"
 #include "contention_detectors/signal_analyzers/drop.hpp"
+#include "contention_detectors/signal_analyzers/mahalanobis.hpp"
 
 #include "filters/correction_merger.hpp"
 #include "filters/cumulative.hpp"
 #include "filters/ema.hpp"
 #include "filters/executor_age.hpp"
 #include "filters/pr_executor_pass.hpp"
+#include "filters/profile_learner.hpp"
+#include "filters/resctrl.hpp"
+#include "filters/task_performance.hpp"
 #include "filters/too_low_usage.hpp"
 #include "filters/utilization_threshold.hpp"
 #include "filters/valve.hpp"
@@ -17,16 +25,25 @@
 #include "messages/serenity.hpp"
 
 #include "pipeline/pipeline.hpp"
+#include "pipeline/scheduler.hpp"
 
 #include "observers/qos_correction.hpp"
 
+#include "observers/strategies/bandwidth.hpp"
 #include "observers/strategies/cache_occupancy.hpp"
 #include "observers/strategies/cpu_contention.hpp"
+#include "observers/strategies/memory_pressure.hpp"
 #include "observers/strategies/seniority.hpp"
 
+#include "serenity/aggressor_scores.hpp"
+#include "serenity/checkpoint.hpp"
+#include "serenity/clock.hpp"
 #include "serenity/config.hpp"
 #include "serenity/data_utils.hpp"
+#include "serenity/journal.hpp"
 #include "serenity/serenity.hpp"
+#include "serenity/topology.hpp"
+#include "serenity/workload_profile.hpp"
 
 #include "time_series_export/resource_usage_ts_export.hpp"
 
@@ -51,10 +68,37 @@ class QoSPipelineConfig : public SerenityConfig {
     this->fields[ema::ALPHA] = ema::DEFAULT_ALPHA;
     this->fields[VALVE_OPENED] = DEFAULT_VALVE_OPENED;
     this->fields[ENABLED_VISUALISATION] = DEFAULT_ENABLED_VISUALISATION;
+    this->fields[MULTIVARIATE_INTERFERENCE] =
+      DEFAULT_MULTIVARIATE_INTERFERENCE;
+    this->fields[AGGREGATED_IPC_DETECTION] = DEFAULT_AGGREGATED_IPC_DETECTION;
+    this->fields[CORRECTION_FEEDBACK] = DEFAULT_CORRECTION_FEEDBACK;
+    this->fields[MEMORY_PRESSURE_DETECTION] =
+      DEFAULT_MEMORY_PRESSURE_DETECTION;
+    this->fields[NETWORK_BANDWIDTH_DETECTION] =
+      DEFAULT_NETWORK_BANDWIDTH_DETECTION;
+    this->fields[SHADOW_MODE] = DEFAULT_SHADOW_MODE;
   }
 };
 
 
+/**
+ * Pipeline configuration with defaults. In shadow mode everything which
+ * touches world outside of the pipeline (exporters, SLO endpoint, journal
+ * and checkpoint files) is disabled.
+ */
+inline SerenityConfig createQoSPipelineConfig(const SerenityConfig& _conf) {
+  SerenityConfig conf = QoSPipelineConfig(_conf);
+  if (conf.getB(SHADOW_MODE)) {
+    conf.set(ENABLED_VISUALISATION, false);
+    conf[TaskPerformanceFilter::NAME].set(slo::ENDPOINT, false);
+    conf[DecisionJournal::NAME].set(journal::PATH, std::string());
+    conf[PipelineCheckpointer::NAME].set(checkpoint::PATH, std::string());
+  }
+
+  return conf;
+}
+
+
 using QoSControllerPipeline = Pipeline<ResourceUsage, QoSCorrections>;
 
 
@@ -69,9 +113,26 @@ using QoSControllerPipeline = Pipeline<ResourceUsage, QoSCorrections>;
  *            |
  *       {{ Valve }} (+http endpoint) // First item.
  *            |
- *   {{ Cumulative Filter }}
+ *   {{ Resctrl Filter }} (LLC occupancy & MBM, if available)
  *            |
- *      |ResourceUsage|
+ *   {{ Cumulative Filter }} ---------- {{ Task Performance Filter }}
+ *            |            \                      |
+ *            |             \        {{ SLO Signal Detector<Drop> }}
+ *            |              \                   |
+ *            |               \  |Contentions| -> {{ SLO QoS Observer }}
+ *            |                \
+ *            |                 {{ Memory Bandwidth Detector }}
+ *            |            \                      |
+ *            |             \             |Contentions| -> IPC QoS Observer
+ *            |     {{ Memory Pressure Detector }} (optional)
+ *            |                  |
+ *            |           |Contentions| -> {{ Memory QoS Observer }}
+ *            |
+ *            |---- {{ Network Bandwidth Detector }} (optional)
+ *            |                  |
+ *            |           |Contentions| -> {{ Network QoS Observer }}
+ *            |                                   |
+ *      |ResourceUsage|                   |Corrections| -> PIPELINE SINK
  *       /           \______________________
  *       |           |                      \
  *       | {{ Too Low Usage Filter }}       |
@@ -100,18 +161,87 @@ using QoSControllerPipeline = Pipeline<ResourceUsage, QoSCorrections>;
  *                          |
  *                  {{ PIPELINE SINK }}
  *
+ * Executor ages are measured with given pipeline clock. Pass UsageClock
+ * to replay recorded usage faster than real time.
+ *
+ * When PipelineCheckpointer section has CHECKPOINT_PATH set, state of
+ * executor age, cumulative, EMA filters and IPC / SLO detectors is saved
+ * periodically and restored on construction.
+ *
+ * When MEMORY_PRESSURE_DETECTION is enabled, BE executors are revoked when
+ * agent memory usage is above MEMORY_PRESSURE_THRESHOLD of
+ * MemoryPressureDetector section. Estimator stops offering memory slack
+ * during such contention.
+ *
+ * When NETWORK_BANDWIDTH_DETECTION is enabled, network bandwidth (rx + tx
+ * bytes) of all executors is compared with MAX_BANDWIDTH of
+ * NetworkBandwidthDetector section (which must be set for the node).
+ * Heaviest BE consumers are revoked.
+ *
+ * Memory bandwidth detector stays inactive until MAX_MEMORY_BANDWIDTH of
+ * MemoryBandwidthDetector section is set for the node.
+ *
+ * SLO signal comes from TaskPerformance pushed by production tasks (see
+ * TaskPerformanceFilter). Without samples this branch never detects.
+ *
+ * When MULTIVARIATE_INTERFERENCE is enabled, Interference Detector
+ * <Mahalanobis> looks at IPC, IPS, MPKI and CPU usage of each executor
+ * together (after Too Low Usage Filter) and reports contentions to the
+ * IPC QoS Observer.
+ *
+ * When AGGREGATED_IPC_DETECTION is enabled, IPC Signal Detector<Drop> is
+ * replaced by Aggregated IPC Detector, which analyzes one CPU usage
+ * weighted IPC of all production executors and picks victims only when
+ * it drops.
+ *
+ * Executors are mapped to sockets (NUMA nodes) by their cgroup cpusets
+ * (see ExecutorSocketMapper section). Aggregated IPC Detector then
+ * analyzes each socket separately, and cache occupancy and SLO strategies
+ * revoke only BE executors co-located with the victim.
+ *
+ * When CORRECTION_FEEDBACK is enabled, IPC and SLO QoS Observers evaluate
+ * whether victim's signal recovered after each correction and keep
+ * aggressor scores of revoked workloads (see AggressorScores section).
+ * Their strategies revoke known aggressors first - and only them.
+ *
+ * When WorkloadProfileStore section has PROFILE_PATH set, IPC and CPU
+ * usage baselines of production workloads are learned (after Too Low Usage
+ * Filter, skipping victims of IPC detector contentions) and persisted. EMA filters and IPC detector of new executors of
+ * known workload start from that baseline instead of warming up.
+ *
+ * When DecisionJournal section has JOURNAL_PATH set, decisions of QoS
+ * observers are recorded in the journal (see serenity-journal-reader).
+ *
+ * In SHADOW_MODE (see ShadowQoSPipelines) pipeline only makes corrections.
+ * It serves no valve or SLO endpoint, does not throttle Estimator slack
+ * and writes no journal, checkpoint or profiles (they are only read).
+ *
+ * Time series exporters and profile learner are best effort consumers -
+ * they run after corrections are made and only when they fit before
+ * ITERATION_DEADLINE of PipelineScheduler section.
+ *
  * For detailed schema please see: docs/pipeline.md
  */
 class CpuQoSPipeline : public QoSControllerPipeline {
  public:
-  explicit CpuQoSPipeline(const SerenityConfig& _conf)
-    : conf(QoSPipelineConfig(_conf)),
+  explicit CpuQoSPipeline(
+      const SerenityConfig& _conf,
+      std::shared_ptr<PipelineClock> _clock = systemClock())
+    : conf(createQoSPipelineConfig(_conf)),
+      clock(_clock),
+      checkpointer(conf[PipelineCheckpointer::NAME], _clock),
+      journal(createDecisionJournal(conf[DecisionJournal::NAME], _clock)),
+      profiles(new WorkloadProfileStore(conf[WorkloadProfileStore::NAME])),
+      profileLearner(profiles, conf[WorkloadProfileStore::NAME]),
+      socketMapper(conf[ExecutorSocketMapper::NAME]),
+      aggressorScores(new AggressorScores(conf[AggressorScores::NAME])),
+      scheduler(conf[PipelineScheduler::NAME]),
       // Time series exporters.
       rawResourcesExporter("raw"),
       emaFilteredResourcesExporter("ema"),
       // NOTE(bplotka): age Filter should initialized first before passing
       // to the qosCorrectionObserver.
-      ageFilter(),
+      ageFilter(_clock),
       // Last item in pipeline.
       correctionMerger(
           this,
@@ -125,17 +255,69 @@ class CpuQoSPipeline : public QoSControllerPipeline {
       cacheOccupancyContentionObserver(
           &correctionMerger,
           &ageFilter,
-          new CacheOccupancyStrategy(),
+          new CacheOccupancyStrategy(
+            conf[CacheOccupancyStrategy::NAME],
+            socketMapper),
           strategy::DEFAULT_CONTENTION_COOLDOWN,
-          Tag(QOS_CONTROLLER, CacheOccupancyStrategy::NAME)),
-      ipcDropDetector(
+          Tag(QOS_CONTROLLER, CacheOccupancyStrategy::NAME),
+          journal,
+          CacheOccupancyStrategy::NAME),
+      memoryBandwidthDetector(
           &cacheOccupancyContentionObserver,
+          conf[MemoryBandwidthDetector::NAME]),
+      memoryContentionObserver(
+          conf.getB(MEMORY_PRESSURE_DETECTION) ? &correctionMerger : nullptr,
+          &ageFilter,
+          new MemoryPressureStrategy(conf[MemoryPressureStrategy::NAME]),
+          strategy::DEFAULT_CONTENTION_COOLDOWN,
+          Tag(QOS_CONTROLLER, MemoryPressureStrategy::NAME),
+          journal,
+          MemoryPressureStrategy::NAME),
+      memoryPressureDetector(
+          &memoryContentionObserver,
+          conf[MemoryPressureDetector::NAME]),
+      networkContentionObserver(
+          conf.getB(NETWORK_BANDWIDTH_DETECTION) ? &correctionMerger : nullptr,
+          &ageFilter,
+          new BandwidthStrategy(
+            conf[BandwidthDetector::NETWORK_NAME],
+            Contention_Type_NETWORK),
+          strategy::DEFAULT_CONTENTION_COOLDOWN,
+          Tag(QOS_CONTROLLER, "NetworkBandwidthStrategy"),
+          journal,
+          "NetworkBandwidthStrategy"),
+      networkBandwidthDetector(
+          &networkContentionObserver,
+          Contention_Type_NETWORK,
+          conf[BandwidthDetector::NETWORK_NAME],
+          Tag(QOS_CONTROLLER, BandwidthDetector::NETWORK_NAME)),
+      ipcDropDetector(
+          conf.getB(AGGREGATED_IPC_DETECTION) ?
+            nullptr : &cacheOccupancyContentionObserver,
           usage::getEmaIpc,
           conf[SIGNAL_DROP_ANALYZER_NAME],
           Tag(QOS_CONTROLLER, "IPC detectorFilter"),
           Contention_Type_IPC),
+      interferenceDetector(
+          nullptr,
+          std::vector<lambda::function<usage::GetterFunction>>{
+            usage::getIpc,
+            usage::getIps,
+            usage::getMpki,
+            usage::getCpuUsage},
+          MahalanobisAnalyzerConfig(conf[MAHALANOBIS_ANALYZER_NAME]),
+          Tag(QOS_CONTROLLER, "Interference detectorFilter"),
+          Contention_Type_IPC),
+      aggregatedIpcDetector(
+          conf.getB(AGGREGATED_IPC_DETECTION) ?
+            &cacheOccupancyContentionObserver : nullptr,
+          usage::getEmaIpc,
+          conf[AggregatedSignalDetector::NAME],
+          socketMapper),
       ipcEMAFilter(
-          &ipcDropDetector,
+          conf.getB(AGGREGATED_IPC_DETECTION) ?
+            static_cast<Consumer<ResourceUsage>*>(&aggregatedIpcDetector) :
+            &ipcDropDetector,
           usage::getIpc,
           usage::setEmaIpc,
           conf.getD(ema::ALPHA_IPC),
@@ -151,7 +333,9 @@ class CpuQoSPipeline : public QoSControllerPipeline {
             conf[CpuContentionStrategy::NAME],
             usage::getEmaCpuUsage),
           strategy::DEFAULT_CONTENTION_COOLDOWN,
-          Tag(QOS_CONTROLLER, CpuContentionStrategy::NAME)),
+          Tag(QOS_CONTROLLER, CpuContentionStrategy::NAME),
+          journal,
+          CpuContentionStrategy::NAME),
       overloadDetector(
           &cpuContentionObserver,
           usage::getEmaCpuUsage,
@@ -163,14 +347,36 @@ class CpuQoSPipeline : public QoSControllerPipeline {
           usage::setEmaCpuUsage,
           conf.getD(ema::ALPHA_CPU),
           Tag(QOS_CONTROLLER, "cpuEMAFilter")),
+      sloContentionObserver(
+          &correctionMerger,
+          &ageFilter,
+          new SeniorityStrategy(conf[SeniorityStrategy::NAME], socketMapper),
+          strategy::DEFAULT_CONTENTION_COOLDOWN,
+          Tag(QOS_CONTROLLER, SeniorityStrategy::NAME),
+          journal,
+          SeniorityStrategy::NAME),
+      sloDropDetector(
+          &sloContentionObserver,
+          usage::getSloSignal,
+          conf[slo::ANALYZER_SECTION],
+          Tag(QOS_CONTROLLER, "SLO detectorFilter"),
+          Contention_Type_SLO),
+      taskPerformanceFilter(
+          &sloDropDetector,
+          conf[TaskPerformanceFilter::NAME],
+          _clock),
       cumulativeFilter(
           &tooLowUsageFilter,
           Tag(QOS_CONTROLLER, "cumulativeFilter")),
+      resctrlFilter(
+          &cumulativeFilter,
+          conf[ResctrlFilter::NAME]),
       // First item in pipeline. For now, close the pipeline for QoS.
       valveFilter(
-          &cumulativeFilter,
+          &resctrlFilter,
           conf.getB(VALVE_OPENED),
-          Tag(QOS_CONTROLLER, "valveFilter")) {
+          Tag(QOS_CONTROLLER, "valveFilter"),
+          !conf.getB(SHADOW_MODE)) {
     this->ageFilter.addConsumer(&valveFilter);
     // Setup starting producer.
     this->addConsumer(&ageFilter);
@@ -183,16 +389,140 @@ class CpuQoSPipeline : public QoSControllerPipeline {
 //    cumulativeFilter.addConsumer(&ipcContentionObserver);
     cumulativeFilter.addConsumer(&cacheOccupancyContentionObserver);
     cumulativeFilter.addConsumer(&cpuEMAFilter);
+    cumulativeFilter.addConsumer(&memoryBandwidthDetector);
+    cumulativeFilter.addConsumer(&taskPerformanceFilter);
+    // SLO observer needs usage with SLO signal of victims (for correction
+    // feedback).
+    taskPerformanceFilter.addConsumer(&sloContentionObserver);
+
+    if (conf.getB(MEMORY_PRESSURE_DETECTION)) {
+      cumulativeFilter.addConsumer(&memoryContentionObserver);
+      cumulativeFilter.addConsumer(&memoryPressureDetector);
+    }
+
+    if (conf.getB(NETWORK_BANDWIDTH_DETECTION)) {
+      cumulativeFilter.addConsumer(&networkContentionObserver);
+      cumulativeFilter.addConsumer(&networkBandwidthDetector);
+    }
+
+    if (conf.getB(MULTIVARIATE_INTERFERENCE)) {
+      interferenceDetector.addConsumer(&cacheOccupancyContentionObserver);
+      tooLowUsageFilter.addConsumer(&interferenceDetector);
+    }
+
+    // Shadow pipeline must not throttle live Estimator.
+    if (conf.getB(SHADOW_MODE)) {
+      for (QoSCorrectionObserver* observer : {
+              &cacheOccupancyContentionObserver,
+              &memoryContentionObserver,
+              &networkContentionObserver,
+              &cpuContentionObserver,
+              &sloContentionObserver}) {
+        observer->setSlackScalePublishing(false);
+      }
+    }
+
+    // Setup correction feedback.
+    if (conf.getB(CORRECTION_FEEDBACK)) {
+      cacheOccupancyContentionObserver.setAggressorScores(
+          aggressorScores, usage::getIpc);
+      sloContentionObserver.setAggressorScores(
+          aggressorScores, usage::getSloSignal);
+    }
+
+    // Setup workload profiles.
+    if (profiles->isEnabled()) {
+      Try<Nothing> loaded = profiles->load();
+      if (loaded.isError()) {
+        LOG(INFO) << "[SerenityQoS] Starting without workload profiles: "
+                  << loaded.error();
+      }
+
+      ipcEMAFilter.setBaseline(
+          profileBaseline(profiles, ProfileSignal::IPC));
+      cpuEMAFilter.setBaseline(
+          profileBaseline(profiles, ProfileSignal::CPU_USAGE));
+      ipcDropDetector.setBaseline(
+          profileBaseline(profiles, ProfileSignal::IPC));
+      if (!conf.getB(SHADOW_MODE)) {
+        tooLowUsageFilter.addBestEffortConsumer(
+            &profileLearner, &scheduler, "profileLearner");
+        if (conf.getB(AGGREGATED_IPC_DETECTION)) {
+          aggregatedIpcDetector.addConsumer(
+              profileLearner.getContendedExecutors());
+        } else {
+          ipcDropDetector.addConsumer(profileLearner.getContendedExecutors());
+        }
+      }
+    }
 
     // Setup Time Series export
     if (conf.getB(ENABLED_VISUALISATION)) {
-      this->addConsumer(&rawResourcesExporter);
-      ipcEMAFilter.addConsumer(&emaFilteredResourcesExporter);
+      this->addBestEffortConsumer(
+          &rawResourcesExporter, &scheduler, "rawResourcesExporter");
+      ipcEMAFilter.addBestEffortConsumer(
+          &emaFilteredResourcesExporter,
+          &scheduler,
+          "emaFilteredResourcesExporter");
+    }
+
+    // Setup checkpointing.
+    if (checkpointer.isEnabled()) {
+      checkpointer.add("ageFilter", &ageFilter);
+      checkpointer.add("cumulativeFilter", &cumulativeFilter);
+      checkpointer.add("ipcEMAFilter", &ipcEMAFilter);
+      checkpointer.add("cpuEMAFilter", &cpuEMAFilter);
+      if (!conf.getB(AGGREGATED_IPC_DETECTION)) {
+        checkpointer.add("ipcDropDetector", &ipcDropDetector);
+      }
+      checkpointer.add("sloDropDetector", &sloDropDetector);
+      if (conf.getB(MULTIVARIATE_INTERFERENCE)) {
+        checkpointer.add("interferenceDetector", &interferenceDetector);
+      }
+
+      Try<Nothing> restored = checkpointer.restore();
+      if (restored.isError()) {
+        LOG(INFO) << "[SerenityQoS] Starting with cold pipeline: "
+                  << restored.error();
+      }
     }
   }
 
+  Result<QoSCorrections> run(const ResourceUsage& _usage) override {
+    this->clock->update(_usage);
+    this->scheduler.startIteration();
+    this->socketMapper.clearCache();
+
+    Result<QoSCorrections> result = QoSControllerPipeline::run(_usage);
+
+    // Forget executors which ended, so state (and checkpoints) of filters
+    // fed with filtered usage do not grow.
+    this->ipcEMAFilter.prune(_usage);
+    this->cpuEMAFilter.prune(_usage);
+    this->ipcDropDetector.prune(_usage);
+    this->interferenceDetector.prune(_usage);
+    this->sloDropDetector.prune(_usage);
+
+    Try<Nothing> saved = this->checkpointer.iteration();
+    if (saved.isError()) {
+      LOG(ERROR) << "[SerenityQoS] " << saved.error();
+    }
+
+    this->scheduler.runDeferred();
+
+    return result;
+  }
+
  private:
   SerenityConfig conf;
+  std::shared_ptr<PipelineClock> clock;
+  PipelineCheckpointer checkpointer;
+  std::shared_ptr<DecisionJournal> journal;
+  std::shared_ptr<WorkloadProfileStore> profiles;
+  WorkloadProfileLearner profileLearner;
+  ExecutorSocketMapper socketMapper;
+  std::shared_ptr<AggressorScores> aggressorScores;
+  PipelineScheduler scheduler;
 
   // --- Time Series Exporters ---
   ResourceUsageTimeSeriesExporter rawResourcesExporter;
@@ -203,7 +533,19 @@ class CpuQoSPipeline : public QoSControllerPipeline {
   // QoSCorrectionObserver ipcContentionObserver;
   QoSCorrectionObserver cacheOccupancyContentionObserver;
 
+  MemoryBandwidthDetector memoryBandwidthDetector;
+
+  // --- Memory pressure QoS
+  QoSCorrectionObserver memoryContentionObserver;
+  MemoryPressureDetector memoryPressureDetector;
+
+  // --- Network bandwidth QoS
+  QoSCorrectionObserver networkContentionObserver;
+  BandwidthDetector networkBandwidthDetector;
+
   SignalBasedDetector ipcDropDetector;
+  SignalBasedDetector interferenceDetector;
+  AggregatedSignalDetector aggregatedIpcDetector;
   EMAFilter ipcEMAFilter;
   TooLowUsageFilter tooLowUsageFilter;
 
@@ -212,7 +554,13 @@ class CpuQoSPipeline : public QoSControllerPipeline {
   OverloadDetector overloadDetector;
   EMAFilter cpuEMAFilter;
 
+  // --- Application SLO QoS
+  QoSCorrectionObserver sloContentionObserver;
+  SignalBasedDetector sloDropDetector;
+  TaskPerformanceFilter taskPerformanceFilter;
+
   CumulativeFilter cumulativeFilter;
+  ResctrlFilter resctrlFilter;
   ExecutorAgeFilter ageFilter;
 
   ValveFilter valveFilter;
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "pipeline/scheduler.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+double_t steadyTime() {
+  return duration<double_t>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+PipelineScheduler::PipelineScheduler(
+    const SerenityConfig& _conf,
+    const Tag& _tag,
+    const lambda::function<TimeFunction>& _now)
+  : tag(_tag),
+    deadline(PipelineSchedulerConfig(_conf).getD(
+        pipeline_scheduler::DEADLINE)),
+    maxConsecutiveSkips(PipelineSchedulerConfig(_conf).getU64(
+        pipeline_scheduler::MAX_CONSECUTIVE_SKIPS)),
+    statsLogInterval(PipelineSchedulerConfig(_conf).getU64(
+        pipeline_scheduler::STATS_LOG_INTERVAL)),
+    now(_now),
+    iterationStart(_now()),
+    iterationCount(0),
+    missedDeadlineCount(0) {}
+
+
+void PipelineScheduler::defer(
+    const std::string& name,
+    const lambda::function<void()>& work) {
+  this->queue.push_back(DeferredWork{name, work});
+}
+
+
+void PipelineScheduler::startIteration() {
+  // Work which was not run in previous iteration is outdated.
+  this->skipDeferred();
+
+  if (this->statsLogInterval > 0 && this->iterationCount > 0 &&
+      this->iterationCount % this->statsLogInterval == 0) {
+    this->logStats();
+  }
+
+  this->iterationStart = this->now();
+  this->iterationCount++;
+}
+
+
+void PipelineScheduler::runDeferred() {
+  const double_t criticalEnd = this->now();
+  if (criticalEnd - this->iterationStart > this->deadline) {
+    this->missedDeadlineCount++;
+    SERENITY_LOG(WARNING) << "Critical consumers missed iteration deadline ("
+                          << criticalEnd - this->iterationStart << " s)";
+  }
+
+  std::vector<DeferredWork> deferred;
+  deferred.swap(this->queue);
+
+  for (const DeferredWork& item : deferred) {
+    DeferredWorkStats& workStats = this->stats[item.name];
+
+    const double_t start = this->now();
+    const double_t remaining = this->deadline - (start - this->iterationStart);
+    const bool starved =
+      workStats.consecutiveSkips >= this->maxConsecutiveSkips;
+    if (!starved &&
+        (remaining <= 0 || workStats.averageCost() > remaining)) {
+      workStats.skipped++;
+      workStats.consecutiveSkips++;
+      SERENITY_VLOG(1) << "Skipping " << item.name << " (time left: "
+                       << remaining << " s)";
+      continue;
+    }
+
+    item.work();
+
+    const double_t cost = this->now() - start;
+    workStats.consecutiveSkips = 0;
+    workStats.executed++;
+    workStats.totalCost += cost;
+    workStats.maxCost = std::max(workStats.maxCost, cost);
+  }
+}
+
+
+void PipelineScheduler::skipDeferred() {
+  for (const DeferredWork& item : this->queue) {
+    this->stats[item.name].skipped++;
+  }
+  this->queue.clear();
+}
+
+
+void PipelineScheduler::logStats() const {
+  SERENITY_LOG(INFO) << this->iterationCount << " iterations, "
+                     << this->missedDeadlineCount << " missed deadlines";
+  for (const auto& item : this->stats) {
+    SERENITY_LOG(INFO) << item.first << ": " << item.second.executed
+                       << " executed, " << item.second.skipped
+                       << " skipped, cost avg " << item.second.averageCost()
+                       << " s, max " << item.second.maxCost << " s";
+  }
+}
+
+}  // namespace serenity
+}  // namespace mesos
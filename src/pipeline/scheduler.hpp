@@ -0,0 +1,163 @@
+#ifndef SERENITY_PIPELINE_SCHEDULER_HPP
+#define SERENITY_PIPELINE_SCHEDULER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class PipelineSchedulerConfig : public SerenityConfig {
+ public:
+  PipelineSchedulerConfig() {
+    this->initDefaults();
+  }
+
+  explicit PipelineSchedulerConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! double_t
+    //! Seconds from the beginning of iteration. Best effort consumers are
+    //! run after critical ones only when their average cost fits before
+    //! the deadline.
+    this->fields[pipeline_scheduler::DEADLINE] =
+      pipeline_scheduler::DEFAULT_DEADLINE_SEC;
+
+    //! uint64_t
+    //! Best effort consumer skipped that many times in a row is run even
+    //! if it does not fit before the deadline. Its average cost changes
+    //! only when it runs, so otherwise it could be skipped forever.
+    this->fields[pipeline_scheduler::MAX_CONSECUTIVE_SKIPS] =
+      pipeline_scheduler::DEFAULT_MAX_CONSECUTIVE_SKIPS;
+
+    //! uint64_t
+    //! Skipped and executed work is summarized in log every that many
+    //! iterations. 0 disables the summary.
+    this->fields[pipeline_scheduler::STATS_LOG_INTERVAL] =
+      pipeline_scheduler::DEFAULT_STATS_LOG_INTERVAL;
+  }
+};
+
+
+/**
+ * Current time in seconds. Only differences are used.
+ */
+using TimeFunction = double_t();
+
+double_t steadyTime();
+
+
+/**
+ * Work of one best effort consumer.
+ */
+struct DeferredWorkStats {
+  DeferredWorkStats()
+    : executed(0),
+      skipped(0),
+      consecutiveSkips(0),
+      totalCost(0),
+      maxCost(0) {}
+
+  double_t averageCost() const {
+    return executed > 0 ? totalCost / executed : 0;
+  }
+
+  uint64_t executed;  //!< Products consumed by the consumer.
+  uint64_t skipped;  //!< Products dropped because of the deadline.
+  uint64_t consecutiveSkips;  //!< Products dropped since last execution.
+  double_t totalCost;  //!< Seconds spent in the consumer.
+  double_t maxCost;  //!< Longest consumption in seconds.
+};
+
+
+/**
+ * Runs best effort consumers of the pipeline (see
+ * Producer::addBestEffortConsumer), so critical branches (detectors,
+ * observers) are not delayed by them:
+ *
+ *   startIteration();
+ *   pipeline run - critical consumers, best effort work is deferred;
+ *   runDeferred();
+ *
+ * Deferred work is run in order it was deferred, as long as its average
+ * cost fits into what is left before the iteration deadline. Otherwise
+ * it is skipped (product is dropped) and counted in stats. Work skipped
+ * MAX_CONSECUTIVE_SKIPS times in a row is run anyway, so a consumer with
+ * an outdated (too high) average cost gets to refresh it.
+ *
+ * Stats are summarized in log every STATS_LOG_INTERVAL iterations.
+ */
+class PipelineScheduler : public DeferredWorkQueue {
+ public:
+  explicit PipelineScheduler(
+      const SerenityConfig& _conf = SerenityConfig(),
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME),
+      const lambda::function<TimeFunction>& _now = steadyTime);
+
+  void defer(const std::string& name,
+             const lambda::function<void()>& work) override;
+
+  void startIteration();
+
+  /**
+   * Runs (or skips) work deferred in this iteration.
+   */
+  void runDeferred();
+
+  uint64_t iterations() const {
+    return this->iterationCount;
+  }
+
+  /**
+   * Iterations in which critical consumers alone missed the deadline.
+   */
+  uint64_t missedDeadlines() const {
+    return this->missedDeadlineCount;
+  }
+
+  const std::map<std::string, DeferredWorkStats>& getStats() const {
+    return this->stats;
+  }
+
+  static const constexpr char* NAME = "PipelineScheduler";
+
+ protected:
+  struct DeferredWork {
+    std::string name;
+    lambda::function<void()> work;
+  };
+
+  /**
+   * Counts (and drops) all queued work as skipped.
+   */
+  void skipDeferred();
+
+  void logStats() const;
+
+  const Tag tag;
+  const double_t deadline;
+  const uint64_t maxConsecutiveSkips;
+  const uint64_t statsLogInterval;
+  const lambda::function<TimeFunction> now;
+
+  double_t iterationStart;
+  uint64_t iterationCount;
+  uint64_t missedDeadlineCount;
+  std::vector<DeferredWork> queue;
+  std::map<std::string, DeferredWorkStats> stats;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_PIPELINE_SCHEDULER_HPP
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "pipeline/shadow_pipelines.hpp"
+
+#include "serenity/wid.hpp"
+
+#include "stout/numify.hpp"
+#include "stout/strings.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+/**
+ * Parses override value. See createShadowQoSPipelineConfig.
+ */
+static Try<SerenityConfig::CfgVariant> parseOverrideValue(
+    const std::string& value) {
+  if (value == "true" || value == "false") {
+    return SerenityConfig::CfgVariant(value == "true");
+  }
+
+  if (value.empty() ||
+      value.find_first_not_of("0123456789.eE+-") != std::string::npos) {
+    return SerenityConfig::CfgVariant(value);
+  }
+
+  if (value.find_first_of(".eE") != std::string::npos) {
+    Try<double_t> number = numify<double_t>(value);
+    if (number.isError()) {
+      return Error(number.error());
+    }
+    return SerenityConfig::CfgVariant(number.get());
+  }
+
+  if (value[0] == '-') {
+    Try<int64_t> number = numify<int64_t>(value);
+    if (number.isError()) {
+      return Error(number.error());
+    }
+    return SerenityConfig::CfgVariant(number.get());
+  }
+
+  Try<uint64_t> number = numify<uint64_t>(value);
+  if (number.isError()) {
+    return Error(number.error());
+  }
+  return SerenityConfig::CfgVariant(number.get());
+}
+
+
+Try<SerenityConfig> createShadowQoSPipelineConfig(
+    const SerenityConfig& liveConf,
+    const std::string& overrides) {
+  SerenityConfig conf;
+  conf.applyConfig(liveConf);
+
+  for (const std::string& item : strings::tokenize(overrides, ",")) {
+    const std::string option = strings::trim(item);
+    const size_t separator = option.find('=');
+    if (separator == std::string::npos) {
+      return Error("Override '" + option + "' is not SECTION.KEY=value");
+    }
+
+    std::vector<std::string> path =
+      strings::tokenize(strings::trim(option.substr(0, separator)), ".");
+    if (path.empty()) {
+      return Error("Override '" + option + "' has no key");
+    }
+
+    Try<SerenityConfig::CfgVariant> value =
+      parseOverrideValue(strings::trim(option.substr(separator + 1)));
+    if (value.isError()) {
+      return Error("Override '" + option + "': " + value.error());
+    }
+
+    SerenityConfig* section = &conf;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+      section = &(*section)[path[i]];
+    }
+    section->setVariant(path.back(), value.get());
+  }
+
+  conf.set(qos_pipeline::SHADOW_MODE, true);
+
+  return conf;
+}
+
+
+/**
+ * Returns executors killed by given corrections.
+ */
+static std::list<WID> killedExecutors(const QoSCorrections& corrections) {
+  std::list<WID> executors;
+  for (const slave::QoSCorrection& correction : corrections) {
+    if (correction.has_kill()) {
+      executors.push_back(WID(correction.kill()));
+    }
+  }
+
+  return executors;
+}
+
+
+static bool contains(const std::list<WID>& executors, const WID& executor) {
+  return std::find(executors.begin(), executors.end(), executor) !=
+    executors.end();
+}
+
+
+void ShadowQoSPipelines::add(
+    const std::string& name,
+    std::shared_ptr<QoSControllerPipeline> pipeline) {
+  Shadow shadow;
+  shadow.name = name;
+  shadow.pipeline = pipeline;
+  this->shadows.push_back(shadow);
+}
+
+
+void ShadowQoSPipelines::run(
+    const ResourceUsage& usage,
+    const QoSCorrections& liveCorrections,
+    double_t liveCost) {
+  LiveIteration iteration;
+  iteration.usage = usage;
+  iteration.corrections = liveCorrections;
+  this->run(std::vector<LiveIteration>{iteration}, liveCost);
+}
+
+
+void ShadowQoSPipelines::run(
+    const std::vector<LiveIteration>& liveIterations,
+    double_t liveCost) {
+  if (this->shadows.empty()) {
+    return;
+  }
+
+  double_t remainingBudget = this->iterationBudget - liveCost;
+  for (const LiveIteration& iteration : liveIterations) {
+    const size_t first = this->nextShadow;
+    this->nextShadow = (this->nextShadow + 1) % this->shadows.size();
+
+    for (size_t i = 0; i < this->shadows.size(); i++) {
+      Shadow& shadow = this->shadows[(first + i) % this->shadows.size()];
+
+      if (remainingBudget <= 0 ||
+          shadow.stats.averageCost() > remainingBudget) {
+        shadow.stats.skipped++;
+        SERENITY_VLOG(1) << "Skipping " << shadow.name << " (budget left: "
+                         << remainingBudget << " s)";
+        continue;
+      }
+
+      const steady_clock::time_point start = steady_clock::now();
+      Result<QoSCorrections> result = shadow.pipeline->run(iteration.usage);
+      const double_t cost =
+        duration<double_t>(steady_clock::now() - start).count();
+
+      shadow.stats.iterations++;
+      shadow.stats.totalCost += cost;
+      shadow.stats.maxCost = std::max(shadow.stats.maxCost, cost);
+      remainingBudget -= cost;
+
+      if (result.isError()) {
+        SERENITY_LOG(ERROR) << shadow.name << ": " << result.error();
+        continue;
+      }
+
+      this->compare(
+          iteration.corrections,
+          result.isSome() ? result.get() : QoSCorrections(),
+          &shadow);
+    }
+  }
+
+  this->runs++;
+  if (this->statsLogInterval > 0 &&
+      this->runs % this->statsLogInterval == 0) {
+    this->logStats();
+  }
+}
+
+
+void ShadowQoSPipelines::logStats() const {
+  for (const Shadow& shadow : this->shadows) {
+    SERENITY_LOG(INFO) << shadow.name << ": "
+                       << shadow.stats.iterations << " iterations ("
+                       << shadow.stats.skipped << " skipped), "
+                       << shadow.stats.corrections << " corrections, "
+                       << shadow.stats.agreed << " agreed, "
+                       << shadow.stats.shadowOnly << " shadow only, "
+                       << shadow.stats.liveOnly << " live only kills. "
+                       << "Cost avg " << shadow.stats.averageCost()
+                       << " s, max " << shadow.stats.maxCost << " s";
+  }
+}
+
+
+void ShadowQoSPipelines::compare(
+    const QoSCorrections& liveCorrections,
+    const QoSCorrections& shadowCorrections,
+    Shadow* shadow) const {
+  const std::list<WID> live = killedExecutors(liveCorrections);
+  const std::list<WID> shadowed = killedExecutors(shadowCorrections);
+
+  uint64_t agreed = 0;
+  for (const WID& executor : shadowed) {
+    if (contains(live, executor)) {
+      agreed++;
+    }
+  }
+
+  uint64_t liveOnly = 0;
+  for (const WID& executor : live) {
+    if (!contains(shadowed, executor)) {
+      liveOnly++;
+    }
+  }
+
+  shadow->stats.corrections += shadowCorrections.size();
+  shadow->stats.agreed += agreed;
+  shadow->stats.shadowOnly += shadowed.size() - agreed;
+  shadow->stats.liveOnly += liveOnly;
+
+  if (agreed != shadowed.size() || liveOnly > 0) {
+    SERENITY_LOG(INFO) << shadow->name << " differs from live pipeline: "
+                       << "live " << live.size() << " kills, shadow "
+                       << shadowed.size() << " kills, agreed " << agreed;
+  }
+}
+
+}  // namespace serenity
+}  // namespace mesos
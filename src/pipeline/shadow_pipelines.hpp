@@ -0,0 +1,166 @@
+#ifndef SERENITY_SHADOW_PIPELINES_HPP
+#define SERENITY_SHADOW_PIPELINES_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "messages/serenity.hpp"
+
+#include "pipeline/qos_pipeline.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Comparison of shadow pipeline corrections with the live ones and cost
+ * of running it.
+ */
+struct ShadowPipelineStats {
+  ShadowPipelineStats()
+    : iterations(0),
+      skipped(0),
+      corrections(0),
+      agreed(0),
+      shadowOnly(0),
+      liveOnly(0),
+      totalCost(0),
+      maxCost(0) {}
+
+  double_t averageCost() const {
+    return iterations > 0 ? totalCost / iterations : 0;
+  }
+
+  uint64_t iterations;  //!< Iterations shadow pipeline was run.
+  uint64_t skipped;  //!< Iterations skipped because of exceeded budget.
+  uint64_t corrections;  //!< All corrections created by shadow pipeline.
+  uint64_t agreed;  //!< Corrections of the same executor as live pipeline.
+  uint64_t shadowOnly;  //!< Corrections which live pipeline did not make.
+  uint64_t liveOnly;  //!< Live corrections which shadow pipeline missed.
+  double_t totalCost;  //!< Seconds spent in shadow pipeline.
+  double_t maxCost;  //!< Longest shadow iteration in seconds.
+};
+
+
+/**
+ * Usage consumed by the live pipeline with corrections it made for it.
+ */
+struct LiveIteration {
+  ResourceUsage usage;
+  QoSCorrections corrections;
+};
+
+
+/**
+ * Creates configuration of shadow pipeline: live configuration with
+ * comma separated overrides applied and qos_pipeline::SHADOW_MODE set.
+ * Override has form of "SECTION.KEY=value" ("KEY=value" for top level
+ * options), e.g. "AssuranceDropAnalyzer.FRACTIONAL_THRESHOLD=0.2".
+ * Type of value is taken from its form: true/false are bools, numbers
+ * with '.' or exponent are doubles, other numbers are integers (uint64_t
+ * or int64_t when negative) and everything else is a string.
+ */
+Try<SerenityConfig> createShadowQoSPipelineConfig(
+    const SerenityConfig& liveConf,
+    const std::string& overrides);
+
+
+/**
+ * Runs additional QoS pipelines (e.g. with alternate SerenityConfig) on the
+ * same ResourceUsage as the live pipeline. Their corrections are never
+ * sent to the agent - they are only compared with the live ones, so new
+ * thresholds and analyzers can be evaluated in production.
+ *
+ * Shadow pipelines share time budget of one corrections call with the
+ * live pipeline (which can run several iterations in one call). Shadow
+ * pipeline is skipped for an iteration when its average cost does not fit
+ * into what is left of the budget. Start position rotates, so skipped
+ * iterations are spread between shadow pipelines.
+ *
+ * Stats of every shadow pipeline are logged every statsLogInterval runs.
+ *
+ * NOTE: Shadow pipelines should be created with qos_pipeline::SHADOW_MODE
+ * (see createShadowQoSPipelineConfig), so they do not spawn endpoints,
+ * publish events nor write files of the live pipeline.
+ */
+class ShadowQoSPipelines {
+ public:
+  explicit ShadowQoSPipelines(
+      double_t _iterationBudget = qos_pipeline::DEFAULT_ITERATION_BUDGET_SEC,
+      uint64_t _statsLogInterval =
+        qos_pipeline::DEFAULT_SHADOW_STATS_LOG_INTERVAL,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME))
+    : tag(_tag),
+      iterationBudget(_iterationBudget),
+      statsLogInterval(_statsLogInterval),
+      nextShadow(0),
+      runs(0) {}
+
+  void add(const std::string& name,
+           std::shared_ptr<QoSControllerPipeline> pipeline);
+
+  /**
+   * Runs shadow pipelines on usage consumed by the live pipeline and
+   * compares their corrections with the live ones.
+   * liveCost is time (in seconds) live pipeline spent in this iteration.
+   */
+  void run(const ResourceUsage& usage,
+           const QoSCorrections& liveCorrections,
+           double_t liveCost);
+
+  /**
+   * Runs shadow pipelines on all iterations of one corrections call.
+   * liveCost is time (in seconds) live pipeline spent in all of them.
+   */
+  void run(const std::vector<LiveIteration>& liveIterations,
+           double_t liveCost);
+
+  /**
+   * Logs comparisons and costs of every shadow pipeline.
+   */
+  void logStats() const;
+
+  size_t size() const {
+    return this->shadows.size();
+  }
+
+  const std::string& getName(size_t index) const {
+    return this->shadows[index].name;
+  }
+
+  const ShadowPipelineStats& getStats(size_t index) const {
+    return this->shadows[index].stats;
+  }
+
+  static const constexpr char* NAME = "ShadowQoSPipelines";
+
+ protected:
+  struct Shadow {
+    std::string name;
+    std::shared_ptr<QoSControllerPipeline> pipeline;
+    ShadowPipelineStats stats;
+  };
+
+  void compare(const QoSCorrections& liveCorrections,
+               const QoSCorrections& shadowCorrections,
+               Shadow* shadow) const;
+
+  const Tag tag;
+  const double_t iterationBudget;
+  const uint64_t statsLogInterval;
+
+  std::vector<Shadow> shadows;
+  size_t nextShadow;
+  uint64_t runs;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_SHADOW_PIPELINES_HPP
@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <string>
+
+#include "glog/logging.h"
+
+#include "serenity/aggressor_scores.hpp"
+
+namespace mesos {
+namespace serenity {
+
+AggressorScores::AggressorScores(
+    const SerenityConfig& _conf,
+    const lambda::function<WorkloadFunction>& _workloadFunction,
+    const Tag& _tag)
+  : tag(_tag),
+    evaluationWindow(AggressorScoresConfig(_conf).getU64(feedback::WINDOW)),
+    alpha(AggressorScoresConfig(_conf).getD(feedback::ALPHA)),
+    confidentScore(AggressorScoresConfig(_conf).getD(
+        feedback::CONFIDENT_SCORE)),
+    workloadFunction(_workloadFunction) {}
+
+
+void AggressorScores::update(
+    const ExecutorInfo& aggressor,
+    double_t effectiveness) {
+  effectiveness = std::min(1.0, std::max(-1.0, effectiveness));
+
+  const std::string workload = this->workloadFunction(aggressor);
+  double_t& score = this->scores[workload];
+  score += this->alpha * (effectiveness - score);
+
+  SERENITY_LOG(INFO) << "Revocation of '" << workload << "' was "
+                     << effectiveness << " effective. Aggressor score: "
+                     << score;
+}
+
+
+double_t AggressorScores::score(const ExecutorInfo& info) const {
+  auto score = this->scores.find(this->workloadFunction(info));
+  if (score == this->scores.end()) {
+    return 0.0;
+  }
+
+  return score->second;
+}
+
+}  // namespace serenity
+}  // namespace mesos
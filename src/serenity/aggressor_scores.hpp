@@ -0,0 +1,101 @@
+#ifndef SERENITY_AGGRESSOR_SCORES_HPP
+#define SERENITY_AGGRESSOR_SCORES_HPP
+
+#include <string>
+#include <unordered_map>
+
+#include "mesos/mesos.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+#include "serenity/workload_profile.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/option.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class AggressorScoresConfig : public SerenityConfig {
+ public:
+  AggressorScoresConfig() {
+    this->initDefaults();
+  }
+
+  explicit AggressorScoresConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! uint64_t
+    //! Iterations after correction used to evaluate its outcome.
+    this->fields[feedback::WINDOW] = feedback::DEFAULT_WINDOW;
+
+    //! double_t
+    //! Weight of new outcome in aggressor score.
+    this->fields[feedback::ALPHA] = feedback::DEFAULT_ALPHA;
+
+    //! double_t
+    //! Workloads with score above that are known aggressors - strategies
+    //! revoke them alone instead of a group of executors.
+    this->fields[feedback::CONFIDENT_SCORE] =
+      feedback::DEFAULT_CONFIDENT_SCORE;
+  }
+};
+
+
+/**
+ * Aggressor score of workloads (see executorWorkload) learned from
+ * outcomes of corrections: exponential moving average of effectiveness
+ * (in [-1, 1]) of revoking executors of the workload. Unknown workloads
+ * have neutral (zero) score.
+ *
+ * Scores are shared by QoSCorrectionObservers, which evaluate outcomes,
+ * and strategies, which rank possible aggressors with them.
+ */
+class AggressorScores {
+ public:
+  explicit AggressorScores(
+      const SerenityConfig& _conf = SerenityConfig(),
+      const lambda::function<WorkloadFunction>& _workloadFunction =
+        executorWorkload,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME));
+
+  /**
+   * Updates score of executor's workload with effectiveness of its
+   * revocation.
+   */
+  void update(const ExecutorInfo& aggressor, double_t effectiveness);
+
+  double_t score(const ExecutorInfo& info) const;
+
+  bool isConfident(const ExecutorInfo& info) const {
+    return this->score(info) >= this->confidentScore;
+  }
+
+  uint64_t window() const {
+    return this->evaluationWindow;
+  }
+
+  size_t size() const {
+    return this->scores.size();
+  }
+
+  static const constexpr char* NAME = "AggressorScores";
+
+ protected:
+  const Tag tag;
+  const uint64_t evaluationWindow;
+  const double_t alpha;
+  const double_t confidentScore;
+  const lambda::function<WorkloadFunction> workloadFunction;
+
+  std::unordered_map<std::string, double_t> scores;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_AGGRESSOR_SCORES_HPP
@@ -0,0 +1,133 @@
+#include <string>
+
+#include "glog/logging.h"
+
+#include "serenity/checkpoint.hpp"
+
+#include "stout/os.hpp"
+#include "stout/stringify.hpp"
+
+namespace mesos {
+namespace serenity {
+
+PipelineCheckpointer::PipelineCheckpointer(
+    const SerenityConfig& _conf,
+    std::shared_ptr<PipelineClock> _clock,
+    const Tag& _tag)
+  : tag(_tag),
+    path(CheckpointConfig(_conf).getS(checkpoint::PATH)),
+    interval(CheckpointConfig(_conf).getU64(checkpoint::INTERVAL)),
+    maxAge(CheckpointConfig(_conf).getD(checkpoint::MAX_AGE)),
+    clock(_clock),
+    iterations(0) {}
+
+
+void PipelineCheckpointer::add(
+    const std::string& name, Checkpointable* filter) {
+  this->filters.push_back(std::make_pair(name, filter));
+}
+
+
+Try<Nothing> PipelineCheckpointer::iteration() {
+  if (!this->isEnabled() || this->interval == 0) {
+    return Nothing();
+  }
+
+  this->iterations++;
+  if (this->iterations % this->interval != 0) {
+    return Nothing();
+  }
+
+  return this->save();
+}
+
+
+Try<Nothing> PipelineCheckpointer::save() {
+  if (!this->isEnabled()) {
+    return Error("Checkpoint path is not configured");
+  }
+
+  PipelineCheckpoint pipelineCheckpoint;
+  pipelineCheckpoint.set_timestamp(this->clock->now());
+  for (const auto& filter : this->filters) {
+    FilterCheckpoint* filterCheckpoint = pipelineCheckpoint.add_filters();
+    filterCheckpoint->set_name(filter.first);
+    filter.second->checkpoint(filterCheckpoint);
+  }
+
+  std::string serialized;
+  if (!pipelineCheckpoint.SerializeToString(&serialized)) {
+    return Error("Failed to serialize pipeline checkpoint");
+  }
+
+  // Write to temporary file first, so restart during write does not leave
+  // corrupted checkpoint.
+  const std::string temporaryPath = this->path + ".tmp";
+  Try<Nothing> write = os::write(temporaryPath, serialized);
+  if (write.isError()) {
+    return Error("Failed to write checkpoint '" + temporaryPath + "': " +
+                 write.error());
+  }
+
+  Try<Nothing> rename = os::rename(temporaryPath, this->path);
+  if (rename.isError()) {
+    return Error("Failed to rename checkpoint to '" + this->path + "': " +
+                 rename.error());
+  }
+
+  SERENITY_VLOG(1) << "Saved state of " << this->filters.size()
+                   << " filters to " << this->path;
+
+  return Nothing();
+}
+
+
+Try<Nothing> PipelineCheckpointer::restore() {
+  if (!this->isEnabled()) {
+    return Error("Checkpoint path is not configured");
+  }
+
+  if (!os::exists(this->path)) {
+    return Error("Checkpoint '" + this->path + "' does not exist");
+  }
+
+  Try<std::string> content = os::read(this->path);
+  if (content.isError()) {
+    return Error("Failed to read checkpoint '" + this->path + "': " +
+                 content.error());
+  }
+
+  PipelineCheckpoint pipelineCheckpoint;
+  if (!pipelineCheckpoint.ParseFromString(content.get())) {
+    return Error("Failed to parse checkpoint '" + this->path + "'");
+  }
+
+  const double_t age =
+    this->clock->now() - pipelineCheckpoint.timestamp();
+  if (age > this->maxAge) {
+    return Error("Checkpoint '" + this->path + "' is too old (" +
+                 stringify(age) + " s)");
+  }
+
+  for (const FilterCheckpoint& filterCheckpoint :
+         pipelineCheckpoint.filters()) {
+    for (const auto& filter : this->filters) {
+      if (filter.first != filterCheckpoint.name()) {
+        continue;
+      }
+
+      Try<Nothing> restored = filter.second->restore(filterCheckpoint);
+      if (restored.isError()) {
+        SERENITY_LOG(WARNING) << "Failed to restore " << filter.first
+                              << ": " << restored.error();
+      }
+    }
+  }
+
+  SERENITY_LOG(INFO) << "Restored pipeline state from " << this->path;
+
+  return Nothing();
+}
+
+}  // namespace serenity
+}  // namespace mesos
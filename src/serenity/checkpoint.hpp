@@ -0,0 +1,122 @@
+#ifndef SERENITY_CHECKPOINT_HPP
+#define SERENITY_CHECKPOINT_HPP
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "messages/serenity.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/nothing.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class CheckpointConfig : public SerenityConfig {
+ public:
+  CheckpointConfig() {
+    this->initDefaults();
+  }
+
+  explicit CheckpointConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Local file with pipeline state. Empty path disables checkpointing.
+    this->fields[checkpoint::PATH] = std::string(checkpoint::DEFAULT_PATH);
+
+    //! uint64_t
+    //! How often (in pipeline iterations) state is saved.
+    this->fields[checkpoint::INTERVAL] = checkpoint::DEFAULT_INTERVAL;
+
+    //! double_t
+    //! Checkpoints older than that (in seconds) are not restored, since
+    //! state of executors could change too much in the meantime.
+    this->fields[checkpoint::MAX_AGE] = checkpoint::DEFAULT_MAX_AGE;
+  }
+};
+
+
+/**
+ * Interface for filters which keep per executor state between iterations.
+ */
+class Checkpointable {
+ public:
+  virtual ~Checkpointable() {}
+
+  /**
+   * Fills checkpoint with current per executor state.
+   */
+  virtual void checkpoint(FilterCheckpoint* checkpoint) const = 0;
+
+  /**
+   * Replaces current state with the one from checkpoint.
+   */
+  virtual Try<Nothing> restore(const FilterCheckpoint& checkpoint) = 0;
+};
+
+
+/**
+ * Periodically saves state of registered filters to a local file and
+ * restores it on startup, so QoS protection resumes right after agent or
+ * module restart instead of waiting for filter windows to fill again.
+ *
+ * File is replaced atomically (written to temporary file and renamed).
+ */
+class PipelineCheckpointer {
+ public:
+  explicit PipelineCheckpointer(
+      const SerenityConfig& _conf = SerenityConfig(),
+      std::shared_ptr<PipelineClock> _clock = systemClock(),
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME));
+
+  /**
+   * Registers filter under unique name. Filter must outlive checkpointer.
+   */
+  void add(const std::string& name, Checkpointable* filter);
+
+  bool isEnabled() const {
+    return !this->path.empty();
+  }
+
+  /**
+   * Should be called after each pipeline iteration. Saves state every
+   * configured number of iterations.
+   */
+  Try<Nothing> iteration();
+
+  Try<Nothing> save();
+
+  /**
+   * Restores registered filters. Returns error when checkpoint cannot be
+   * read or is too old - in that case filters start cold.
+   */
+  Try<Nothing> restore();
+
+  static const constexpr char* NAME = "PipelineCheckpointer";
+
+ protected:
+  const Tag tag;
+  const std::string path;
+  const uint64_t interval;
+  const double_t maxAge;
+  std::shared_ptr<PipelineClock> clock;
+
+  uint64_t iterations;
+  std::list<std::pair<std::string, Checkpointable*>> filters;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_CHECKPOINT_HPP
@@ -0,0 +1,98 @@
+#ifndef SERENITY_CLOCK_HPP
+#define SERENITY_CLOCK_HPP
+
+#include <cmath>
+#include <ctime>
+#include <memory>
+
+#include "mesos/mesos.hpp"
+
+#include "stout/duration.hpp"
+#include "stout/os.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Source of time for filters and observers in the pipeline.
+ * Time is expressed in seconds since Epoch (same as usage timestamps).
+ *
+ * Pipelines share one clock between all their filters, so executor ages,
+ * new executor thresholds and controller retries use the same notion of
+ * time.
+ */
+class PipelineClock {
+ public:
+  virtual ~PipelineClock() {}
+
+  virtual double_t now() const = 0;
+
+  /**
+   * Waits given duration of pipeline time.
+   */
+  virtual void sleep(const Duration& duration) = 0;
+
+  /**
+   * Called by pipeline with each usage before it is passed to filters.
+   */
+  virtual void update(const ResourceUsage& usage) {}
+};
+
+
+/**
+ * Wall clock. Default for production pipelines.
+ */
+class SystemClock : public PipelineClock {
+ public:
+  double_t now() const override {
+    return time(NULL);
+  }
+
+  void sleep(const Duration& duration) override {
+    os::sleep(duration);
+  }
+};
+
+
+/**
+ * Clock driven by usage timestamps - time moves to the newest executor
+ * statistics timestamp seen by pipeline. It never moves backwards.
+ *
+ * Used for replaying recorded traces faster than real time: ages and
+ * thresholds are computed from trace timestamps and sleep does not block,
+ * since the next usage sample moves the clock.
+ */
+class UsageClock : public PipelineClock {
+ public:
+  explicit UsageClock(double_t _start = 0) : current(_start) {}
+
+  double_t now() const override {
+    return this->current;
+  }
+
+  void sleep(const Duration& duration) override {}
+
+  void update(const ResourceUsage& usage) override {
+    for (const ResourceUsage_Executor& executor : usage.executors()) {
+      if (executor.has_statistics() &&
+          executor.statistics().has_timestamp() &&
+          executor.statistics().timestamp() > this->current) {
+        this->current = executor.statistics().timestamp();
+      }
+    }
+  }
+
+ protected:
+  double_t current;
+};
+
+
+inline std::shared_ptr<PipelineClock> systemClock() {
+  static std::shared_ptr<PipelineClock> clock(new SystemClock());
+  return clock;
+}
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_CLOCK_HPP
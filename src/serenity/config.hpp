@@ -143,6 +143,19 @@ class SerenityConfig {
     this->fields[key] = value;
   }
 
+  /**
+   * Getter for double_t option without default value. None when the
+   * option is not set (or is not double_t).
+   */
+  Option<double_t> getOptionalD(std::string key) const {
+    Option<SerenityConfig::CfgVariant> value = this->getField(key);
+    if (value.isNone() || boost::get<double_t>(&value.get()) == nullptr) {
+      return None();
+    }
+
+    return boost::get<double_t>(value.get());
+  }
+
   bool hasKey(std::string key) {
     return fields.find(key) != fields.end();
   }
@@ -59,6 +59,12 @@ inline Try<double_t> getEmaIps(
 }
 
 
+inline Try<double_t> getMpki(
+    const ResourceUsage_Executor& currentExec) {
+  return CountMpki(currentExec);
+}
+
+
 inline Try<double_t> getCpuUsage(
     const ResourceUsage_Executor& currentExec) {
   Try<double_t> cpuUsage =
@@ -69,6 +75,12 @@ inline Try<double_t> getCpuUsage(
 }
 
 
+inline Try<double_t> getNetworkBandwidth(
+    const ResourceUsage_Executor& currentExec) {
+  return CountSampledNetworkBandwidth(currentExec);
+}
+
+
 /**
  * Currently we are saving EMA CpuUsage in net_tcp_time_wait_connections field
  * in ResourceUsage.
@@ -82,6 +94,69 @@ inline Try<double_t> getEmaCpuUsage(
 }
 
 
+/**
+ * LLC occupancy in bytes. It is read from resctrl monitoring groups by
+ * ResctrlFilter and currently saved in net_tcp_rtt_microsecs_p50 field
+ * in ResourceUsage. When Serenity is compiled with CMT_ENABLED, perf
+ * llc_occupancy is used if resctrl value is not present.
+ */
+inline Try<double_t> getLlcOccupancy(
+    const ResourceUsage_Executor& currentExec) {
+  if (currentExec.statistics().has_net_tcp_rtt_microsecs_p50())
+    return currentExec.statistics().net_tcp_rtt_microsecs_p50();
+
+#ifdef CMT_ENABLED
+  if (currentExec.statistics().has_perf() &&
+      currentExec.statistics().perf().has_llc_occupancy())
+    return (double_t) currentExec.statistics().perf().llc_occupancy();
+#endif
+
+  return Error("LLC occupancy is not filled");
+}
+
+
+/**
+ * Local memory bandwidth (bytes per second) from resctrl MBM counters.
+ * Currently we are saving it in net_tcp_rtt_microsecs_p90 field
+ * in ResourceUsage.
+ */
+inline Try<double_t> getMbmLocalBandwidth(
+    const ResourceUsage_Executor& currentExec) {
+  if (!currentExec.statistics().has_net_tcp_rtt_microsecs_p90())
+    return Error("MBM local bandwidth is not filled");
+
+  return currentExec.statistics().net_tcp_rtt_microsecs_p90();
+}
+
+
+/**
+ * Total memory bandwidth (bytes per second) from resctrl MBM counters.
+ * Currently we are saving it in net_tcp_rtt_microsecs_p95 field
+ * in ResourceUsage.
+ */
+inline Try<double_t> getMbmTotalBandwidth(
+    const ResourceUsage_Executor& currentExec) {
+  if (!currentExec.statistics().has_net_tcp_rtt_microsecs_p95())
+    return Error("MBM total bandwidth is not filled");
+
+  return currentExec.statistics().net_tcp_rtt_microsecs_p95();
+}
+
+
+/**
+ * Application SLO signal (higher is better) from TaskPerformance samples
+ * pushed by the task. It is attached by TaskPerformanceFilter and
+ * currently saved in net_tcp_rtt_microsecs_p99 field in ResourceUsage.
+ */
+inline Try<double_t> getSloSignal(
+    const ResourceUsage_Executor& currentExec) {
+  if (!currentExec.statistics().has_net_tcp_rtt_microsecs_p99())
+    return Error("SLO signal is not filled");
+
+  return currentExec.statistics().net_tcp_rtt_microsecs_p99();
+}
+
+
 //! Resource Usage setters.
 using SetterFunction = Try<Nothing>(
     const double_t value,
@@ -130,6 +205,62 @@ inline Try<Nothing> setEmaCpuUsage(
 }
 
 
+/**
+ * Currently we are saving LLC occupancy in net_tcp_rtt_microsecs_p50 field
+ * in ResourceUsage.
+ */
+inline Try<Nothing> setLlcOccupancy(
+    const double_t value,
+    ResourceUsage_Executor* outExec) {
+
+  outExec->mutable_statistics()->set_net_tcp_rtt_microsecs_p50(value);
+
+  return Nothing();
+}
+
+
+/**
+ * Currently we are saving MBM local bandwidth in net_tcp_rtt_microsecs_p90
+ * field in ResourceUsage.
+ */
+inline Try<Nothing> setMbmLocalBandwidth(
+    const double_t value,
+    ResourceUsage_Executor* outExec) {
+
+  outExec->mutable_statistics()->set_net_tcp_rtt_microsecs_p90(value);
+
+  return Nothing();
+}
+
+
+/**
+ * Currently we are saving MBM total bandwidth in net_tcp_rtt_microsecs_p95
+ * field in ResourceUsage.
+ */
+inline Try<Nothing> setMbmTotalBandwidth(
+    const double_t value,
+    ResourceUsage_Executor* outExec) {
+
+  outExec->mutable_statistics()->set_net_tcp_rtt_microsecs_p95(value);
+
+  return Nothing();
+}
+
+
+/**
+ * Currently we are saving SLO signal in net_tcp_rtt_microsecs_p99 field
+ * in ResourceUsage.
+ */
+inline Try<Nothing> setSloSignal(
+    const double_t value,
+    ResourceUsage_Executor* outExec) {
+
+  outExec->mutable_statistics()->set_net_tcp_rtt_microsecs_p99(value);
+
+  return Nothing();
+}
+
+
 }  // namespace usage
 }  // namespace serenity
 }  // namespace mesos
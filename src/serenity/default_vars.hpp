@@ -1,6 +1,7 @@
 #ifndef SERENITY_DEFAULT_VARS_HPP
 #define SERENITY_DEFAULT_VARS_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
 
@@ -12,9 +13,49 @@ const constexpr char* VALVE_OPENED = "VALVE_OPENED";
 constexpr bool DEFAULT_VALVE_OPENED = true;
 const constexpr char* ENABLED_VISUALISATION = "ENABLED_VISUALISATION";
 constexpr bool DEFAULT_ENABLED_VISUALISATION = true;
+//!< Time budget (live and shadow pipelines together) for one QoS
+//!< corrections call (all pipeline iterations it makes).
+constexpr double_t DEFAULT_ITERATION_BUDGET_SEC = 1.0;
+//!< Shadow pipeline stats are logged every that many corrections calls.
+constexpr uint64_t DEFAULT_SHADOW_STATS_LOG_INTERVAL = 100;
+//!< Detect interference from IPC, IPS, MPKI and CPU usage together.
+const constexpr char* MULTIVARIATE_INTERFERENCE = "MULTIVARIATE_INTERFERENCE";
+constexpr bool DEFAULT_MULTIVARIATE_INTERFERENCE = false;
+//!< Detect IPC drops on host (and socket) aggregate instead of executors.
+const constexpr char* AGGREGATED_IPC_DETECTION = "AGGREGATED_IPC_DETECTION";
+constexpr bool DEFAULT_AGGREGATED_IPC_DETECTION = false;
+//!< Learn aggressor scores from outcomes of corrections.
+const constexpr char* CORRECTION_FEEDBACK = "CORRECTION_FEEDBACK";
+constexpr bool DEFAULT_CORRECTION_FEEDBACK = false;
+//!< Revoke BE tasks when agent runs out of memory (see MemoryPressureDetector).
+const constexpr char* MEMORY_PRESSURE_DETECTION = "MEMORY_PRESSURE_DETECTION";
+constexpr bool DEFAULT_MEMORY_PRESSURE_DETECTION = false;
+//!< Revoke BE tasks saturating NIC (needs MAX_BANDWIDTH of the node).
+const constexpr char* NETWORK_BANDWIDTH_DETECTION =
+  "NETWORK_BANDWIDTH_DETECTION";
+constexpr bool DEFAULT_NETWORK_BANDWIDTH_DETECTION = false;
+//!< Pipeline only records its decisions - it has no endpoints and does not
+//!< publish events, write journal, checkpoints or profiles.
+const constexpr char* SHADOW_MODE = "SHADOW_MODE";
+constexpr bool DEFAULT_SHADOW_MODE = false;
 }  // namespace qos_pipeline
 
 
+namespace pipeline_scheduler {
+//!< Iteration deadline (in seconds). Best effort consumers (e.g. time series
+//!< exporters) are skipped when they would not finish before it.
+const constexpr char* DEADLINE = "ITERATION_DEADLINE";
+constexpr double_t DEFAULT_DEADLINE_SEC = 0.5;
+//!< Best effort consumer skipped that many times in a row is run regardless
+//!< of the deadline, so its cost estimate cannot starve it forever.
+const constexpr char* MAX_CONSECUTIVE_SKIPS = "MAX_CONSECUTIVE_SKIPS";
+constexpr uint64_t DEFAULT_MAX_CONSECUTIVE_SKIPS = 10;
+//!< Skipped work is summarized in log every that many iterations (0 - never).
+const constexpr char* STATS_LOG_INTERVAL = "STATS_LOG_INTERVAL";
+constexpr uint64_t DEFAULT_STATS_LOG_INTERVAL = 100;
+}  // namespace pipeline_scheduler
+
+
 namespace ema {
 /**
  * Alpha controls how long is the moving average period.
@@ -48,14 +89,200 @@ constexpr double_t DEFAULT_START_VALUE = 0.00001;
 
 const constexpr char* THRESHOLD = "THRESHOLD";
 constexpr double_t DEFAULT_UTILIZATION_THRESHOLD = 0.85;
+const constexpr char* PREDICTIVE = "PREDICTIVE";
+constexpr bool DEFAULT_PREDICTIVE = false;
+const constexpr char* TREND_WINDOW_SIZE = "TREND_WINDOW_SIZE";
+constexpr uint64_t DEFAULT_TREND_WINDOW_SIZE = 5;
+const constexpr char* PREDICTION_HORIZON = "PREDICTION_HORIZON";
+constexpr double_t DEFAULT_PREDICTION_HORIZON = 1.0;  // !< In iterations.
+
+//!< Maximum memory bandwidth of the node [bytes/s]. No default - memory
+//!< bandwidth detection is inactive until it is configured.
+const constexpr char* MAX_MEMORY_BANDWIDTH = "MAX_MEMORY_BANDWIDTH";
+const constexpr char* MEMORY_BANDWIDTH_THRESHOLD =
+  "MEMORY_BANDWIDTH_THRESHOLD";
+constexpr double_t DEFAULT_MEMORY_BANDWIDTH_THRESHOLD = 0.8;
+
+//!< Maximum network throughput of the node [bytes/s]. No default - it
+//!< must be configured for the node.
+const constexpr char* MAX_BANDWIDTH = "MAX_BANDWIDTH";
+const constexpr char* BANDWIDTH_THRESHOLD = "BANDWIDTH_THRESHOLD";
+constexpr double_t DEFAULT_BANDWIDTH_THRESHOLD = 0.8;
+
+const constexpr char* MEMORY_PRESSURE_THRESHOLD = "MEMORY_PRESSURE_THRESHOLD";
+constexpr double_t DEFAULT_MEMORY_PRESSURE_THRESHOLD = 0.9;
+const constexpr char* MEMORY_CACHE_WEIGHT = "MEMORY_CACHE_WEIGHT";
+constexpr double_t DEFAULT_MEMORY_CACHE_WEIGHT = 0.25;
+const constexpr char* CRITICAL_PRESSURE_SEVERITY =
+  "CRITICAL_PRESSURE_SEVERITY";
+constexpr double_t DEFAULT_CRITICAL_PRESSURE_SEVERITY = 0.05;
+
+//!< Squared Mahalanobis distance of anomalous sample.
+const constexpr char* MAHALANOBIS_THRESHOLD = "MAHALANOBIS_THRESHOLD";
+constexpr double_t DEFAULT_MAHALANOBIS_THRESHOLD = 16.0;
+//!< Weight of new sample in running mean and covariance.
+const constexpr char* MAHALANOBIS_ALPHA = "MAHALANOBIS_ALPHA";
+constexpr double_t DEFAULT_MAHALANOBIS_ALPHA = 0.05;
+const constexpr char* WARMUP_SAMPLES = "WARMUP_SAMPLES";
+constexpr uint64_t DEFAULT_WARMUP_SAMPLES = 10;
+//!< Number of anomalous samples in a row needed for contention.
+const constexpr char* CONSECUTIVE_SAMPLES = "CONSECUTIVE_SAMPLES";
+constexpr uint64_t DEFAULT_CONSECUTIVE_SAMPLES = 2;
+//!< Anomalous samples in a row after which baseline is learned again.
+const constexpr char* MAX_ANOMALOUS_SAMPLES = "MAX_ANOMALOUS_SAMPLES";
+constexpr uint64_t DEFAULT_MAX_ANOMALOUS_SAMPLES = 10;
+//!< Relative drop of executor signal below its reference to be a victim.
+const constexpr char* VICTIM_FRACTION = "VICTIM_FRACTION";
+constexpr double_t DEFAULT_VICTIM_FRACTION = 0.1;
+//!< Weight of new sample in executor reference signal.
+const constexpr char* REFERENCE_ALPHA = "REFERENCE_ALPHA";
+constexpr double_t DEFAULT_REFERENCE_ALPHA = 0.2;
 }  // namespace detector
 
+namespace slo {
+//!< Name of TaskPerformance sample used as SLO signal.
+const constexpr char* SAMPLE = "SLO_SAMPLE";
+const constexpr char* DEFAULT_SAMPLE = "latency";
+//!< Lower sample is better (e.g. latency) - signal is inverted then.
+const constexpr char* LOWER_IS_BETTER = "SLO_LOWER_IS_BETTER";
+constexpr bool DEFAULT_LOWER_IS_BETTER = true;
+//!< Samples older than that (in seconds) are ignored.
+const constexpr char* MAX_SAMPLE_AGE = "SLO_MAX_SAMPLE_AGE";
+constexpr double_t DEFAULT_MAX_SAMPLE_AGE = 30;
+//!< Serve HTTP endpoint where tasks push TaskPerformance samples.
+const constexpr char* ENDPOINT = "SLO_ENDPOINT";
+constexpr bool DEFAULT_ENDPOINT = false;
+//!< Configuration section of SLO signal drop analyzer in QoS pipeline.
+const constexpr char* ANALYZER_SECTION = "SloDropAnalyzer";
+}  // namespace slo
+
+namespace resctrl {
+const constexpr char* ROOT_PATH = "ROOT_PATH";
+const constexpr char* DEFAULT_ROOT_PATH = "/sys/fs/resctrl";
+}  // namespace resctrl
+
+namespace topology {
+//!< Root of sysfs with NUMA nodes (devices/system/node/node<N>/cpulist).
+const constexpr char* SYSFS_ROOT = "SYSFS_ROOT";
+const constexpr char* DEFAULT_SYSFS_ROOT = "/sys";
+//!< Cgroup cpuset hierarchy of executors. Empty disables socket mapping.
+const constexpr char* CPUSET_ROOT = "CPUSET_ROOT";
+const constexpr char* DEFAULT_CPUSET_ROOT = "/sys/fs/cgroup/cpuset/mesos";
+//!< What executor cgroups are named after: CONTAINER_ID (Mesos cgroups
+//!< isolators) or EXECUTOR_ID (custom setups).
+const constexpr char* CPUSET_GROUP = "CPUSET_GROUP";
+const constexpr char* CONTAINER_ID_GROUP = "CONTAINER_ID";
+const constexpr char* EXECUTOR_ID_GROUP = "EXECUTOR_ID";
+const constexpr char* DEFAULT_CPUSET_GROUP = CONTAINER_ID_GROUP;
+}  // namespace topology
+
+namespace checkpoint {
+//!< Local file with pipeline state. Empty disables checkpointing.
+const constexpr char* PATH = "CHECKPOINT_PATH";
+const constexpr char* DEFAULT_PATH = "";
+//!< How often (in pipeline iterations) state is saved.
+const constexpr char* INTERVAL = "CHECKPOINT_INTERVAL";
+constexpr uint64_t DEFAULT_INTERVAL = 10;
+//!< Checkpoints older than that (in seconds) are not restored.
+const constexpr char* MAX_AGE = "CHECKPOINT_MAX_AGE";
+constexpr double_t DEFAULT_MAX_AGE = 300;
+}  // namespace checkpoint
+
+namespace journal {
+//!< Local file with QoS decision journal. Empty disables journaling.
+const constexpr char* PATH = "JOURNAL_PATH";
+const constexpr char* DEFAULT_PATH = "";
+//!< Number of records kept in the ring before the oldest are overwritten.
+const constexpr char* CAPACITY = "JOURNAL_CAPACITY";
+constexpr uint64_t DEFAULT_CAPACITY = 4096;
+}  // namespace journal
+
+namespace workload_profile {
+//!< Local file with learned workload profiles. Empty disables profiles.
+const constexpr char* PATH = "PROFILE_PATH";
+const constexpr char* DEFAULT_PATH = "";
+//!< Weight of new sample in profile baseline and variance.
+const constexpr char* ALPHA = "PROFILE_ALPHA";
+constexpr double_t DEFAULT_ALPHA = 0.05;
+//!< Samples needed before profile is used to seed new executors.
+const constexpr char* MIN_SAMPLES = "PROFILE_MIN_SAMPLES";
+constexpr uint64_t DEFAULT_MIN_SAMPLES = 30;
+//!< Profiles with higher relative standard deviation are not used.
+const constexpr char* MAX_VARIATION = "PROFILE_MAX_VARIATION";
+constexpr double_t DEFAULT_MAX_VARIATION = 0.25;
+//!< How often (in pipeline iterations) profiles are saved.
+const constexpr char* SAVE_INTERVAL = "PROFILE_SAVE_INTERVAL";
+constexpr uint64_t DEFAULT_SAVE_INTERVAL = 60;
+}  // namespace workload_profile
+
+namespace feedback {
+//!< Iterations after correction used to evaluate its outcome.
+const constexpr char* WINDOW = "FEEDBACK_WINDOW";
+constexpr uint64_t DEFAULT_WINDOW = 5;
+//!< Weight of new outcome in aggressor score.
+const constexpr char* ALPHA = "FEEDBACK_ALPHA";
+constexpr double_t DEFAULT_ALPHA = 0.3;
+//!< Workloads with higher score are revoked alone.
+const constexpr char* CONFIDENT_SCORE = "CONFIDENT_AGGRESSOR_SCORE";
+constexpr double_t DEFAULT_CONFIDENT_SCORE = 0.5;
+}  // namespace feedback
+
+namespace estimator {
+//!< How often slack is estimated in background. Zero disables it.
+constexpr double_t DEFAULT_ESTIMATION_INTERVAL_SEC = 5;
+//!< Maximum age of cached slack served by oversubscribable().
+constexpr double_t DEFAULT_MAX_STALENESS_SEC = 15;
+
+//!< Estimate revocable memory next to CPU.
+const constexpr char* MEMORY_SLACK = "MEMORY_SLACK";
+constexpr bool DEFAULT_MEMORY_SLACK = false;
+}  // namespace estimator
+
 namespace slack_observer {
 constexpr double_t DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION = 0.8;
+//!< Maximum increase of slack scale per iteration after throttling.
+constexpr double_t DEFAULT_SLACK_SCALE_RECOVERY_STEP = 0.1;
+
+const constexpr char* MODE = "MODE";
+//!< Slack counted from last CPU usage sample.
+const constexpr char* INSTANTANEOUS_MODE = "INSTANTANEOUS";
+//!< Slack counted from high percentile of CPU usage over horizon.
+const constexpr char* PERCENTILE_MODE = "PERCENTILE";
+const constexpr char* DEFAULT_MODE = INSTANTANEOUS_MODE;
+
+const constexpr char* PERCENTILE = "PERCENTILE";
+constexpr double_t DEFAULT_PERCENTILE = 0.95;
+
+const constexpr char* HORIZON = "HORIZON";
+constexpr uint64_t DEFAULT_HORIZON = 60;  // !< In samples.
 }  // namespace slack_observer
 
+namespace memory_slack {
+const constexpr char* MAX_OVERSUBSCRIPTION_FRACTION =
+  "MAX_OVERSUBSCRIPTION_FRACTION";
+constexpr double_t DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION = 0.8;
+//!< Fraction of executor's memory limit never reported as slack.
+const constexpr char* SAFETY_MARGIN = "SAFETY_MARGIN";
+constexpr double_t DEFAULT_SAFETY_MARGIN = 0.1;
+}  // namespace memory_slack
+
+namespace quantile_sketch {
+constexpr double_t DEFAULT_RELATIVE_ACCURACY = 0.02;
+constexpr uint64_t DEFAULT_HORIZON = 60;  // !< In samples.
+constexpr size_t DEFAULT_MAX_BINS = 128;
+}  // namespace quantile_sketch
+
 namespace utilization {
 constexpr double_t DEFAULT_THRESHOLD = 0.95;
+//!< Oversubscription is enabled again below (threshold - hysteresis).
+const constexpr char* HYSTERESIS = "HYSTERESIS";
+constexpr double_t DEFAULT_HYSTERESIS = 0.1;
+//!< Minimum number of iterations between state transitions.
+const constexpr char* MIN_DWELL_ITERATIONS = "MIN_DWELL_ITERATIONS";
+constexpr uint64_t DEFAULT_MIN_DWELL_ITERATIONS = 3;
+//!< EMA alpha for utilization smoothing. 1.0 disables smoothing.
+const constexpr char* ALPHA = "ALPHA";
+constexpr double_t DEFAULT_ALPHA = 0.5;
 }  // namespace utilization
 
 
@@ -75,6 +302,8 @@ const constexpr char* DEFAULT_CPU_SEVERITY = "DEFAULT_CPU_SEVERITY";
 constexpr double_t DEFAULT_DEFAULT_CPU_SEVERITY = 1.0;
 static const constexpr char* STARTING_SEVERITY = "STARTING_SEVERITY";
 constexpr double_t DEFAULT_STARTING_SEVERITY = 0.1;
+//!< Slack scale published for contention is 1 - weight * severity.
+constexpr double_t DEFAULT_SLACK_SCALE_SEVERITY_WEIGHT = 2.0;
 }  // namespace strategy
 
 }  // namespace serenity
@@ -5,6 +5,8 @@
 
 #include <unordered_map>
 
+#include "mesos/mesos.hpp"
+
 namespace mesos {
 namespace serenity {
 
@@ -44,6 +46,29 @@ using ExecutorMap = std::unordered_map<ExecutorInfo,
                                        ExecutorInfoHasher,
                                        ExecutorInfoEquals>;
 
+
+/**
+ * Removes entries of executors which are not present in given usage
+ * (they ended), so per executor state does not grow without bound.
+ * NOTE: Usage should contain all executors of the agent - not the ones
+ * left after filtering (e.g. by TooLowUsageFilter).
+ */
+template <typename Type>
+void pruneExecutors(const ResourceUsage& usage, ExecutorMap<Type>* executors) {
+  ExecutorMap<bool> present;
+  for (const ResourceUsage_Executor& executor : usage.executors()) {
+    present[executor.executor_info()] = true;
+  }
+
+  for (auto entry = executors->begin(); entry != executors->end();) {
+    if (present.find(entry->first) == present.end()) {
+      entry = executors->erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+}
+
 }  // namespace serenity
 }  // namespace mesos
 
@@ -0,0 +1,311 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "serenity/journal.hpp"
+
+#include "stout/error.hpp"
+#include "stout/os.hpp"
+#include "stout/stringify.hpp"
+
+namespace mesos {
+namespace serenity {
+
+static const char JOURNAL_MAGIC[8] = "SRNJRNL";
+static constexpr uint32_t JOURNAL_VERSION = 1;
+
+constexpr size_t JournalContention::ID_LENGTH;
+constexpr size_t JournalRecord::SOURCE_LENGTH;
+constexpr size_t JournalRecord::MAX_CONTENTIONS;
+constexpr size_t JournalRecord::MAX_CORRECTIONS;
+
+
+struct DecisionJournal::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t capacity;
+  //! Sequence of the next record.
+  uint64_t next;
+};
+
+
+std::string JournalOutcomeString(JournalOutcome outcome) {
+  switch (outcome) {
+    case JournalOutcome::CONTENTIONS_GONE:
+      return "CONTENTIONS_GONE";
+    case JournalOutcome::COOLDOWN:
+      return "COOLDOWN";
+    case JournalOutcome::STRATEGY_ERROR:
+      return "STRATEGY_ERROR";
+    case JournalOutcome::NO_AGGRESSORS:
+      return "NO_AGGRESSORS";
+    case JournalOutcome::CORRECTED:
+      return "CORRECTED";
+  }
+  return "UNKNOWN";
+}
+
+
+// Copies string truncated to fixed, always terminated buffer.
+static void copyTruncated(const std::string& value, char* buffer, size_t size) {
+  size_t length = std::min(value.size(), size - 1);
+  memcpy(buffer, value.data(), length);
+  buffer[length] = '\0';
+}
+
+
+void JournalRecord::setSource(const std::string& _source) {
+  copyTruncated(_source, this->source, SOURCE_LENGTH);
+}
+
+
+void JournalRecord::addContention(const Contention& contention) {
+  if (this->contentionsCount >= MAX_CONTENTIONS) {
+    this->truncated = std::min(this->truncated + 1, UINT8_MAX);
+    return;
+  }
+
+  JournalContention& stored = this->contentions[this->contentionsCount++];
+  copyTruncated(contention.victim().executor_id().value(),
+                stored.victim,
+                JournalContention::ID_LENGTH);
+  stored.type = contention.type();
+  stored.severity = contention.severity();
+}
+
+
+void JournalRecord::addCorrection(const slave::QoSCorrection& correction) {
+  if (this->correctionsCount >= MAX_CORRECTIONS) {
+    this->truncated = std::min(this->truncated + 1, UINT8_MAX);
+    return;
+  }
+
+  copyTruncated(correction.kill().executor_id().value(),
+                this->corrections[this->correctionsCount++],
+                JournalContention::ID_LENGTH);
+}
+
+
+std::ostream& operator<<(std::ostream& stream, const JournalRecord& record) {
+  stream << "#" << record.sequence
+         << " t=" << std::fixed << record.timestamp
+         << " " << record.source
+         << " " << JournalOutcomeString(record.outcome)
+         << " cooldown=" << record.cooldown;
+  if (record.slackScale >= 0) {
+    stream << " slack_scale=" << record.slackScale;
+  }
+
+  stream << " contentions=[";
+  for (uint8_t i = 0; i < record.contentionsCount; i++) {
+    const JournalContention& contention = record.contentions[i];
+    stream << (i > 0 ? ", " : "")
+           << (Contention_Type_IsValid(contention.type)
+               ? Contention_Type_Name(
+                   static_cast<Contention_Type>(contention.type))
+               : stringify(contention.type))
+           << " " << contention.victim
+           << " severity=" << contention.severity;
+  }
+
+  stream << "] kills=[";
+  for (uint8_t i = 0; i < record.correctionsCount; i++) {
+    stream << (i > 0 ? ", " : "") << record.corrections[i];
+  }
+  stream << "]";
+
+  if (record.truncated > 0) {
+    stream << " (" << static_cast<uint32_t>(record.truncated)
+           << " more not recorded)";
+  }
+
+  return stream;
+}
+
+
+static size_t journalLength(uint64_t capacity) {
+  return sizeof(DecisionJournal::Header) + capacity * sizeof(JournalRecord);
+}
+
+
+Try<std::shared_ptr<DecisionJournal>> DecisionJournal::open(
+    const std::string& path,
+    uint64_t capacity,
+    std::shared_ptr<PipelineClock> clock) {
+  if (capacity == 0) {
+    return Error("Journal capacity must be positive");
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return ErrnoError("Failed to open journal '" + path + "'");
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    ::close(fd);
+    return ErrnoError("Failed to stat journal '" + path + "'");
+  }
+
+  const size_t length = journalLength(capacity);
+  const bool fresh = static_cast<size_t>(status.st_size) != length;
+  if (fresh && ftruncate(fd, length) != 0) {
+    ::close(fd);
+    return ErrnoError("Failed to resize journal '" + path + "'");
+  }
+
+  void* mapping =
+    mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    ::close(fd);
+    return ErrnoError("Failed to map journal '" + path + "'");
+  }
+
+  std::shared_ptr<DecisionJournal> journal(
+      new DecisionJournal(fd, mapping, length, clock));
+
+  Header* header = journal->header;
+  if (fresh ||
+      memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+      header->version != JOURNAL_VERSION ||
+      header->recordSize != sizeof(JournalRecord) ||
+      header->capacity != capacity) {
+    // Layout changed - start new journal.
+    memset(mapping, 0, length);
+    memcpy(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header->version = JOURNAL_VERSION;
+    header->recordSize = sizeof(JournalRecord);
+    header->capacity = capacity;
+    header->next = 0;
+  }
+
+  return journal;
+}
+
+
+Try<std::vector<JournalRecord>> DecisionJournal::read(
+    const std::string& path) {
+  Try<std::string> content = os::read(path);
+  if (content.isError()) {
+    return Error("Failed to read journal '" + path + "': " + content.error());
+  }
+
+  if (content.get().size() < sizeof(Header)) {
+    return Error("Journal '" + path + "' is too short");
+  }
+
+  Header header;
+  memcpy(&header, content.get().data(), sizeof(Header));
+  if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) {
+    return Error("'" + path + "' is not a decision journal");
+  }
+
+  if (header.version != JOURNAL_VERSION ||
+      header.recordSize != sizeof(JournalRecord)) {
+    return Error("Journal '" + path + "' has unsupported version " +
+                 stringify(header.version));
+  }
+
+  if (content.get().size() != journalLength(header.capacity)) {
+    return Error("Journal '" + path + "' is truncated");
+  }
+
+  const char* data = content.get().data() + sizeof(Header);
+  const uint64_t first =
+    header.next > header.capacity ? header.next - header.capacity : 0;
+
+  std::vector<JournalRecord> records;
+  records.reserve(header.next - first);
+  for (uint64_t sequence = first; sequence < header.next; sequence++) {
+    JournalRecord record;
+    memcpy(&record,
+           data + (sequence % header.capacity) * sizeof(JournalRecord),
+           sizeof(JournalRecord));
+
+    // Slot overwritten while journal was read.
+    if (record.sequence != sequence) {
+      continue;
+    }
+
+    records.push_back(record);
+  }
+
+  return records;
+}
+
+
+DecisionJournal::DecisionJournal(
+    int _fd,
+    void* _mapping,
+    size_t _length,
+    std::shared_ptr<PipelineClock> _clock)
+  : fd(_fd),
+    mapping(_mapping),
+    length(_length),
+    clock(_clock),
+    header(static_cast<Header*>(_mapping)),
+    records(reinterpret_cast<JournalRecord*>(
+        static_cast<char*>(_mapping) + sizeof(Header))) {}
+
+
+DecisionJournal::~DecisionJournal() {
+  munmap(this->mapping, this->length);
+  ::close(this->fd);
+}
+
+
+void DecisionJournal::append(JournalRecord* record) {
+  record->sequence = this->header->next;
+  record->timestamp = this->clock->now();
+
+  memcpy(&this->records[record->sequence % this->header->capacity],
+         record,
+         sizeof(JournalRecord));
+
+  // Publish record only after it is fully written.
+  this->header->next = record->sequence + 1;
+}
+
+
+uint64_t DecisionJournal::capacity() const {
+  return this->header->capacity;
+}
+
+
+uint64_t DecisionJournal::appended() const {
+  return this->header->next;
+}
+
+
+std::shared_ptr<DecisionJournal> createDecisionJournal(
+    const SerenityConfig& conf,
+    std::shared_ptr<PipelineClock> clock) {
+  JournalConfig journalConf(conf);
+  const std::string path = journalConf.getS(journal::PATH);
+  if (path.empty()) {
+    return nullptr;
+  }
+
+  Try<std::shared_ptr<DecisionJournal>> journal = DecisionJournal::open(
+      path, journalConf.getU64(journal::CAPACITY), clock);
+  if (journal.isError()) {
+    LOG(ERROR) << "[SerenityQoS] Decision journal disabled: "
+               << journal.error();
+    return nullptr;
+  }
+
+  return journal.get();
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,192 @@
+#ifndef SERENITY_JOURNAL_HPP
+#define SERENITY_JOURNAL_HPP
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mesos/slave/oversubscription.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class JournalConfig : public SerenityConfig {
+ public:
+  JournalConfig() {
+    this->initDefaults();
+  }
+
+  explicit JournalConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Local file with QoS decision journal. Empty path disables journal.
+    this->fields[journal::PATH] = std::string(journal::DEFAULT_PATH);
+
+    //! uint64_t
+    //! Number of records kept. Oldest records are overwritten.
+    this->fields[journal::CAPACITY] = journal::DEFAULT_CAPACITY;
+  }
+};
+
+
+/**
+ * What QoSCorrectionObserver did with contentions in given iteration.
+ */
+enum class JournalOutcome : uint8_t {
+  //! Contentions are gone - cooldown and slack scale were reset.
+  CONTENTIONS_GONE,
+  //! Contentions were ignored, because observer is in cooldown.
+  COOLDOWN,
+  STRATEGY_ERROR,
+  //! Strategy did not find aggressors, contentions passed further.
+  NO_AGGRESSORS,
+  CORRECTED
+};
+
+
+std::string JournalOutcomeString(JournalOutcome outcome);
+
+
+/**
+ * Contention as stored in journal. Victim is executor id, truncated to
+ * fit in the record.
+ */
+struct JournalContention {
+  static constexpr size_t ID_LENGTH = 40;
+
+  char victim[ID_LENGTH];
+  int32_t type;
+  double_t severity;
+};
+
+
+/**
+ * Fixed size, plain record of one QoSCorrectionObserver decision.
+ * Only first MAX_CONTENTIONS contentions and MAX_CORRECTIONS corrections
+ * are kept - the rest is counted in truncated.
+ *
+ * Value-initialize new records (JournalRecord record = JournalRecord();),
+ * so counters and unused fields are zeroed.
+ */
+struct JournalRecord {
+  static constexpr size_t SOURCE_LENGTH = 32;
+  static constexpr size_t MAX_CONTENTIONS = 4;
+  static constexpr size_t MAX_CORRECTIONS = 4;
+
+  void setSource(const std::string& source);
+
+  void addContention(const Contention& contention);
+
+  void addCorrection(const slave::QoSCorrection& correction);
+
+  //! Set by journal on append.
+  uint64_t sequence;
+  double_t timestamp;
+
+  char source[SOURCE_LENGTH];
+  JournalOutcome outcome;
+  uint8_t contentionsCount;
+  uint8_t correctionsCount;
+  //! Number of contentions and corrections which did not fit.
+  uint8_t truncated;
+  //! Iterations left until observer can revoke again.
+  uint32_t cooldown;
+  //! Slack scale published to estimator. Negative when none was published.
+  double_t slackScale;
+
+  JournalContention contentions[MAX_CONTENTIONS];
+  char corrections[MAX_CORRECTIONS][JournalContention::ID_LENGTH];
+};
+
+static_assert(std::is_pod<JournalRecord>::value,
+              "JournalRecord is copied directly to mapped file");
+
+
+std::ostream& operator<<(std::ostream& stream, const JournalRecord& record);
+
+
+/**
+ * Append-only ring of JournalRecords in memory mapped file. Records
+ * explain why QoS pipeline revoked (or did not revoke) executors at
+ * fraction of the cost of per executor log lines: appending is a copy to
+ * mapped memory, flushing is left to the kernel, so records survive
+ * crash of the agent (but not of the host).
+ *
+ * Reopening file with the same capacity continues the journal,
+ * otherwise the file is reinitialized.
+ *
+ * Journal is not synchronized - one file should be written by one pipeline.
+ */
+class DecisionJournal {
+ public:
+  static Try<std::shared_ptr<DecisionJournal>> open(
+      const std::string& path,
+      uint64_t capacity,
+      std::shared_ptr<PipelineClock> clock = systemClock());
+
+  /**
+   * Reads all valid records, from the oldest to the newest.
+   */
+  static Try<std::vector<JournalRecord>> read(const std::string& path);
+
+  ~DecisionJournal();
+
+  /**
+   * Sets sequence and timestamp of the record and stores it, overwriting
+   * the oldest record when journal is full.
+   */
+  void append(JournalRecord* record);
+
+  uint64_t capacity() const;
+
+  //! Number of records appended since journal file was created.
+  uint64_t appended() const;
+
+  static const constexpr char* NAME = "DecisionJournal";
+
+  //! File layout: Header followed by capacity of JournalRecords.
+  struct Header;
+
+ protected:
+  DecisionJournal(int _fd,
+                  void* _mapping,
+                  size_t _length,
+                  std::shared_ptr<PipelineClock> _clock);
+
+  const int fd;
+  void* mapping;
+  const size_t length;
+  std::shared_ptr<PipelineClock> clock;
+
+  Header* header;
+  JournalRecord* records;
+};
+
+
+/**
+ * Opens journal configured in given section. Returns nullptr when
+ * journal is disabled or cannot be opened (error is logged).
+ */
+std::shared_ptr<DecisionJournal> createDecisionJournal(
+    const SerenityConfig& conf,
+    std::shared_ptr<PipelineClock> clock = systemClock());
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_JOURNAL_HPP
@@ -0,0 +1,166 @@
+#ifndef SERENITY_LOGGING_HPP
+#define SERENITY_LOGGING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "stout/numify.hpp"
+#include "stout/strings.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace logging {
+
+/**
+ * Environment variable with per component verbosity, e.g.:
+ *   SERENITY_LOG_VERBOSITY="*=0,ipcEMAFilter=2,IPC detectorFilter=1"
+ * Component is the name given to Tag. '*' sets default verbosity.
+ */
+constexpr const char* VERBOSITY_ENV = "SERENITY_LOG_VERBOSITY";
+
+constexpr const char* DEFAULT_COMPONENT = "*";
+
+constexpr int DEFAULT_VERBOSITY = 0;
+
+
+/**
+ * Registry of per component verbosity levels. Each Tag keeps pointer to
+ * the level of its component, so checking verbosity in hot loops is one
+ * relaxed atomic load (no lookup, no string building).
+ */
+class VerbosityRegistry {
+ public:
+  static VerbosityRegistry& instance() {
+    static VerbosityRegistry registry;
+    return registry;
+  }
+
+  std::shared_ptr<std::atomic<int>> level(const std::string& component) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto level = levels.find(component);
+    if (level != levels.end()) {
+      return level->second;
+    }
+
+    auto defaultLevel = configured.find(DEFAULT_COMPONENT);
+    auto configuredLevel = configured.find(component);
+    int value = DEFAULT_VERBOSITY;
+    if (configuredLevel != configured.end()) {
+      value = configuredLevel->second;
+    } else if (defaultLevel != configured.end()) {
+      value = defaultLevel->second;
+    }
+
+    std::shared_ptr<std::atomic<int>> newLevel(new std::atomic<int>(value));
+    levels[component] = newLevel;
+    return newLevel;
+  }
+
+  /**
+   * Changes verbosity of the component at runtime.
+   */
+  void set(const std::string& component, int value) {
+    this->level(component)->store(value, std::memory_order_relaxed);
+  }
+
+ private:
+  VerbosityRegistry() {
+    const char* env = std::getenv(VERBOSITY_ENV);
+    if (env == nullptr) {
+      return;
+    }
+
+    for (const std::string& entry : strings::tokenize(env, ",")) {
+      std::vector<std::string> pair = strings::split(entry, "=");
+      if (pair.size() != 2) {
+        LOG(WARNING) << "[Serenity] Ignoring " << VERBOSITY_ENV
+                     << " entry: " << entry;
+        continue;
+      }
+
+      Try<int> value = numify<int>(strings::trim(pair[1]));
+      if (value.isError()) {
+        LOG(WARNING) << "[Serenity] Ignoring " << VERBOSITY_ENV
+                     << " entry: " << entry;
+        continue;
+      }
+
+      configured[strings::trim(pair[0])] = value.get();
+    }
+  }
+
+  std::mutex mutex;
+  std::unordered_map<std::string, int> configured;
+  std::unordered_map<std::string, std::shared_ptr<std::atomic<int>>> levels;
+};
+
+
+inline void setVerbosity(const std::string& component, int value) {
+  VerbosityRegistry::instance().set(component, value);
+}
+
+
+/**
+ * Returns true when at least `seconds` passed since the last accepted
+ * call for given call site state.
+ */
+inline bool rateLimit(std::atomic<int64_t>* lastLogNanos, double seconds) {
+  const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  int64_t last = lastLogNanos->load(std::memory_order_relaxed);
+
+  if (last != 0 && (now - last) < static_cast<int64_t>(seconds * 1e9)) {
+    return false;
+  }
+
+  // Only one thread wins the call site for this period.
+  return lastLogNanos->compare_exchange_strong(last, now);
+}
+
+}  // namespace logging
+}  // namespace serenity
+}  // namespace mesos
+
+
+/**
+ * All macros below expect `tag` (serenity::Tag) in scope. Arguments after
+ * `<<` are evaluated only when message is really logged.
+ */
+#define SERENITY_LOG(severity) LOG(severity) << tag.NAME()
+
+/**
+ * Logs at INFO only when component verbosity is >= level.
+ */
+#define SERENITY_VLOG(level) \
+  LOG_IF(INFO, tag.isVerbose(level)) << tag.NAME()
+
+/**
+ * Logs at most once per `seconds` for each call site.
+ */
+#define SERENITY_LOG_EVERY_N_SEC(severity, seconds)                       \
+  LOG_IF(severity, ::mesos::serenity::logging::rateLimit(                 \
+      []() -> std::atomic<int64_t>* {                                     \
+        static std::atomic<int64_t> lastLogNanos(0);                      \
+        return &lastLogNanos;                                             \
+      }(), seconds)) << tag.NAME()
+
+/**
+ * Debug logging is compiled out unless Serenity is built with
+ * SERENITY_DEBUG_LOGGING (cmake -DDEBUG_LOGGING=ON).
+ */
+#ifdef SERENITY_DEBUG_LOGGING
+#define SERENITY_DLOG(level) SERENITY_VLOG(level)
+#else
+#define SERENITY_DLOG(level) \
+  while (false) SERENITY_VLOG(level)
+#endif
+
+#endif  // SERENITY_LOGGING_HPP
@@ -1,6 +1,7 @@
 #ifndef SERENITY_MATH_UTILS_HPP
 #define SERENITY_MATH_UTILS_HPP
 
+#include <cmath>
 #include <limits>
 
 namespace mesos {
@@ -34,6 +35,39 @@ inline bool AlmostZero(
   return AlmostEq(lhs, 0.0, epsilon);
 }
 
+/**
+ * Fits least squares line to equally spaced samples (oldest first) and
+ * returns its value `steps` samples after the last one.
+ * For less than two samples it returns the last sample (or 0 for none).
+ */
+template <typename Container>
+inline double_t LinearForecast(const Container& samples, double_t steps) {
+  const double_t n = samples.size();
+  if (samples.size() < 2) {
+    return samples.empty() ? 0.0 : *samples.rbegin();
+  }
+
+  // Samples are at x = 0, 1, ..., n-1.
+  const double_t meanX = (n - 1) / 2.0;
+  double_t meanY = 0.0;
+  for (const double_t& value : samples) {
+    meanY += value;
+  }
+  meanY /= n;
+
+  double_t covariance = 0.0;
+  double_t varianceX = 0.0;
+  double_t x = 0.0;
+  for (const double_t& value : samples) {
+    covariance += (x - meanX) * (value - meanY);
+    varianceX += (x - meanX) * (x - meanX);
+    x += 1.0;
+  }
+
+  const double_t slope = covariance / varianceX;
+  return meanY + slope * ((n - 1 + steps) - meanX);
+}
+
 }  //  namespace utils
 }  //  namespace serenity
 }  //  namespace mesos
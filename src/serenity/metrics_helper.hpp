@@ -94,6 +94,32 @@ inline Try<double_t> CountSampledCpuUsage(
 }
 
 
+/**
+ * Network throughput (received and transmitted) [bytes/s] of executor.
+ * Statistics must be sampled by CumulativeFilter first.
+ */
+inline Try<double_t> CountSampledNetworkBandwidth(
+    const ResourceUsage_Executor& current) {
+  if (!current.has_statistics() ||
+      !current.statistics().has_timestamp() ||
+      (!current.statistics().has_net_rx_bytes() &&
+       !current.statistics().has_net_tx_bytes())) {
+    return Error("Cannot count network bandwidth, Parameter does not have "
+                   "required statistics");
+  }
+
+  double_t samplingDuration = current.statistics().timestamp();
+
+  if (samplingDuration == 0)
+    return 0;
+
+  double_t bytes = current.statistics().net_rx_bytes() +
+                   current.statistics().net_tx_bytes();
+
+  return bytes / samplingDuration;
+}
+
+
 inline Try<double_t> CountIpc(const ResourceUsage_Executor& current) {
   if (!current.has_statistics())
     return Error("Cannot count IPC, Parameter does not have required "
@@ -141,6 +167,29 @@ inline Try<double_t> CountIps(const ResourceUsage_Executor& current) {
   return instructionsPerSecond;
 }
 
+
+/**
+ * Last level cache misses per kilo instruction (MPKI).
+ */
+inline Try<double_t> CountMpki(const ResourceUsage_Executor& current) {
+  if (!current.has_statistics())
+    return Error("Cannot count MPKI, Parameter does not have required "
+                     "statistics");
+  if (!current.statistics().has_perf() ||
+      !current.statistics().perf().has_cache_misses() ||
+      !current.statistics().perf().has_instructions()) {
+    return Error("Cannot count MPKI, Parameter does not have required "
+                     "perf statistics");
+  }
+
+  double_t instructions = current.statistics().perf().instructions();
+  if (instructions == 0) {
+    return Error("Cannot count MPKI: 0 instructions.");
+  }
+
+  return current.statistics().perf().cache_misses() * 1000.0 / instructions;
+}
+
 }  // namespace serenity
 }  // namespace mesos
 
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <iterator>
+
+#include "serenity/quantile_sketch.hpp"
+
+namespace mesos {
+namespace serenity {
+
+QuantileSketch::QuantileSketch(
+    double_t _relativeAccuracy,
+    uint64_t _horizon,
+    size_t _maxBins)
+  : gamma((1 + _relativeAccuracy) / (1 - _relativeAccuracy)),
+    logGamma(std::log(gamma)),
+    decayFactor(_horizon > 0 ? 1.0 - (1.0 / _horizon) : 1.0),
+    maxBins(std::max<size_t>(_maxBins, 1)),
+    zeroWeight(0),
+    totalWeight(0) {}
+
+
+int32_t QuantileSketch::key(double_t value) const {
+  return static_cast<int32_t>(std::ceil(std::log(value) / logGamma));
+}
+
+
+double_t QuantileSketch::value(int32_t key) const {
+  // Middle of the bin (gamma^(key-1), gamma^key].
+  return 2 * std::pow(gamma, key) / (gamma + 1);
+}
+
+
+void QuantileSketch::decay() {
+  if (decayFactor >= 1.0) {
+    return;
+  }
+
+  zeroWeight *= decayFactor;
+  totalWeight *= decayFactor;
+
+  for (auto bin = bins.begin(); bin != bins.end();) {
+    bin->second *= decayFactor;
+    if (bin->second < MIN_BIN_WEIGHT) {
+      totalWeight -= bin->second;
+      bin = bins.erase(bin);
+    } else {
+      ++bin;
+    }
+  }
+}
+
+
+void QuantileSketch::collapse() {
+  while (bins.size() > maxBins) {
+    auto lowest = bins.begin();
+    auto next = std::next(lowest);
+    next->second += lowest->second;
+    bins.erase(lowest);
+  }
+}
+
+
+void QuantileSketch::add(double_t value) {
+  this->decay();
+
+  if (value < MIN_VALUE) {
+    zeroWeight += 1;
+  } else {
+    bins[this->key(value)] += 1;
+    this->collapse();
+  }
+
+  totalWeight += 1;
+}
+
+
+Option<double_t> QuantileSketch::quantile(double_t q) const {
+  if (totalWeight <= 0) {
+    return None();
+  }
+
+  const double_t rank = std::min(1.0, std::max(0.0, q)) * totalWeight;
+
+  double_t cumulative = zeroWeight;
+  if (cumulative >= rank && zeroWeight > 0) {
+    return 0.0;
+  }
+
+  for (const auto& bin : bins) {
+    cumulative += bin.second;
+    if (cumulative >= rank) {
+      return this->value(bin.first);
+    }
+  }
+
+  if (bins.empty()) {
+    return 0.0;
+  }
+
+  return this->value(bins.rbegin()->first);
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,80 @@
+#ifndef SERENITY_QUANTILE_SKETCH_HPP
+#define SERENITY_QUANTILE_SKETCH_HPP
+
+#include <cmath>
+#include <map>
+
+#include "serenity/default_vars.hpp"
+
+#include "stout/none.hpp"
+#include "stout/option.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Streaming quantile sketch with bounded memory.
+ *
+ * Values are kept in logarithmic bins (similar to DDSketch), so returned
+ * quantile is within relativeAccuracy of the real one. When number of bins
+ * exceeds maxBins, the lowest bins are collapsed - high quantiles stay
+ * accurate.
+ *
+ * To forget old samples, weights of all bins decay by (1 - 1/horizon)
+ * with every added value, so sketch approximates distribution of roughly
+ * last `horizon` samples. Zero horizon disables decay.
+ */
+class QuantileSketch {
+ public:
+  explicit QuantileSketch(
+      double_t _relativeAccuracy = quantile_sketch::DEFAULT_RELATIVE_ACCURACY,
+      uint64_t _horizon = quantile_sketch::DEFAULT_HORIZON,
+      size_t _maxBins = quantile_sketch::DEFAULT_MAX_BINS);
+
+  void add(double_t value);
+
+  /**
+   * Returns estimated q-quantile (q in [0, 1]) or None when sketch
+   * is empty.
+   */
+  Option<double_t> quantile(double_t q) const;
+
+  //! Total (decayed) weight of samples in sketch.
+  double_t weight() const {
+    return totalWeight;
+  }
+
+  size_t binsSize() const {
+    return bins.size();
+  }
+
+  //! Values below this are counted as zero.
+  static constexpr double_t MIN_VALUE = 1e-6;
+
+  //! Bins with lower weight are dropped.
+  static constexpr double_t MIN_BIN_WEIGHT = 1e-3;
+
+ protected:
+  int32_t key(double_t value) const;
+
+  double_t value(int32_t key) const;
+
+  void decay();
+
+  void collapse();
+
+  const double_t gamma;
+  const double_t logGamma;
+  const double_t decayFactor;
+  const size_t maxBins;
+
+  //! Bin key -> weight.
+  std::map<int32_t, double_t> bins;
+  double_t zeroWeight;
+  double_t totalWeight;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_QUANTILE_SKETCH_HPP
@@ -0,0 +1,115 @@
+#include <list>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "serenity/resctrl.hpp"
+
+#include "stout/numify.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+#include "stout/strings.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::string;
+
+static const string MON_FEATURES_PATH = "info/L3_MON/mon_features";
+static const string MON_GROUPS_DIR = "mon_groups";
+static const string MON_DATA_DIR = "mon_data";
+static const string L3_DOMAIN_PREFIX = "mon_L3_";
+
+
+/**
+ * Reads one counter file and adds its value to the sum.
+ * resctrl returns "Unavailable" or "Error" when counter cannot be read,
+ * in that case sum is not touched.
+ */
+static void addCounter(const string& path, Option<uint64_t>* sum) {
+  Try<string> content = os::read(path);
+  if (content.isError()) {
+    return;
+  }
+
+  Try<uint64_t> value = numify<uint64_t>(strings::trim(content.get()));
+  if (value.isError()) {
+    return;
+  }
+
+  *sum = (sum->isSome() ? sum->get() : 0) + value.get();
+}
+
+
+ResctrlMonitor::ResctrlMonitor(const string& _root)
+  : root(_root),
+    llcOccupancySupported(false),
+    mbmLocalSupported(false),
+    mbmTotalSupported(false) {
+  this->detectFeatures();
+}
+
+
+void ResctrlMonitor::detectFeatures() {
+  Try<string> features = os::read(path::join(root, MON_FEATURES_PATH));
+  if (features.isError()) {
+    LOG(INFO) << "[Serenity] ResctrlMonitor: monitoring is not available "
+              << "under " << root << ": " << features.error();
+    return;
+  }
+
+  for (const string& feature : strings::tokenize(features.get(), "\n")) {
+    const string trimmed = strings::trim(feature);
+    if (trimmed == LLC_OCCUPANCY) {
+      llcOccupancySupported = true;
+    } else if (trimmed == MBM_LOCAL_BYTES) {
+      mbmLocalSupported = true;
+    } else if (trimmed == MBM_TOTAL_BYTES) {
+      mbmTotalSupported = true;
+    }
+  }
+
+  LOG(INFO) << "[Serenity] ResctrlMonitor: detected features under " << root
+            << " [llc_occupancy: " << llcOccupancySupported
+            << ", mbm_local_bytes: " << mbmLocalSupported
+            << ", mbm_total_bytes: " << mbmTotalSupported << "]";
+}
+
+
+Try<ResctrlSample> ResctrlMonitor::read(const string& group) const {
+  const string monData =
+    path::join(root, MON_GROUPS_DIR, group, MON_DATA_DIR);
+
+  Try<std::list<string>> domains = os::ls(monData);
+  if (domains.isError()) {
+    return Error("Cannot list monitoring data for group '" + group +
+                 "': " + domains.error());
+  }
+
+  ResctrlSample sample;
+  for (const string& domain : domains.get()) {
+    if (!strings::startsWith(domain, L3_DOMAIN_PREFIX)) {
+      continue;
+    }
+
+    const string domainPath = path::join(monData, domain);
+    if (llcOccupancySupported) {
+      addCounter(path::join(domainPath, LLC_OCCUPANCY),
+                 &sample.llcOccupancy);
+    }
+    if (mbmLocalSupported) {
+      addCounter(path::join(domainPath, MBM_LOCAL_BYTES),
+                 &sample.mbmLocalBytes);
+    }
+    if (mbmTotalSupported) {
+      addCounter(path::join(domainPath, MBM_TOTAL_BYTES),
+                 &sample.mbmTotalBytes);
+    }
+  }
+
+  return sample;
+}
+
+}  // namespace serenity
+}  // namespace mesos
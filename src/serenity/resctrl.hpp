@@ -0,0 +1,87 @@
+#ifndef SERENITY_RESCTRL_HPP
+#define SERENITY_RESCTRL_HPP
+
+#include <string>
+
+#include "serenity/default_vars.hpp"
+
+#include "stout/none.hpp"
+#include "stout/option.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+/**
+ * Single read of resctrl monitoring counters for one monitoring group.
+ * Values are summed over all L3 domains (sockets).
+ * MBM values are cumulative byte counters.
+ */
+struct ResctrlSample {
+  ResctrlSample()
+    : llcOccupancy(None()),
+      mbmLocalBytes(None()),
+      mbmTotalBytes(None()) {}
+
+  Option<uint64_t> llcOccupancy;
+  Option<uint64_t> mbmLocalBytes;
+  Option<uint64_t> mbmTotalBytes;
+};
+
+
+/**
+ * Reads Intel RDT monitoring data (CMT & MBM) exposed by the kernel in
+ * resctrl filesystem:
+ *
+ *   <root>/info/L3_MON/mon_features
+ *   <root>/mon_groups/<group>/mon_data/mon_L3_<domain>/llc_occupancy
+ *   <root>/mon_groups/<group>/mon_data/mon_L3_<domain>/mbm_local_bytes
+ *   <root>/mon_groups/<group>/mon_data/mon_L3_<domain>/mbm_total_bytes
+ *
+ * Supported features are detected at runtime, so no special Mesos build
+ * is needed. Root is configurable for testing against a fake tree.
+ */
+class ResctrlMonitor {
+ public:
+  explicit ResctrlMonitor(
+      const std::string& _root = resctrl::DEFAULT_ROOT_PATH);
+
+  /**
+   * True when resctrl is mounted and exposes any monitoring feature.
+   */
+  bool isAvailable() const {
+    return llcOccupancySupported ||
+           mbmLocalSupported ||
+           mbmTotalSupported;
+  }
+
+  bool isLlcOccupancySupported() const { return llcOccupancySupported; }
+
+  bool isMbmLocalSupported() const { return mbmLocalSupported; }
+
+  bool isMbmTotalSupported() const { return mbmTotalSupported; }
+
+  /**
+   * Reads counters of given monitoring group.
+   * Returns error when group does not exist.
+   */
+  Try<ResctrlSample> read(const std::string& group) const;
+
+  static constexpr const char* LLC_OCCUPANCY = "llc_occupancy";
+  static constexpr const char* MBM_LOCAL_BYTES = "mbm_local_bytes";
+  static constexpr const char* MBM_TOTAL_BYTES = "mbm_total_bytes";
+
+ protected:
+  void detectFeatures();
+
+  const std::string root;
+
+  bool llcOccupancySupported;
+  bool mbmLocalSupported;
+  bool mbmTotalSupported;
+};
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_RESCTRL_HPP
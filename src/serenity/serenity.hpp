@@ -1,11 +1,16 @@
 #ifndef SERENITY_SERENITY_HPP
 #define SERENITY_SERENITY_HPP
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "glog/logging.h"
 
+#include "serenity/logging.hpp"
+
+#include "stout/lambda.hpp"
 #include "stout/nothing.hpp"
 #include "stout/try.hpp"
 
@@ -173,6 +178,19 @@ class Consumer : virtual public BaseFilter {
 };
 
 
+/**
+ * Work of best effort consumers is not done during produce, but handed
+ * to the queue, which decides if (and when) it is done.
+ */
+class DeferredWorkQueue {
+ public:
+  virtual ~DeferredWorkQueue() {}
+
+  virtual void defer(const std::string& name,
+                     const lambda::function<void()>& work) = 0;
+};
+
+
 template<typename T>
 class Producer : virtual public BaseFilter {
  public:
@@ -185,6 +203,25 @@ class Producer : virtual public BaseFilter {
     }
   }
 
+  /**
+   * Adds consumer which is not critical for the pipeline result (e.g.
+   * time series exporter). It consumes copy of the product after all
+   * critical consumers, when queue runs deferred work - or never, when
+   * queue skips it.
+   *
+   * NOTE: Best effort consumer must be a sink with only one producer.
+   */
+  void addBestEffortConsumer(Consumer<T>* consumer,
+                             DeferredWorkQueue* queue,
+                             const std::string& name) {
+    if (consumer != nullptr && queue != nullptr) {
+      bestEffortConsumers.push_back(BestEffortConsumer{consumer, queue, name});
+      consumer->registerProductForConsumption();
+    } else {
+      LOG(ERROR) << "Consumer and queue must not be null.";
+    }
+  }
+
  protected:
   Producer() {
     intialize();
@@ -197,20 +234,33 @@ class Producer : virtual public BaseFilter {
 
   virtual ~Producer() {}
 
-  Try<Nothing> produce(T out) {
+  Try<Nothing> produce(const T& out) {
     for (auto consumer : consumers) {
       consumer->_consume(out);
     }
+    for (const BestEffortConsumer& bestEffort : bestEffortConsumers) {
+      Consumer<T>* consumer = bestEffort.consumer;
+      bestEffort.queue->defer(bestEffort.name, [consumer, out]() {
+        consumer->_consume(out);
+      });
+    }
     BaseFilter::productProduced();
     return Nothing();
   }
 
  private:
+  struct BestEffortConsumer {
+    Consumer<T>* consumer;
+    DeferredWorkQueue* queue;
+    std::string name;
+  };
+
   void intialize() {
     BaseFilter::registerProducer();
   }
 
   std::vector<Consumer<T>*> consumers;
+  std::vector<BestEffortConsumer> bestEffortConsumers;
 };
 
 
@@ -220,34 +270,38 @@ enum ModuleType {
   UNDEFINED,
 };
 
-#define SERENITY_LOG(severity) LOG(severity) << tag.NAME()
-
 // TODO(skonefal): Tag class should overload operator <<
 class Tag {
  public:
   Tag(const ModuleType& _type, const std::string& _name)
-      : type(_type) {
-    this->name = getPrefix() + ": ";
-  }
+      : type(_type),
+        name(getPrefix(_type) + _name + ": "),
+        verbosity(logging::VerbosityRegistry::instance().level(_name)) {}
 
   explicit Tag(const std::string& _name)
-    : type(UNDEFINED) {
-    std::string prefix = getPrefix();
-    this->name = prefix + _name + ": ";
-  }
+    : type(UNDEFINED),
+      name(getPrefix(UNDEFINED) + _name + ": "),
+      verbosity(logging::VerbosityRegistry::instance().level(_name)) {}
 
-  const inline std::string NAME() const {
+  inline const std::string& NAME() const {
     return name;
   }
 
+  /**
+   * True when verbosity of the component is at least given level.
+   */
+  inline bool isVerbose(int level) const {
+    return verbosity->load(std::memory_order_relaxed) >= level;
+  }
+
   const inline ModuleType TYPE() const {
     return type;
   }
 
  private:
-  const std::string getPrefix() {
+  static std::string getPrefix(const ModuleType& type) {
     std::string prefix;
-    switch (this->type) {
+    switch (type) {
       case RESOURCE_ESTIMATOR:
         prefix = "[SerenityEstimator] ";;
         break;
@@ -264,6 +318,7 @@ class Tag {
 
   const ModuleType type;
   std::string name;
+  std::shared_ptr<std::atomic<int>> verbosity;
 };
 
 }  // namespace serenity
@@ -0,0 +1,220 @@
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "serenity/topology.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/numify.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+#include "stout/strings.hpp"
+
+namespace mesos {
+namespace serenity {
+
+using std::list;
+using std::set;
+using std::string;
+using std::vector;
+
+static const string NODES_PATH = "devices/system/node";
+static const string NODE_PREFIX = "node";
+static const string NODE_CPULIST = "cpulist";
+
+
+Try<set<uint32_t>> parseCpuList(const string& cpuList) {
+  set<uint32_t> cpus;
+  for (const string& range : strings::tokenize(strings::trim(cpuList), ",")) {
+    vector<string> bounds = strings::tokenize(range, "-");
+    if (bounds.empty() || bounds.size() > 2) {
+      return Error("Malformed cpu list '" + cpuList + "'");
+    }
+
+    Try<uint32_t> first = numify<uint32_t>(strings::trim(bounds.front()));
+    Try<uint32_t> last = numify<uint32_t>(strings::trim(bounds.back()));
+    if (first.isError() || last.isError() || first.get() > last.get()) {
+      return Error("Malformed cpu list '" + cpuList + "'");
+    }
+
+    for (uint32_t cpu = first.get(); cpu <= last.get(); cpu++) {
+      cpus.insert(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+
+NumaTopology::NumaTopology(const string& _root) {
+  const string nodesPath = path::join(_root, NODES_PATH);
+  Try<list<string>> entries = os::ls(nodesPath);
+  if (entries.isError()) {
+    LOG(INFO) << "[Serenity] NumaTopology: NUMA nodes are not available "
+              << "under " << nodesPath << ": " << entries.error();
+    return;
+  }
+
+  for (const string& entry : entries.get()) {
+    if (!strings::startsWith(entry, NODE_PREFIX)) {
+      continue;
+    }
+
+    Try<uint32_t> node = numify<uint32_t>(entry.substr(NODE_PREFIX.size()));
+    if (node.isError()) {
+      continue;
+    }
+
+    Try<string> cpuList = os::read(path::join(nodesPath, entry, NODE_CPULIST));
+    if (cpuList.isError()) {
+      continue;
+    }
+
+    Try<set<uint32_t>> cpus = parseCpuList(cpuList.get());
+    if (cpus.isError()) {
+      LOG(ERROR) << "[Serenity] NumaTopology: " << cpus.error();
+      continue;
+    }
+
+    this->nodes[node.get()] = cpus.get();
+  }
+
+  LOG(INFO) << "[Serenity] NumaTopology: detected " << this->nodes.size()
+            << " NUMA node(s) under " << nodesPath;
+}
+
+
+Option<uint32_t> NumaTopology::socket(const set<uint32_t>& cpus) const {
+  if (cpus.empty()) {
+    return None();
+  }
+
+  for (const auto& node : this->nodes) {
+    bool contains = true;
+    for (uint32_t cpu : cpus) {
+      if (node.second.count(cpu) == 0) {
+        contains = false;
+        break;
+      }
+    }
+
+    if (contains) {
+      return node.first;
+    }
+  }
+
+  return None();
+}
+
+
+ExecutorSocketMapper::ExecutorSocketMapper(const SerenityConfig& _conf)
+  : cpusetRoot(ExecutorSocketMapperConfig(_conf).getS(topology::CPUSET_ROOT)),
+    numaTopology(ExecutorSocketMapperConfig(_conf).getS(topology::SYSFS_ROOT)),
+    groupFunction(containerIdCpusetGroup),
+    sockets(new std::map<string, Option<uint32_t>>()) {
+  const string group =
+    ExecutorSocketMapperConfig(_conf).getS(topology::CPUSET_GROUP);
+  if (group == topology::EXECUTOR_ID_GROUP) {
+    this->groupFunction = executorIdCpusetGroup;
+  } else if (group != topology::CONTAINER_ID_GROUP) {
+    LOG(ERROR) << "[Serenity] " << NAME << ": unknown "
+               << topology::CPUSET_GROUP << " '" << group << "'. Using "
+               << topology::CONTAINER_ID_GROUP;
+  }
+}
+
+
+Option<uint32_t> ExecutorSocketMapper::operator()(
+    const ResourceUsage_Executor& executor) const {
+  if (!this->isAvailable()) {
+    return None();
+  }
+
+  Option<string> group = this->groupFunction(executor);
+  if (group.isNone()) {
+    return None();
+  }
+
+  auto cached = this->sockets->find(group.get());
+  if (cached != this->sockets->end()) {
+    return cached->second;
+  }
+
+  Option<uint32_t> socket = this->readSocket(group.get());
+  this->sockets->insert(std::make_pair(group.get(), socket));
+  return socket;
+}
+
+
+Option<uint32_t> ExecutorSocketMapper::readSocket(const string& group) const {
+  Try<string> cpuList = os::read(path::join(
+      this->cpusetRoot,
+      group,
+      CPUSET_CPUS));
+  if (cpuList.isError()) {
+    return None();
+  }
+
+  Try<set<uint32_t>> cpus = parseCpuList(cpuList.get());
+  if (cpus.isError()) {
+    LOG(ERROR) << "[Serenity] " << NAME << ": " << cpus.error();
+    return None();
+  }
+
+  return this->numaTopology.socket(cpus.get());
+}
+
+
+list<ResourceUsage_Executor> colocatedExecutors(
+    const list<ResourceUsage_Executor>& executors,
+    const Contentions& contentions,
+    const ResourceUsage& usage,
+    const lambda::function<SocketFunction>& getSocket) {
+  set<uint32_t> contendedSockets;
+  for (const Contention& contention : contentions) {
+    if (contention.has_socket()) {
+      contendedSockets.insert(contention.socket());
+      continue;
+    }
+
+    Option<uint32_t> victimSocket = None();
+    if (contention.has_victim()) {
+      const WID victim(contention.victim());
+      for (const ResourceUsage_Executor& executor : usage.executors()) {
+        if (WID(executor.executor_info()) == victim) {
+          victimSocket = getSocket(executor);
+          break;
+        }
+      }
+    }
+
+    if (victimSocket.isNone()) {
+      // Contention of the whole host.
+      return executors;
+    }
+
+    contendedSockets.insert(victimSocket.get());
+  }
+
+  if (contendedSockets.empty()) {
+    return executors;
+  }
+
+  list<ResourceUsage_Executor> product;
+  for (const ResourceUsage_Executor& executor : executors) {
+    Option<uint32_t> socket = getSocket(executor);
+    if (socket.isNone() || contendedSockets.count(socket.get()) > 0) {
+      product.push_back(executor);
+    }
+  }
+
+  return product;
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,184 @@
+#ifndef SERENITY_TOPOLOGY_HPP
+#define SERENITY_TOPOLOGY_HPP
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/none.hpp"
+#include "stout/option.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class ExecutorSocketMapperConfig : public SerenityConfig {
+ public:
+  ExecutorSocketMapperConfig() {
+    this->initDefaults();
+  }
+
+  explicit ExecutorSocketMapperConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Root of sysfs, where NUMA nodes are listed.
+    this->fields[topology::SYSFS_ROOT] =
+      std::string(topology::DEFAULT_SYSFS_ROOT);
+
+    //! string
+    //! Cgroup cpuset hierarchy with cgroups of executors. Empty path
+    //! disables socket mapping.
+    this->fields[topology::CPUSET_ROOT] =
+      std::string(topology::DEFAULT_CPUSET_ROOT);
+
+    //! string
+    //! CONTAINER_ID: cgroups are named after container id of executor
+    //! (as created by Mesos cgroups isolators).
+    //! EXECUTOR_ID: cgroups are named after executor id.
+    this->fields[topology::CPUSET_GROUP] =
+      std::string(topology::DEFAULT_CPUSET_GROUP);
+  }
+};
+
+
+/**
+ * Returns socket (NUMA node) which executor runs on, if it is known.
+ */
+using SocketFunction = Option<uint32_t>(const ResourceUsage_Executor& executor);
+
+inline Option<uint32_t> unknownSocket(const ResourceUsage_Executor& executor) {
+  return None();
+}
+
+
+/**
+ * Parses kernel cpu list format (e.g. "0-3,8,10-11").
+ */
+Try<std::set<uint32_t>> parseCpuList(const std::string& cpuList);
+
+
+/**
+ * CPUs of each NUMA node, read from sysfs:
+ *
+ *   <root>/devices/system/node/node<N>/cpulist
+ *
+ * Root is configurable for testing against a fake tree.
+ */
+class NumaTopology {
+ public:
+  explicit NumaTopology(
+      const std::string& _root = topology::DEFAULT_SYSFS_ROOT);
+
+  size_t sockets() const {
+    return this->nodes.size();
+  }
+
+  /**
+   * Returns the node which contains all given CPUs. CPUs spanning more
+   * than one node do not belong to any socket.
+   */
+  Option<uint32_t> socket(const std::set<uint32_t>& cpus) const;
+
+ protected:
+  std::map<uint32_t, std::set<uint32_t>> nodes;
+};
+
+
+/**
+ * Maps executor to the name of its cgroup in cpuset hierarchy, if it is
+ * known.
+ */
+using CpusetGroupFunction =
+  Option<std::string>(const ResourceUsage_Executor& executor);
+
+/**
+ * Mesos cgroups isolators name cgroups after container id.
+ */
+inline Option<std::string> containerIdCpusetGroup(
+    const ResourceUsage_Executor& executor) {
+  if (!executor.has_container_id()) {
+    return None();
+  }
+  return executor.container_id().value();
+}
+
+inline Option<std::string> executorIdCpusetGroup(
+    const ResourceUsage_Executor& executor) {
+  return executor.executor_info().executor_id().value();
+}
+
+
+/**
+ * Maps executor to socket using CPUs allowed in its cgroup cpuset:
+ *
+ *   <cpuset root>/<group>/cpuset.cpus
+ *
+ * Group is container id or executor id of the executor (CPUSET_GROUP).
+ * Executors without cpuset cgroup, or allowed to run on more than one
+ * socket, have unknown socket. It can be used as SocketFunction.
+ *
+ * Sockets are cached (in cache shared by copies of the mapper), so cpuset
+ * of an executor is read once per iteration - call clearCache() when new
+ * iteration starts.
+ */
+class ExecutorSocketMapper {
+ public:
+  explicit ExecutorSocketMapper(
+      const SerenityConfig& _conf = SerenityConfig());
+
+  Option<uint32_t> operator()(const ResourceUsage_Executor& executor) const;
+
+  bool isAvailable() const {
+    return !this->cpusetRoot.empty() && this->numaTopology.sockets() > 1;
+  }
+
+  void clearCache() {
+    this->sockets->clear();
+  }
+
+  static const constexpr char* NAME = "ExecutorSocketMapper";
+  static const constexpr char* CPUSET_CPUS = "cpuset.cpus";
+
+ protected:
+  Option<uint32_t> readSocket(const std::string& group) const;
+
+  const std::string cpusetRoot;
+  const NumaTopology numaTopology;
+  lambda::function<CpusetGroupFunction> groupFunction;
+
+  //! Sockets of cgroups read in current iteration.
+  std::shared_ptr<std::map<std::string, Option<uint32_t>>> sockets;
+};
+
+
+/**
+ * Returns executors which could cause given contentions: the ones on the
+ * socket of contention (or of its victim) and the ones with unknown
+ * socket. When socket of any contention is not known, all executors are
+ * returned.
+ */
+std::list<ResourceUsage_Executor> colocatedExecutors(
+    const std::list<ResourceUsage_Executor>& executors,
+    const Contentions& contentions,
+    const ResourceUsage& usage,
+    const lambda::function<SocketFunction>& getSocket);
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_TOPOLOGY_HPP
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "glog/logging.h"
+
+#include "serenity/workload_profile.hpp"
+
+#include "stout/os.hpp"
+#include "stout/stringify.hpp"
+
+namespace mesos {
+namespace serenity {
+
+static const char COMMAND_EXECUTOR_TASK[] = "(Task: ";
+
+
+std::string executorWorkload(const ExecutorInfo& info) {
+  std::string workload = info.framework_id().value() + "/";
+  if (!info.name().empty()) {
+    std::string name = info.name();
+    // Command executor name includes unique task id, e.g.
+    // "Command Executor (Task: id) (Command: sh -c 'app')".
+    const size_t task = name.find(COMMAND_EXECUTOR_TASK);
+    if (task != std::string::npos) {
+      const size_t end = name.find(") ", task);
+      name.erase(task, end == std::string::npos ? end : end + 2 - task);
+    }
+    return workload + name;
+  }
+
+  if (info.has_command() && !info.command().value().empty()) {
+    return workload + info.command().value();
+  }
+
+  return workload + info.executor_id().value();
+}
+
+
+// Exponentially weighted mean and variance. Plain average is used for first
+// samples, so they are not neglected.
+static void learnSignal(double_t sample,
+                        double_t alpha,
+                        uint64_t samples,
+                        double_t* mean,
+                        double_t* variance) {
+  if (samples == 0) {
+    *mean = sample;
+    *variance = 0;
+    return;
+  }
+
+  alpha = std::max(alpha, 1.0 / (samples + 1));
+  const double_t diff = sample - *mean;
+  *mean += alpha * diff;
+  *variance = (1.0 - alpha) * (*variance + alpha * diff * diff);
+}
+
+
+WorkloadProfileStore::WorkloadProfileStore(
+    const SerenityConfig& _conf,
+    const lambda::function<WorkloadFunction>& _workloadFunction,
+    const Tag& _tag)
+  : tag(_tag),
+    path(WorkloadProfileConfig(_conf).getS(workload_profile::PATH)),
+    alpha(WorkloadProfileConfig(_conf).getD(workload_profile::ALPHA)),
+    minSamples(WorkloadProfileConfig(_conf).getU64(
+        workload_profile::MIN_SAMPLES)),
+    maxVariation(WorkloadProfileConfig(_conf).getD(
+        workload_profile::MAX_VARIATION)),
+    workloadFunction(_workloadFunction) {}
+
+
+void WorkloadProfileStore::learn(
+    const ExecutorInfo& info,
+    double_t ipc,
+    double_t cpuUsage,
+    double_t timestamp) {
+  const std::string workload = this->workloadFunction(info);
+  WorkloadProfile& profile = this->profiles[workload];
+  profile.set_workload(workload);
+
+  double_t mean = profile.ipc();
+  double_t variance = profile.ipc_variance();
+  learnSignal(ipc, this->alpha, profile.samples(), &mean, &variance);
+  profile.set_ipc(mean);
+  profile.set_ipc_variance(variance);
+
+  mean = profile.cpu_usage();
+  variance = profile.cpu_usage_variance();
+  learnSignal(cpuUsage, this->alpha, profile.samples(), &mean, &variance);
+  profile.set_cpu_usage(mean);
+  profile.set_cpu_usage_variance(variance);
+
+  profile.set_samples(profile.samples() + 1);
+  profile.set_timestamp(timestamp);
+}
+
+
+Option<WorkloadProfile> WorkloadProfileStore::get(
+    const ExecutorInfo& info) const {
+  auto profile = this->profiles.find(this->workloadFunction(info));
+  if (profile == this->profiles.end()) {
+    return None();
+  }
+
+  return profile->second;
+}
+
+
+Option<double_t> WorkloadProfileStore::baseline(
+    const ExecutorInfo& info,
+    ProfileSignal signal) const {
+  auto found = this->profiles.find(this->workloadFunction(info));
+  if (found == this->profiles.end()) {
+    return None();
+  }
+
+  const WorkloadProfile& profile = found->second;
+  if (profile.samples() < this->minSamples) {
+    return None();
+  }
+
+  double_t mean = profile.ipc();
+  double_t variance = profile.ipc_variance();
+  if (signal == ProfileSignal::CPU_USAGE) {
+    mean = profile.cpu_usage();
+    variance = profile.cpu_usage_variance();
+  }
+
+  if (mean <= 0 || std::sqrt(variance) / mean > this->maxVariation) {
+    SERENITY_VLOG(1) << "Profile of " << profile.workload()
+                     << " is too noisy to be used";
+    return None();
+  }
+
+  return mean;
+}
+
+
+Try<Nothing> WorkloadProfileStore::save() const {
+  if (!this->isEnabled()) {
+    return Error("Profile path is not configured");
+  }
+
+  WorkloadProfiles workloadProfiles;
+  for (const auto& profile : this->profiles) {
+    workloadProfiles.add_profiles()->CopyFrom(profile.second);
+  }
+
+  std::string serialized;
+  if (!workloadProfiles.SerializeToString(&serialized)) {
+    return Error("Failed to serialize workload profiles");
+  }
+
+  const std::string temporaryPath = this->path + ".tmp";
+  Try<Nothing> write = os::write(temporaryPath, serialized);
+  if (write.isError()) {
+    return Error("Failed to write profiles '" + temporaryPath + "': " +
+                 write.error());
+  }
+
+  Try<Nothing> rename = os::rename(temporaryPath, this->path);
+  if (rename.isError()) {
+    return Error("Failed to rename profiles to '" + this->path + "': " +
+                 rename.error());
+  }
+
+  SERENITY_VLOG(1) << "Saved " << this->profiles.size()
+                   << " workload profiles to " << this->path;
+
+  return Nothing();
+}
+
+
+Try<Nothing> WorkloadProfileStore::load() {
+  if (!this->isEnabled()) {
+    return Error("Profile path is not configured");
+  }
+
+  if (!os::exists(this->path)) {
+    return Error("Profiles '" + this->path + "' do not exist");
+  }
+
+  Try<std::string> content = os::read(this->path);
+  if (content.isError()) {
+    return Error("Failed to read profiles '" + this->path + "': " +
+                 content.error());
+  }
+
+  WorkloadProfiles workloadProfiles;
+  if (!workloadProfiles.ParseFromString(content.get())) {
+    return Error("Failed to parse profiles '" + this->path + "'");
+  }
+
+  this->profiles.clear();
+  for (const WorkloadProfile& profile : workloadProfiles.profiles()) {
+    this->profiles[profile.workload()] = profile;
+  }
+
+  SERENITY_LOG(INFO) << "Loaded " << this->profiles.size()
+                     << " workload profiles from " << this->path;
+
+  return Nothing();
+}
+
+
+lambda::function<BaselineFunction> profileBaseline(
+    std::shared_ptr<WorkloadProfileStore> store,
+    ProfileSignal signal) {
+  return [store, signal](const ExecutorInfo& info) -> Option<double_t> {
+    return store->baseline(info, signal);
+  };
+}
+
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,163 @@
+#ifndef SERENITY_WORKLOAD_PROFILE_HPP
+#define SERENITY_WORKLOAD_PROFILE_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/default_vars.hpp"
+#include "serenity/serenity.hpp"
+
+#include "stout/lambda.hpp"
+#include "stout/nothing.hpp"
+#include "stout/option.hpp"
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+
+class WorkloadProfileConfig : public SerenityConfig {
+ public:
+  WorkloadProfileConfig() {
+    this->initDefaults();
+  }
+
+  explicit WorkloadProfileConfig(const SerenityConfig& customCfg) {
+    this->initDefaults();
+    this->applyConfig(customCfg);
+  }
+
+  void initDefaults() {
+    //! string
+    //! Local file with learned workload profiles. Empty path disables
+    //! profiles.
+    this->fields[workload_profile::PATH] =
+      std::string(workload_profile::DEFAULT_PATH);
+
+    //! double_t
+    //! Weight of new sample in profile baseline and variance.
+    this->fields[workload_profile::ALPHA] = workload_profile::DEFAULT_ALPHA;
+
+    //! uint64_t
+    //! Samples needed before profile is used to seed new executors.
+    this->fields[workload_profile::MIN_SAMPLES] =
+      workload_profile::DEFAULT_MIN_SAMPLES;
+
+    //! double_t
+    //! Profiles with higher relative standard deviation (of IPC or CPU
+    //! usage) are too noisy to be used as a baseline.
+    this->fields[workload_profile::MAX_VARIATION] =
+      workload_profile::DEFAULT_MAX_VARIATION;
+
+    //! uint64_t
+    //! How often (in pipeline iterations) profiles are saved.
+    this->fields[workload_profile::SAVE_INTERVAL] =
+      workload_profile::DEFAULT_SAVE_INTERVAL;
+  }
+};
+
+
+/**
+ * Maps executor to identity of its workload. Executors of the same
+ * workload are expected to behave the same.
+ */
+using WorkloadFunction = std::string(const ExecutorInfo& info);
+
+/**
+ * Default workload identity: framework id with executor name (or command,
+ * when executor has no name). Task id is removed from command executor
+ * name.
+ */
+std::string executorWorkload(const ExecutorInfo& info);
+
+
+/**
+ * Returns baseline of a signal for new executor, if it is known.
+ */
+using BaselineFunction = Option<double_t>(const ExecutorInfo& info);
+
+
+enum class ProfileSignal {
+  IPC,
+  CPU_USAGE
+};
+
+
+/**
+ * Learned baselines of workloads, persisted in a local file, so new (or
+ * restarted) executors of a known workload do not wait for filters and
+ * detectors to warm up.
+ *
+ * File is replaced atomically (written to temporary file and renamed).
+ */
+class WorkloadProfileStore {
+ public:
+  explicit WorkloadProfileStore(
+      const SerenityConfig& _conf = SerenityConfig(),
+      const lambda::function<WorkloadFunction>& _workloadFunction =
+        executorWorkload,
+      const Tag& _tag = Tag(QOS_CONTROLLER, NAME));
+
+  bool isEnabled() const {
+    return !this->path.empty();
+  }
+
+  /**
+   * Updates baseline and variance of executor's workload.
+   */
+  void learn(const ExecutorInfo& info,
+             double_t ipc,
+             double_t cpuUsage,
+             double_t timestamp);
+
+  /**
+   * Returns baseline of the signal, when workload profile is trusted
+   * (enough samples and not too noisy).
+   */
+  Option<double_t> baseline(const ExecutorInfo& info,
+                            ProfileSignal signal) const;
+
+  Option<WorkloadProfile> get(const ExecutorInfo& info) const;
+
+  size_t size() const {
+    return this->profiles.size();
+  }
+
+  Try<Nothing> save() const;
+
+  /**
+   * Replaces current profiles with the ones from file.
+   */
+  Try<Nothing> load();
+
+  static const constexpr char* NAME = "WorkloadProfileStore";
+
+ protected:
+  const Tag tag;
+  const std::string path;
+  const double_t alpha;
+  const uint64_t minSamples;
+  const double_t maxVariation;
+  const lambda::function<WorkloadFunction> workloadFunction;
+
+  std::unordered_map<std::string, WorkloadProfile> profiles;
+};
+
+
+/**
+ * Binds store and signal into a function usable by EMAFilter and
+ * SignalBasedDetector.
+ */
+lambda::function<BaselineFunction> profileBaseline(
+    std::shared_ptr<WorkloadProfileStore> store,
+    ProfileSignal signal);
+
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_WORKLOAD_PROFILE_HPP
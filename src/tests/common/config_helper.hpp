@@ -35,6 +35,26 @@ inline SerenityConfig createThresholdDetectorCfg(
   return cfg;
 }
 
+inline SerenityConfig createBandwidthDetectorCfg(
+    const double_t maxBandwidth,
+    const double_t threshold) {
+  SerenityConfig cfg;
+  cfg.set(detector::MAX_BANDWIDTH, maxBandwidth);
+  cfg.set(detector::BANDWIDTH_THRESHOLD, threshold);
+
+  return cfg;
+}
+
+inline SerenityConfig createMemoryBandwidthDetectorCfg(
+    const double_t maxBandwidth,
+    const double_t threshold) {
+  SerenityConfig cfg;
+  cfg.set(detector::MAX_MEMORY_BANDWIDTH, maxBandwidth);
+  cfg.set(detector::MEMORY_BANDWIDTH_THRESHOLD, threshold);
+
+  return cfg;
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
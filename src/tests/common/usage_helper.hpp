@@ -10,7 +10,10 @@
 
 #include <pbjson.hpp>
 
+#include <stout/none.hpp>
+#include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/stringify.hpp>
 
 #include <string>
 
@@ -49,6 +52,52 @@ class JsonUsage {
 };
 
 
+/**
+ * Returns first usage of given fixture on Agent with given total memory
+ * [MB].
+ */
+inline ResourceUsage createUsageWithTotalMem(
+    const std::string& fixture,
+    const std::string& totalMem) {
+  Try<mesos::FixtureResourceUsage> usages = JsonUsage::ReadJson(fixture);
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage.add_total()->CopyFrom(Resources::parse("mem", totalMem, "*").get());
+  return usage;
+}
+
+
+/**
+ * Creates usage of single executor on Agent with 10 CPUs. Allocated CPUs
+ * and CPU limit are set only when given.
+ */
+inline ResourceUsage createSingleExecutorUsage(
+    double_t timestamp,
+    double_t cumulativeCpu,
+    const Option<double_t>& allocatedCpus = None(),
+    const Option<double_t>& cpusLimit = None()) {
+  ResourceUsage usage;
+  usage.add_total()->CopyFrom(Resources::parse("cpus", "10", "*").get());
+
+  ResourceUsage_Executor* executor = usage.add_executors();
+  executor->mutable_executor_info()->mutable_executor_id()->set_value("ex");
+  executor->mutable_executor_info()->mutable_framework_id()->set_value("fw");
+  executor->mutable_executor_info()->mutable_command()->set_value("run");
+  if (allocatedCpus.isSome()) {
+    executor->add_allocated()->CopyFrom(Resources::parse(
+        "cpus", stringify(allocatedCpus.get()), "*").get());
+  }
+  executor->mutable_statistics()->set_timestamp(timestamp);
+  if (cpusLimit.isSome()) {
+    executor->mutable_statistics()->set_cpus_limit(cpusLimit.get());
+  }
+  executor->mutable_statistics()->set_cpus_user_time_secs(cumulativeCpu);
+  executor->mutable_statistics()->set_cpus_system_time_secs(0);
+
+  return usage;
+}
+
+
 /**
  * Fake usage function (same method as in mesos::slave::Slave).
  * For internal unit tests use JsonSource.
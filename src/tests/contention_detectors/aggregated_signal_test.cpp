@@ -0,0 +1,202 @@
+#include <string>
+
+#include "contention_detectors/aggregated_signal.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/config_helper.hpp"
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char AGGREGATED_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+const int AGGREGATED_VICTIM = 3;
+const int AGGREGATED_OTHER = 4;
+const int AGGREGATED_STABLE_ITERATIONS = 10;
+
+
+static Try<double_t> unitWeight(const ResourceUsage_Executor& executor) {
+  return 1.0;
+}
+
+
+// Production executors run on separate sockets.
+static Option<uint32_t> executorSocket(
+    const ResourceUsage_Executor& executor) {
+  if (executor.executor_info().executor_id().value() == "serenityPR") {
+    return 0u;
+  }
+  return 1u;
+}
+
+
+static SerenityConfig createAggregatedDetectorCfg() {
+  return createAssuranceAnalyzerCfg(8, 3, 0.3);
+}
+
+
+class AggregatedSignalDetectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<mesos::FixtureResourceUsage> usages =
+      JsonUsage::ReadJson(AGGREGATED_QOS_FIXTURE);
+    ASSERT_SOME(usages);
+    usage.CopyFrom(usages.get().resource_usage(0));
+
+    setIpc(AGGREGATED_VICTIM, 2.0);
+    setIpc(AGGREGATED_OTHER, 2.0);
+  }
+
+  void setIpc(int executor, double_t ipc) {
+    usage::setEmaIpc(ipc, usage.mutable_executors(executor));
+  }
+
+  ResourceUsage usage;
+};
+
+
+/**
+ * Drop of one executor's IPC lowers host aggregate - contention should be
+ * created only for this executor.
+ */
+TEST_F(AggregatedSignalDetectorTest, DropPicksVictim) {
+  MockSink<Contentions> mockSink;
+  AggregatedSignalDetector detector(
+      &mockSink,
+      usage::getEmaIpc,
+      createAggregatedDetectorCfg(),
+      unknownSocket,
+      unitWeight);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  for (int i = 0; i < AGGREGATED_STABLE_ITERATIONS; i++) {
+    usageSource.produce(usage);
+    mockSink.expectContentions(0);
+  }
+  EXPECT_EQ(1u, detector.scopes());
+
+  setIpc(AGGREGATED_VICTIM, 0.5);
+  usageSource.produce(usage);
+
+  mockSink.expectContentions(1);
+  mockSink.expectContentionWithVictim(
+      usage.executors(AGGREGATED_VICTIM).executor_info()
+        .executor_id().value());
+  EXPECT_EQ(Contention_Type_IPC, mockSink.currentConsumedT.front().type());
+}
+
+
+/**
+ * With socket function each socket has its own aggregate, victim is
+ * reported once even though both host and its socket detect the drop.
+ */
+TEST_F(AggregatedSignalDetectorTest, SocketScopes) {
+  MockSink<Contentions> mockSink;
+  AggregatedSignalDetector detector(
+      &mockSink,
+      usage::getEmaIpc,
+      createAggregatedDetectorCfg(),
+      executorSocket,
+      unitWeight);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  for (int i = 0; i < AGGREGATED_STABLE_ITERATIONS; i++) {
+    usageSource.produce(usage);
+  }
+  // Host and two sockets.
+  EXPECT_EQ(3u, detector.scopes());
+
+  setIpc(AGGREGATED_VICTIM, 0.5);
+  usageSource.produce(usage);
+
+  mockSink.expectContentions(1);
+  mockSink.expectContentionWithVictim(
+      usage.executors(AGGREGATED_VICTIM).executor_info()
+        .executor_id().value());
+}
+
+
+/**
+ * Executor with much lower signal joining the host should not lower the
+ * aggregate, since each executor is normalized by its own reference.
+ */
+TEST_F(AggregatedSignalDetectorTest, NewExecutorDoesNotLowerAggregate) {
+  ResourceUsage withoutOther;
+  withoutOther.mutable_total()->CopyFrom(usage.total());
+  for (int i = 0; i < usage.executors_size(); i++) {
+    if (i != AGGREGATED_OTHER) {
+      withoutOther.add_executors()->CopyFrom(usage.executors(i));
+    }
+  }
+
+  MockSink<Contentions> mockSink;
+  AggregatedSignalDetector detector(
+      &mockSink,
+      usage::getEmaIpc,
+      createAggregatedDetectorCfg(),
+      unknownSocket,
+      unitWeight);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  for (int i = 0; i < AGGREGATED_STABLE_ITERATIONS; i++) {
+    usageSource.produce(withoutOther);
+    mockSink.expectContentions(0);
+  }
+
+  setIpc(AGGREGATED_OTHER, 0.2);
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+}
+
+
+/**
+ * Without best effort executors drop is assumed to be false positive.
+ */
+TEST_F(AggregatedSignalDetectorTest, NoRevocableExecutors) {
+  ResourceUsage productionOnly;
+  productionOnly.mutable_total()->CopyFrom(usage.total());
+  productionOnly.add_executors()->CopyFrom(usage.executors(AGGREGATED_VICTIM));
+  productionOnly.add_executors()->CopyFrom(usage.executors(AGGREGATED_OTHER));
+
+  MockSink<Contentions> mockSink;
+  AggregatedSignalDetector detector(
+      &mockSink,
+      usage::getEmaIpc,
+      createAggregatedDetectorCfg(),
+      unknownSocket,
+      unitWeight);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  for (int i = 0; i < AGGREGATED_STABLE_ITERATIONS; i++) {
+    usageSource.produce(productionOnly);
+  }
+
+  usage::setEmaIpc(0.5, productionOnly.mutable_executors(0));
+  usageSource.produce(productionOnly);
+
+  mockSink.expectContentions(0);
+  EXPECT_EQ(AGGREGATED_STABLE_ITERATIONS + 1,
+            mockSink.numberOfMessagesConsumed);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,151 @@
+#include <list>
+#include <string>
+
+#include "contention_detectors/bandwidth.hpp"
+
+#include "filters/cumulative.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/config_helper.hpp"
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char BANDWIDTH_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+const double_t MAX_NETWORK_BANDWIDTH = 1e9;
+
+
+// Sets already sampled (per second) network counters.
+static void setNetworkBytes(uint64_t rx,
+                            uint64_t tx,
+                            ResourceUsage_Executor* executor) {
+  executor->mutable_statistics()->set_timestamp(1);
+  executor->mutable_statistics()->set_net_rx_bytes(rx);
+  executor->mutable_statistics()->set_net_tx_bytes(tx);
+}
+
+
+class BandwidthDetectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<mesos::FixtureResourceUsage> usages =
+      JsonUsage::ReadJson(BANDWIDTH_QOS_FIXTURE);
+    ASSERT_SOME(usages);
+    usage.CopyFrom(usages.get().resource_usage(0));
+  }
+
+  ResourceUsage usage;
+};
+
+
+/**
+ * Sum of network bandwidth below the threshold should not cause any
+ * contention. Executors without network counters are skipped.
+ */
+TEST_F(BandwidthDetectorTest, BandwidthBelowThreshold) {
+  MockSink<Contentions> mockSink;
+  BandwidthDetector detector(
+      &mockSink,
+      Contention_Type_NETWORK,
+      createBandwidthDetectorCfg(MAX_NETWORK_BANDWIDTH, 0.8));
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  setNetworkBytes(200e6, 100e6, usage.mutable_executors(0));
+  setNetworkBytes(300e6, 100e6, usage.mutable_executors(3));
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  EXPECT_EQ(2, mockSink.numberOfMessagesConsumed);
+}
+
+
+/**
+ * Sum of network bandwidth above the threshold should create NETWORK
+ * contention with severity equal to fraction of max bandwidth above
+ * the threshold. Detector without MAX_BANDWIDTH should stay inactive.
+ */
+TEST_F(BandwidthDetectorTest, BandwidthAboveThreshold) {
+  MockSink<Contentions> networkSink;
+  MockSink<Contentions> unconfiguredSink;
+  BandwidthDetector networkDetector(
+      &networkSink,
+      Contention_Type_NETWORK,
+      createBandwidthDetectorCfg(MAX_NETWORK_BANDWIDTH, 0.8));
+  BandwidthDetector unconfiguredDetector(
+      &unconfiguredSink, Contention_Type_NETWORK);
+  MockSource<ResourceUsage> usageSource(
+      &networkDetector, &unconfiguredDetector);
+
+  setNetworkBytes(400e6, 200e6, usage.mutable_executors(0));
+  setNetworkBytes(200e6, 100e6, usage.mutable_executors(3));
+
+  usageSource.produce(usage);
+
+  networkSink.expectContentions(1);
+  const Contention& contention = networkSink.currentConsumedT.front();
+  EXPECT_EQ(Contention_Type_NETWORK, contention.type());
+  EXPECT_NEAR(0.1, contention.severity(), 0.0001);
+
+  unconfiguredSink.expectContentions(0);
+}
+
+
+/**
+ * Cumulative network counters are converted to difference from
+ * previous sample, so bandwidth is counted per sampling duration.
+ */
+TEST_F(BandwidthDetectorTest, CountersSampledByCumulativeFilter) {
+  MockSink<ResourceUsage> mockSink;
+  CumulativeFilter cumulativeFilter(&mockSink);
+  MockSource<ResourceUsage> usageSource(&cumulativeFilter);
+
+  ResourceStatistics* statistics =
+    usage.mutable_executors(0)->mutable_statistics();
+  statistics->set_timestamp(100);
+  statistics->set_net_rx_bytes(1000);
+  statistics->set_net_tx_bytes(500);
+  usageSource.produce(usage);
+
+  statistics->set_timestamp(102);
+  statistics->set_net_rx_bytes(3000);
+  statistics->set_net_tx_bytes(1500);
+  usageSource.produce(usage);
+
+  ASSERT_EQ(2, mockSink.numberOfMessagesConsumed);
+  const ResourceUsage_Executor& sampled =
+    mockSink.currentConsumedT.executors(0);
+
+  Try<double_t> network = usage::getNetworkBandwidth(sampled);
+  ASSERT_SOME(network);
+  EXPECT_DOUBLE_EQ(1500, network.get());
+
+  EXPECT_ERROR(usage::getNetworkBandwidth(
+      mockSink.currentConsumedT.executors(1)));
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,117 @@
+#include <list>
+#include <string>
+
+#include "contention_detectors/memory_bandwidth.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/config_helper.hpp"
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char MBW_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+const double_t MAX_BANDWIDTH = 10e9;
+
+
+/**
+ * Sum of bandwidth below the threshold should not cause any contention.
+ * Executors without bandwidth data (e.g. first iteration) are skipped.
+ */
+TEST(MemoryBandwidthDetectorTest, BandwidthBelowThreshold) {
+  MockSink<Contentions> mockSink;
+  MemoryBandwidthDetector detector(
+      &mockSink, createMemoryBandwidthDetectorCfg(MAX_BANDWIDTH, 0.8));
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(MBW_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  usage::setMbmTotalBandwidth(3e9, usage.mutable_executors(0));
+  usage::setMbmTotalBandwidth(4e9, usage.mutable_executors(3));
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  EXPECT_EQ(2, mockSink.numberOfMessagesConsumed);
+}
+
+
+/**
+ * Sum of bandwidth above the threshold should create MEMORY_BANDWIDTH
+ * contention with severity equal to fraction of max bandwidth above
+ * the threshold.
+ */
+TEST(MemoryBandwidthDetectorTest, BandwidthAboveThreshold) {
+  MockSink<Contentions> mockSink;
+  MemoryBandwidthDetector detector(
+      &mockSink, createMemoryBandwidthDetectorCfg(MAX_BANDWIDTH, 0.8));
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(MBW_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+
+  usage::setMbmTotalBandwidth(5e9, usage.mutable_executors(0));
+  usage::setMbmTotalBandwidth(4e9, usage.mutable_executors(3));
+
+  usageSource.produce(usage);
+
+  mockSink.expectContentions(1);
+  const Contention& contention = mockSink.currentConsumedT.front();
+  EXPECT_EQ(Contention_Type_MEMORY_BANDWIDTH, contention.type());
+  EXPECT_NEAR(0.1, contention.severity(), 0.0001);
+}
+
+/**
+ * Without configured MAX_MEMORY_BANDWIDTH detector should stay inactive.
+ */
+TEST(MemoryBandwidthDetectorTest, InactiveWithoutMaxBandwidth) {
+  MockSink<Contentions> mockSink;
+  MemoryBandwidthDetector detector(&mockSink);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(MBW_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage::setMbmTotalBandwidth(50e9, usage.mutable_executors(0));
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+  EXPECT_EQ(1, mockSink.numberOfMessagesConsumed);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
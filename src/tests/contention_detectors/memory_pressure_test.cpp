@@ -0,0 +1,126 @@
+#include <list>
+#include <string>
+
+#include "contention_detectors/memory_pressure.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+#include "mesos/resources.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "observers/strategies/memory_pressure.hpp"
+
+#include "serenity/config.hpp"
+
+#include "stout/bytes.hpp"
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors with 67.7 MB RSS each:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char MEMORY_PRESSURE_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+/**
+ * 338 MB of 400 MB used (84.6%) is below default 90% threshold.
+ */
+TEST(MemoryPressureDetectorTest, UsageBelowThreshold) {
+  MockSink<Contentions> mockSink;
+  MemoryPressureDetector detector(&mockSink);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  usageSource.produce(createUsageWithTotalMem(MEMORY_PRESSURE_FIXTURE, "400"));
+
+  mockSink.expectContentions(0);
+  EXPECT_EQ(1, mockSink.numberOfMessagesConsumed);
+}
+
+
+/**
+ * 338 MB of 350 MB used (96.7%) should create MEMORY contention with
+ * severity equal to fraction of memory above threshold.
+ */
+TEST(MemoryPressureDetectorTest, UsageAboveThreshold) {
+  MockSink<Contentions> mockSink;
+  MemoryPressureDetector detector(&mockSink);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  usageSource.produce(createUsageWithTotalMem(MEMORY_PRESSURE_FIXTURE, "350"));
+
+  mockSink.expectContentions(1);
+  const Contention& contention = mockSink.currentConsumedT.front();
+  EXPECT_EQ(Contention_Type_MEMORY, contention.type());
+  EXPECT_NEAR(0.067, contention.severity(), 0.001);
+}
+
+
+/**
+ * Increased critical pressure counter of PR executor should create
+ * contention even when memory usage is low.
+ */
+TEST(MemoryPressureDetectorTest, CriticalPressureCounter) {
+  MockSink<Contentions> mockSink;
+  MemoryPressureDetector detector(&mockSink);
+  MockSource<ResourceUsage> usageSource(&detector);
+
+  ResourceUsage usage =
+    createUsageWithTotalMem(MEMORY_PRESSURE_FIXTURE, "4096");
+  usage.mutable_executors(3)->mutable_statistics()
+    ->set_mem_critical_pressure_counter(1);
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  // Counter unchanged.
+  usageSource.produce(usage);
+  mockSink.expectContentions(0);
+
+  usage.mutable_executors(3)->mutable_statistics()
+    ->set_mem_critical_pressure_counter(2);
+
+  usageSource.produce(usage);
+  mockSink.expectContentions(1);
+  EXPECT_NEAR(detector::DEFAULT_CRITICAL_PRESSURE_SEVERITY,
+              mockSink.currentConsumedT.front().severity(),
+              0.0001);
+}
+
+
+/**
+ * Strategy should revoke BE executors with the biggest RSS until
+ * severity * total memory is recovered.
+ */
+TEST(MemoryPressureStrategyTest, RevokeBiggestFirst) {
+  ResourceUsage usage =
+    createUsageWithTotalMem(MEMORY_PRESSURE_FIXTURE, "1000");
+  usage.mutable_executors(1)->mutable_statistics()
+    ->set_mem_rss_bytes(Megabytes(120).bytes());
+
+  Contentions contentions;
+  // 10% of 1000 MB - the biggest BE executor (120 MB) is enough.
+  contentions.push_back(createContention(0.1, Contention_Type_MEMORY));
+
+  MemoryPressureStrategy strategy;
+  Try<QoSCorrections> corrections =
+    strategy.decide(nullptr, contentions, usage);
+  ASSERT_SOME(corrections);
+  ASSERT_EQ(1u, corrections.get().size());
+  EXPECT_EQ(usage.executors(1).executor_info().executor_id().value(),
+            corrections.get().front().kill().executor_id().value());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -210,6 +210,69 @@ TEST(OverloadDetectorTest, IntegrationTest) {
 }
 
 
+/**
+ * In this test we generate linearly growing cpu utilization.
+ * We expect that OverloadDetector in predictive mode will create
+ * contention one iteration before the non predictive one, with severity
+ * equal to predicted amount of CPUs above the threshold.
+ */
+TEST(OverloadDetectorTest, PredictiveUtilization) {
+  const double_t UTIL_THRESHOLD = 0.72;
+  const uint64_t ITERATIONS = 8;
+  MockSink<Contentions> mockSink;
+  MockSink<Contentions> predictiveMockSink;
+
+  OverloadDetector overloadDetector(
+    &mockSink, usage::getCpuUsage,
+    createThresholdDetectorCfg(UTIL_THRESHOLD));
+
+  SerenityConfig predictiveCfg = createThresholdDetectorCfg(UTIL_THRESHOLD);
+  predictiveCfg.set(detector::PREDICTIVE, true);
+  predictiveCfg.set(detector::TREND_WINDOW_SIZE, (uint64_t) 5);
+  OverloadDetector predictiveOverloadDetector(
+    &predictiveMockSink, usage::getCpuUsage, predictiveCfg);
+
+  // Fake slave ResourceUsage source.
+  MockSource<ResourceUsage> usageSource(&overloadDetector);
+  usageSource.addConsumer(&predictiveOverloadDetector);
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson("tests/fixtures/be_start_json_test.json");
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+
+  // Threshold is 0.72 * 8 = 5.76 CPUs.
+  for (uint64_t cpus = 1; cpus <= ITERATIONS; cpus++) {
+    usage.mutable_executors(0)->CopyFrom(
+      generateCpuUsage(usage.executors(0), cpus, 1));
+
+    // Run pipeline iteration.
+    usageSource.produce(usage);
+
+    if (cpus >= 6) {
+      mockSink.expectContentions(1);
+    } else {
+      mockSink.expectContentions(0);
+    }
+
+    if (cpus >= 5) {
+      predictiveMockSink.expectContentions(1);
+    } else {
+      predictiveMockSink.expectContentions(0);
+    }
+
+    if (cpus == 5) {
+      // For 5 CPUs, forecast for the next iteration is 6 CPUs.
+      EXPECT_NEAR(6 - 8 * UTIL_THRESHOLD,
+                  predictiveMockSink.currentConsumedT.front().severity(),
+                  0.0001);
+    }
+  }
+}
+
+
 }  //  namespace tests
 }  //  namespace serenity
 }  //  namespace mesos
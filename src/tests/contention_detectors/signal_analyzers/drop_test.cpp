@@ -291,6 +291,67 @@ TEST(SignalDropAnalyzerTest, NoisyLoadOneBigDropMoreCheckpoints) {
   }
 }
 
+
+/**
+ * Analyzer restored from checkpoint detects drop immediately, while cold
+ * analyzer (window filled with DEFAULT_START_VALUE) misses it.
+ */
+TEST(SignalDropAnalyzerTest, RestoredFromCheckpoint) {
+  const uint64_t WINDOWS_SIZE = 8;
+  const uint64_t MAX_CHECKPOINTS = 4;
+  const double_t FRACTION_THRESHOLD = 0.5;
+  const double_t SEVERITY_FRACTION = 1;
+  const double_t NEAR_FRACTION = 0;
+  const SerenityConfig cfg = createAssuranceAnalyzerCfg(
+      WINDOWS_SIZE,
+      MAX_CHECKPOINTS,
+      FRACTION_THRESHOLD,
+      SEVERITY_FRACTION,
+      NEAR_FRACTION);
+  const Tag tag(QOS_CONTROLLER, "SignalDropAnalyzer");
+
+  SignalDropAnalyzer warmAnalyzer(tag, cfg);
+  for (uint64_t i = 0; i < WINDOWS_SIZE; i++) {
+    EXPECT_NONE(warmAnalyzer.processSample(10));
+  }
+
+  FilterCheckpoint_Executor checkpoint;
+  warmAnalyzer.checkpoint(&checkpoint);
+  EXPECT_EQ(static_cast<int>(WINDOWS_SIZE), checkpoint.window_size());
+  EXPECT_FALSE(checkpoint.has_value_before_drop());
+
+  SignalDropAnalyzer restoredAnalyzer(tag, cfg);
+  ASSERT_SOME(restoredAnalyzer.restore(checkpoint));
+  EXPECT_SOME(restoredAnalyzer.processSample(4));
+
+  SignalDropAnalyzer coldAnalyzer(tag, cfg);
+  EXPECT_NONE(coldAnalyzer.processSample(4));
+
+  // Window size must match configuration.
+  SignalDropAnalyzer smallerAnalyzer(
+      tag,
+      createAssuranceAnalyzerCfg(WINDOWS_SIZE / 2, MAX_CHECKPOINTS, 0.5));
+  EXPECT_ERROR(smallerAnalyzer.restore(checkpoint));
+}
+
+
+/**
+ * Analyzer seeded with workload baseline detects drop below it from the
+ * first sample.
+ */
+TEST(SignalDropAnalyzerTest, SeededWithBaseline) {
+  const SerenityConfig cfg = createAssuranceAnalyzerCfg(8, 4, 0.5, 1, 0);
+  const Tag tag(QOS_CONTROLLER, "SignalDropAnalyzer");
+
+  SignalDropAnalyzer seededAnalyzer(tag, cfg);
+  seededAnalyzer.seed(10);
+  EXPECT_SOME(seededAnalyzer.processSample(4));
+
+  SignalDropAnalyzer stableAnalyzer(tag, cfg);
+  stableAnalyzer.seed(10);
+  EXPECT_NONE(stableAnalyzer.processSample(10));
+}
+
 }  //  namespace tests
 }  //  namespace serenity
 }  //  namespace mesos
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <vector>
+
+#include "contention_detectors/signal_analyzers/mahalanobis.hpp"
+
+#include "gtest/gtest.h"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+
+#include "stout/gtest.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// IPC, IPS, MPKI, CPU usage.
+const size_t MAHALANOBIS_SIGNALS = 4;
+const uint64_t MAHALANOBIS_ITERATIONS = 30;
+
+
+/**
+ * Stable signals with ~1% deterministic noise. IPC and IPS move together.
+ */
+static std::vector<double_t> stableSignals(uint64_t iteration) {
+  const double_t noise = 0.01 * std::sin(iteration * 1.3);
+  return std::vector<double_t>{
+    1.5 * (1 + noise),
+    3.0 * (1 + noise),
+    2.0 * (1 + 0.01 * std::cos(iteration * 0.7)),
+    4.0 * (1 + 0.01 * std::sin(iteration * 0.5))};
+}
+
+
+static MahalanobisAnalyzer createLearnedAnalyzer() {
+  MahalanobisAnalyzer analyzer(
+      Tag(QOS_CONTROLLER, MAHALANOBIS_ANALYZER_NAME),
+      SerenityConfig(),
+      MAHALANOBIS_SIGNALS);
+
+  for (uint64_t i = 0; i < MAHALANOBIS_ITERATIONS; i++) {
+    Result<Detection> result = analyzer.processSamples(stableSignals(i));
+    EXPECT_NONE(result);
+  }
+
+  return analyzer;
+}
+
+
+/**
+ * IPC drop together with more cache misses should be detected after
+ * CONSECUTIVE_SAMPLES anomalous samples.
+ */
+TEST(MahalanobisAnalyzerTest, InterferenceDetected) {
+  MahalanobisAnalyzer analyzer = createLearnedAnalyzer();
+  const std::vector<double_t> interference{1.2, 2.4, 6.0, 4.0};
+
+  EXPECT_NONE(analyzer.processSamples(interference));
+
+  Result<Detection> result = analyzer.processSamples(interference);
+  ASSERT_SOME(result);
+  ASSERT_SOME(result.get().severity);
+  EXPECT_GT(result.get().severity.get(), 0.9);
+}
+
+
+/**
+ * Samples far from baseline, but with better IPC, are not contentions.
+ */
+TEST(MahalanobisAnalyzerTest, HigherIpcNotDetected) {
+  MahalanobisAnalyzer analyzer = createLearnedAnalyzer();
+  const std::vector<double_t> boost{2.0, 4.0, 2.0, 4.0};
+
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NONE(analyzer.processSamples(boost));
+  }
+}
+
+
+/**
+ * Lasting shift which corrections did not fix is reported only until
+ * MAX_ANOMALOUS_SAMPLES. Then it becomes the new baseline.
+ */
+TEST(MahalanobisAnalyzerTest, PersistentShiftRelearned) {
+  MahalanobisAnalyzer analyzer = createLearnedAnalyzer();
+
+  uint64_t contentions = 0;
+  for (uint64_t i = 0; i < MAHALANOBIS_ITERATIONS; i++) {
+    std::vector<double_t> shifted = stableSignals(i);
+    shifted[0] *= 0.8;
+    shifted[1] *= 0.8;
+    shifted[2] *= 3.0;
+
+    Result<Detection> result = analyzer.processSamples(shifted);
+    ASSERT_FALSE(result.isError());
+    if (result.isSome()) {
+      contentions++;
+      // Contentions are reported only until baseline is relearned.
+      EXPECT_LT(i, detector::DEFAULT_MAX_ANOMALOUS_SAMPLES);
+    }
+  }
+
+  EXPECT_EQ(detector::DEFAULT_MAX_ANOMALOUS_SAMPLES -
+              detector::DEFAULT_CONSECUTIVE_SAMPLES,
+            contentions);
+}
+
+
+TEST(MahalanobisAnalyzerTest, CheckpointRestore) {
+  MahalanobisAnalyzer analyzer = createLearnedAnalyzer();
+  FilterCheckpoint_Executor checkpoint;
+  analyzer.checkpoint(&checkpoint);
+  EXPECT_EQ(MAHALANOBIS_ITERATIONS, checkpoint.samples());
+
+  MahalanobisAnalyzer restored(
+      Tag(QOS_CONTROLLER, MAHALANOBIS_ANALYZER_NAME),
+      SerenityConfig(),
+      MAHALANOBIS_SIGNALS);
+  EXPECT_SOME(restored.restore(checkpoint));
+
+  const std::vector<double_t> sample{1.2, 2.4, 6.0, 4.0};
+  Try<double_t> expected = analyzer.distance(sample);
+  Try<double_t> actual = restored.distance(sample);
+  ASSERT_SOME(expected);
+  ASSERT_SOME(actual);
+  EXPECT_DOUBLE_EQ(expected.get(), actual.get());
+
+  // Checkpoint of other detector does not fit.
+  MahalanobisAnalyzer smaller(
+      Tag(QOS_CONTROLLER, MAHALANOBIS_ANALYZER_NAME),
+      SerenityConfig(),
+      MAHALANOBIS_SIGNALS - 1);
+  EXPECT_ERROR(smaller.restore(checkpoint));
+}
+
+
+TEST(MahalanobisAnalyzerTest, WrongNumberOfSignals) {
+  MahalanobisAnalyzer analyzer(
+      Tag(QOS_CONTROLLER, MAHALANOBIS_ANALYZER_NAME),
+      SerenityConfig(),
+      MAHALANOBIS_SIGNALS);
+
+  EXPECT_ERROR(analyzer.processSample(1.0));
+  EXPECT_ERROR(analyzer.processSamples(std::vector<double_t>{1.0, 2.0}));
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -378,6 +378,49 @@ TEST(EMATest, CpuUsageEMATestNoisyConstSample) {
   EXPECT_EQ(99, mockSink.numberOfMessagesConsumed);
 }
 
+
+/**
+ * EMA of executor with known baseline starts from it, so first sample is
+ * passed.
+ */
+TEST(EMATest, IpcEMASeededWithBaseline) {
+  const double_t ALPHA = 0.2;
+  const double_t BASELINE = 1.0;
+
+  MockSink<ResourceUsage> mockSink;
+  EMAFilter ipcEMAFilter(
+      &mockSink, usage::getIpc, usage::setEmaIpc, ALPHA);
+  MockSource<ResourceUsage> source(&ipcEMAFilter);
+
+  Try<mesos::FixtureResourceUsage> usages =
+      JsonUsage::ReadJson("tests/fixtures/start_json_test.json");
+  ASSERT_SOME(usages);
+  const ResourceUsage& usage = usages.get().resource_usage(0);
+  const ExecutorInfo& seeded = usage.executors(0).executor_info();
+
+  ipcEMAFilter.setBaseline(
+      [&seeded](const ExecutorInfo& info) -> Option<double_t> {
+        if (info.executor_id().value() == seeded.executor_id().value()) {
+          return BASELINE;
+        }
+        return None();
+      });
+
+  source.produce(usage);
+
+  ASSERT_EQ(1, mockSink.numberOfMessagesConsumed);
+  ASSERT_EQ(1, mockSink.currentConsumedT.executors_size());
+
+  Try<double_t> ipc = usage::getIpc(usage.executors(0));
+  ASSERT_SOME(ipc);
+  Try<double_t> emaIpc =
+    usage::getEmaIpc(mockSink.currentConsumedT.executors(0));
+  ASSERT_SOME(emaIpc);
+  EXPECT_DOUBLE_EQ(ALPHA * ipc.get() + (1 - ALPHA) * BASELINE, emaIpc.get());
+}
+
+
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
@@ -0,0 +1,181 @@
+#include <string>
+
+#include "filters/resctrl.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/resctrl.hpp"
+
+#include "stout/gtest.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+#include "stout/stringify.hpp"
+
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char RESCTRL_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+/**
+ * Fake resctrl filesystem with two L3 domains (sockets).
+ */
+class FakeResctrlTree : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<std::string> dir = os::mkdtemp();
+    ASSERT_SOME(dir);
+    root = dir.get();
+
+    ASSERT_SOME(os::mkdir(path::join(root, "info", "L3_MON")));
+    ASSERT_SOME(os::write(
+      path::join(root, "info", "L3_MON", "mon_features"),
+      "llc_occupancy\nmbm_total_bytes\nmbm_local_bytes\n"));
+  }
+
+  void TearDown() override {
+    os::rmdir(root);
+  }
+
+  void writeCounters(const std::string& group,
+                     uint64_t llcOccupancy,
+                     uint64_t mbmLocalBytes,
+                     uint64_t mbmTotalBytes) {
+    for (const std::string& domain : {"mon_L3_00", "mon_L3_01"}) {
+      const std::string domainPath =
+        path::join(root, "mon_groups", group, "mon_data", domain);
+      ASSERT_SOME(os::mkdir(domainPath));
+
+      // Counters are split equally between domains.
+      ASSERT_SOME(os::write(path::join(domainPath, "llc_occupancy"),
+                            stringify(llcOccupancy / 2) + "\n"));
+      ASSERT_SOME(os::write(path::join(domainPath, "mbm_local_bytes"),
+                            stringify(mbmLocalBytes / 2) + "\n"));
+      ASSERT_SOME(os::write(path::join(domainPath, "mbm_total_bytes"),
+                            stringify(mbmTotalBytes / 2) + "\n"));
+    }
+  }
+
+  std::string root;
+};
+
+
+TEST_F(FakeResctrlTree, MonitorReadsFeaturesAndSumsDomains) {
+  ResctrlMonitor monitor(root);
+  EXPECT_TRUE(monitor.isAvailable());
+  EXPECT_TRUE(monitor.isLlcOccupancySupported());
+  EXPECT_TRUE(monitor.isMbmLocalSupported());
+  EXPECT_TRUE(monitor.isMbmTotalSupported());
+
+  writeCounters("group1", 4000000, 1000, 3000);
+
+  Try<ResctrlSample> sample = monitor.read("group1");
+  ASSERT_SOME(sample);
+  ASSERT_SOME(sample.get().llcOccupancy);
+  EXPECT_EQ(4000000u, sample.get().llcOccupancy.get());
+  ASSERT_SOME(sample.get().mbmLocalBytes);
+  EXPECT_EQ(1000u, sample.get().mbmLocalBytes.get());
+  ASSERT_SOME(sample.get().mbmTotalBytes);
+  EXPECT_EQ(3000u, sample.get().mbmTotalBytes.get());
+
+  EXPECT_ERROR(monitor.read("notExistingGroup"));
+}
+
+
+/**
+ * Filter should attach LLC occupancy in every iteration and MBM bandwidth
+ * starting from second iteration.
+ */
+TEST_F(FakeResctrlTree, FilterCountsBandwidth) {
+  MockSink<ResourceUsage> mockSink;
+  ResctrlFilter filter(&mockSink, [this]() {
+      SerenityConfig config;
+      config.set(resctrl::ROOT_PATH, root);
+      return config;
+    }());
+  MockSource<ResourceUsage> usageSource(&filter);
+  ASSERT_TRUE(filter.isAvailable());
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(RESCTRL_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  const std::string group =
+    usage.executors(0).executor_info().executor_id().value();
+  const double_t timestamp = usage.executors(0).statistics().timestamp();
+
+  writeCounters(group, 2000000, 1000, 4000);
+  usageSource.produce(usage);
+
+  ASSERT_EQ(1, mockSink.numberOfMessagesConsumed);
+  ResourceUsage_Executor exec = mockSink.currentConsumedT.executors(0);
+  Try<double_t> llc = usage::getLlcOccupancy(exec);
+  ASSERT_SOME(llc);
+  EXPECT_DOUBLE_EQ(2000000, llc.get());
+  EXPECT_ERROR(usage::getMbmTotalBandwidth(exec));
+
+  // Next iteration 2 seconds later.
+  usage.mutable_executors(0)->mutable_statistics()->set_timestamp(
+    timestamp + 2);
+  writeCounters(group, 3000000, 5000, 24000);
+  usageSource.produce(usage);
+
+  ASSERT_EQ(2, mockSink.numberOfMessagesConsumed);
+  exec = mockSink.currentConsumedT.executors(0);
+  llc = usage::getLlcOccupancy(exec);
+  ASSERT_SOME(llc);
+  EXPECT_DOUBLE_EQ(3000000, llc.get());
+
+  Try<double_t> localBandwidth = usage::getMbmLocalBandwidth(exec);
+  ASSERT_SOME(localBandwidth);
+  EXPECT_DOUBLE_EQ(2000, localBandwidth.get());
+
+  Try<double_t> totalBandwidth = usage::getMbmTotalBandwidth(exec);
+  ASSERT_SOME(totalBandwidth);
+  EXPECT_DOUBLE_EQ(10000, totalBandwidth.get());
+}
+
+
+/**
+ * Without resctrl filter should pass usage unchanged.
+ */
+TEST(ResctrlFilterTest, PassThroughWhenNotAvailable) {
+  MockSink<ResourceUsage> mockSink;
+  SerenityConfig config;
+  config.set(resctrl::ROOT_PATH, std::string("/not/existing/resctrl"));
+  ResctrlFilter filter(&mockSink, config);
+  MockSource<ResourceUsage> usageSource(&filter);
+  EXPECT_FALSE(filter.isAvailable());
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(RESCTRL_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usageSource.produce(usage);
+
+  ASSERT_EQ(1, mockSink.numberOfMessagesConsumed);
+  EXPECT_EQ(usage.SerializeAsString(),
+            mockSink.currentConsumedT.SerializeAsString());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
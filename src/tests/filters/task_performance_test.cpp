@@ -0,0 +1,151 @@
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "filters/task_performance.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char SLO_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+const int SLO_PR_EXECUTOR = 3;
+
+
+static TaskPerformance createTaskPerformance(
+    const std::string& taskId,
+    const std::string& sampleName,
+    double_t value) {
+  TaskPerformance performance;
+  performance.mutable_task()->set_value(taskId);
+  TaskPerformance_Sample* sample = performance.add_samples();
+  sample->set_name(sampleName);
+  sample->set_value(value);
+  return performance;
+}
+
+
+/**
+ * Latency of PR task should be attached as inverted SLO signal. PR
+ * executor without samples should be filtered out, BE executors passed.
+ */
+TEST(TaskPerformanceFilterTest, AttachSloSignal) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SLO_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+  const ResourceUsage& usage = usages.get().resource_usage(0);
+  const std::string taskId = usage.executors(SLO_PR_EXECUTOR)
+    .executor_info().executor_id().value();
+
+  std::shared_ptr<PipelineClock> clock(new UsageClock(100));
+  MockSink<ResourceUsage> mockSink;
+  TaskPerformanceFilter filter(&mockSink, SerenityConfig(), clock);
+  MockSource<ResourceUsage> usageSource(&filter);
+
+  filter.getStore()->add(createTaskPerformance(taskId, "latency", 20), 90);
+  usageSource.produce(usage);
+
+  ASSERT_EQ(1, mockSink.numberOfMessagesConsumed);
+  const ResourceUsage& product = mockSink.currentConsumedT;
+  ASSERT_EQ(4, product.executors_size());
+
+  int withSignal = 0;
+  for (const ResourceUsage_Executor& executor : product.executors()) {
+    Try<double_t> signal = usage::getSloSignal(executor);
+    if (signal.isSome()) {
+      withSignal++;
+      EXPECT_EQ(taskId, executor.executor_info().executor_id().value());
+      EXPECT_DOUBLE_EQ(0.05, signal.get());
+    }
+  }
+  EXPECT_EQ(1, withSignal);
+}
+
+
+/**
+ * Samples older than SLO_MAX_SAMPLE_AGE should be ignored and dropped.
+ */
+TEST(TaskPerformanceFilterTest, IgnoreStaleSamples) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SLO_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+  const ResourceUsage& usage = usages.get().resource_usage(0);
+  const std::string taskId = usage.executors(SLO_PR_EXECUTOR)
+    .executor_info().executor_id().value();
+
+  SerenityConfig conf;
+  conf.set(slo::MAX_SAMPLE_AGE, 30.0);
+  std::shared_ptr<PipelineClock> clock(new UsageClock(100));
+  MockSink<ResourceUsage> mockSink;
+  TaskPerformanceFilter filter(&mockSink, conf, clock);
+  MockSource<ResourceUsage> usageSource(&filter);
+
+  filter.getStore()->add(createTaskPerformance(taskId, "latency", 20), 60);
+  usageSource.produce(usage);
+
+  EXPECT_EQ(3, mockSink.currentConsumedT.executors_size());
+  EXPECT_EQ(0u, filter.getStore()->size());
+}
+
+
+/**
+ * Throughput (higher is better) should be passed as is.
+ */
+TEST(TaskPerformanceFilterTest, HigherIsBetterSample) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SLO_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+  const ResourceUsage& usage = usages.get().resource_usage(0);
+  const std::string taskId = usage.executors(SLO_PR_EXECUTOR)
+    .executor_info().executor_id().value();
+
+  SerenityConfig conf;
+  conf.set(slo::SAMPLE, std::string("throughput"));
+  conf.set(slo::LOWER_IS_BETTER, false);
+  MockSink<ResourceUsage> mockSink;
+  TaskPerformanceFilter filter(&mockSink, conf);
+  MockSource<ResourceUsage> usageSource(&filter);
+
+  TaskPerformance performance =
+    createTaskPerformance(taskId, "latency", 20);
+  TaskPerformance_Sample* throughput = performance.add_samples();
+  throughput->set_name("throughput");
+  throughput->set_value(1500);
+  filter.getStore()->add(performance, time(NULL));
+  usageSource.produce(usage);
+
+  ASSERT_EQ(4, mockSink.currentConsumedT.executors_size());
+  bool found = false;
+  for (const ResourceUsage_Executor& executor :
+         mockSink.currentConsumedT.executors()) {
+    Try<double_t> signal = usage::getSloSignal(executor);
+    if (signal.isSome()) {
+      found = true;
+      EXPECT_DOUBLE_EQ(1500, signal.get());
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -10,6 +10,8 @@
 
 #include "tests/common/mocks/mock_sink.hpp"
 #include "tests/common/sources/json_source.hpp"
+#include "tests/common/sources/mock_source.hpp"
+#include "tests/common/usage_helper.hpp"
 
 namespace mesos {
 namespace serenity {
@@ -18,6 +20,15 @@ namespace tests {
 using ::testing::DoAll;
 
 
+SerenityConfig createNoHysteresisCfg() {
+  SerenityConfig config;
+  config.set(utilization::HYSTERESIS, 0.0);
+  config.set(utilization::MIN_DWELL_ITERATIONS, (uint64_t) 0);
+  config.set(utilization::ALPHA, 1.0);
+  return config;
+}
+
+
 TEST(UtilizationThresholdFilterTest, OkLoad) {
   // End of pipeline.
   MockSink<ResourceUsage> mockSink;
@@ -25,8 +36,13 @@ TEST(UtilizationThresholdFilterTest, OkLoad) {
   EXPECT_CALL(mockSink, consume(_))
     .WillOnce(InvokeConsumeUsageCountExecutors(&mockSink, 1));
 
-  // Second component in pipeline.
-  UtilizationThresholdFilter utilizationFilter(&mockSink);
+  // Second component in pipeline. Without hysteresis, dwell time and
+  // smoothing filter reacts on every sample.
+  UtilizationThresholdFilter utilizationFilter(
+      &mockSink,
+      utilization::DEFAULT_THRESHOLD,
+      Tag(UNDEFINED, "utilizationFilter"),
+      createNoHysteresisCfg());
 
   // First component in pipeline.
   JsonSource jsonSource(&utilizationFilter);
@@ -69,6 +85,74 @@ TEST(UtilizationThresholdFilterTest, TooHighLoad) {
       "tests/fixtures/utilization_threshold/too_high_load_test.json"));
 }
 
+
+/**
+ * Oversubscription is enabled again only below low watermark and each
+ * transition needs minimum dwell iterations in current state.
+ */
+TEST(UtilizationThresholdFilterTest, HysteresisAndDwell) {
+  SerenityConfig config;
+  config.set(utilization::HYSTERESIS, 0.1);
+  config.set(utilization::MIN_DWELL_ITERATIONS, (uint64_t) 2);
+  config.set(utilization::ALPHA, 1.0);
+
+  MockSink<ResourceUsage> mockSink;
+  UtilizationThresholdFilter utilizationFilter(
+      &mockSink, 0.5, Tag(UNDEFINED, "utilizationFilter"), config);
+  MockSource<ResourceUsage> usageSource(&utilizationFilter);
+
+  // First sample - allocated (0.1 utilization) is used.
+  usageSource.produce(createSingleExecutorUsage(1, 0, 1));
+  EXPECT_EQ(1, mockSink.numberOfMessagesConsumed);
+
+  // 0.6 utilization - disable.
+  usageSource.produce(createSingleExecutorUsage(2, 6, 1));
+  EXPECT_FALSE(utilizationFilter.isOversubscriptionEnabled());
+
+  // 0.45 utilization - below high, but above low watermark.
+  usageSource.produce(createSingleExecutorUsage(3, 10.5, 1));
+  EXPECT_FALSE(utilizationFilter.isOversubscriptionEnabled());
+
+  // 0.3 utilization - below low watermark.
+  usageSource.produce(createSingleExecutorUsage(4, 13.5, 1));
+  EXPECT_TRUE(utilizationFilter.isOversubscriptionEnabled());
+  EXPECT_EQ(2, mockSink.numberOfMessagesConsumed);
+
+  // 0.6 utilization - minimum dwell time not reached yet.
+  usageSource.produce(createSingleExecutorUsage(5, 19.5, 1));
+  EXPECT_TRUE(utilizationFilter.isOversubscriptionEnabled());
+  EXPECT_EQ(3, mockSink.numberOfMessagesConsumed);
+
+  usageSource.produce(createSingleExecutorUsage(6, 25.5, 1));
+  EXPECT_FALSE(utilizationFilter.isOversubscriptionEnabled());
+  EXPECT_EQ(3, mockSink.numberOfMessagesConsumed);
+
+  EXPECT_EQ(2u, utilizationFilter.getDisabledTransitions());
+  EXPECT_EQ(1u, utilizationFilter.getEnabledTransitions());
+}
+
+
+/**
+ * Single utilization spike is smoothed out.
+ */
+TEST(UtilizationThresholdFilterTest, SmoothedUtilization) {
+  SerenityConfig config = createNoHysteresisCfg();
+  config.set(utilization::ALPHA, 0.5);
+
+  MockSink<ResourceUsage> mockSink;
+  UtilizationThresholdFilter utilizationFilter(
+      &mockSink, 0.5, Tag(UNDEFINED, "utilizationFilter"), config);
+  MockSource<ResourceUsage> usageSource(&utilizationFilter);
+
+  // 0.1 utilization.
+  usageSource.produce(createSingleExecutorUsage(1, 0, 1));
+  // 0.8 utilization spike - smoothed to 0.45.
+  usageSource.produce(createSingleExecutorUsage(2, 8, 1));
+  EXPECT_TRUE(utilizationFilter.isOversubscriptionEnabled());
+  EXPECT_EQ(2, mockSink.numberOfMessagesConsumed);
+  EXPECT_EQ(0u, utilizationFilter.getDisabledTransitions());
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
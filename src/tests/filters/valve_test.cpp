@@ -272,6 +272,85 @@ TEST(ValveFilterTest, EstimatorDisableThenEnableViaEventBus) {
 }
 
 
+TEST(ValveFilterTest, EstimatorPartialScale) {
+  // End of pipeline.
+  MockSink<ResourceUsage> mockSink;
+
+  ValveFilter valveFilter(
+    &mockSink,
+    true,
+    Tag(RESOURCE_ESTIMATOR, "valveFilter"));
+
+  // First component in pipeline.
+  MockSource<ResourceUsage> mockSource(&valveFilter);
+  EXPECT_TRUE(valveFilter.isOpened());
+  EXPECT_DOUBLE_EQ(1.0, valveFilter.getScale());
+
+  UPID upid(getValveProcessBaseName(RESOURCE_ESTIMATOR), address());
+
+  // Wrong scale should be rejected.
+  Future<http::Response> response =
+    http::post(upid, VALVE_ROUTE + "?" + PIPELINE_SCALE_KEY + "=1.5");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::BadRequest().status, response);
+  EXPECT_DOUBLE_EQ(1.0, valveFilter.getScale());
+
+  // Offer half of the slack. Estimator valve still passes every iteration
+  // - slack is scaled by the pipeline.
+  response = http::post(upid, VALVE_ROUTE + "?" + PIPELINE_SCALE_KEY + "=0.5");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  EXPECT_DOUBLE_EQ(0.5, valveFilter.getScale());
+
+  ResourceUsage usage;
+  for (int i = 0; i < 4; i++) {
+    mockSource.produce(usage);
+  }
+  EXPECT_EQ(4, mockSink.numberOfMessagesConsumed);
+
+  // Closed valve does not pass anything regardless of scale.
+  response = http::post(upid,
+                        VALVE_ROUTE + "?" + PIPELINE_ENABLE_KEY + "=false");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  EXPECT_FALSE(valveFilter.isOpened());
+
+  for (int i = 0; i < 4; i++) {
+    mockSource.produce(usage);
+  }
+  EXPECT_EQ(4, mockSink.numberOfMessagesConsumed);
+}
+
+
+TEST(ValveFilterTest, ControllerPartialScale) {
+  // End of pipeline.
+  MockSink<ResourceUsage> mockSink;
+
+  ValveFilter valveFilter(
+    &mockSink,
+    true,
+    Tag(QOS_CONTROLLER, "valveFilter"));
+
+  // First component in pipeline.
+  MockSource<ResourceUsage> mockSource(&valveFilter);
+
+  UPID upid(getValveProcessBaseName(QOS_CONTROLLER), address());
+
+  // Pass only half of iterations.
+  Future<http::Response> response =
+    http::post(upid, VALVE_ROUTE + "?" + PIPELINE_SCALE_KEY + "=0.5");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  EXPECT_DOUBLE_EQ(0.5, valveFilter.getScale());
+
+  ResourceUsage usage;
+  for (int i = 0; i < 4; i++) {
+    mockSource.produce(usage);
+  }
+  EXPECT_EQ(2, mockSink.numberOfMessagesConsumed);
+}
+
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
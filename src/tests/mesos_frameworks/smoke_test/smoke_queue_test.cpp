@@ -0,0 +1,175 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mesos/resources.hpp"
+
+#include "smoke_job.hpp"
+#include "smoke_queue.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+const size_t SMOKE_QUEUE_SELECTIONS = 4000;
+
+
+class SmokeWeightedQueueTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<SmokeJob> createJob(
+      size_t id,
+      size_t shares = 1,
+      const std::string& resources = "cpus:1") {
+    return std::shared_ptr<SmokeJob>(new SmokeJob(
+        id, "sleep 1", Resources::parse(resources).get(), 1, "job",
+        None(), None(), shares));
+  }
+
+  // Returns number of selections of each job id.
+  std::map<size_t, size_t> select(size_t count) {
+    std::map<size_t, size_t> selections;
+    for (size_t i = 0; i < count; i++) {
+      std::shared_ptr<SmokeJob> job = queue.selectJob();
+      EXPECT_NE(nullptr, job);
+      if (job != nullptr) {
+        selections[job->id]++;
+      }
+    }
+    return selections;
+  }
+
+  SmokeWeightedQueue queue;
+};
+
+
+TEST_F(SmokeWeightedQueueTest, SelectsJobsProportionallyToShares) {
+  EXPECT_EQ(nullptr, queue.selectJob());
+
+  queue.add(createJob(0, 1));
+  queue.add(createJob(1, 3));
+  EXPECT_EQ(2u, queue.size());
+  EXPECT_FALSE(queue.finished);
+
+  std::map<size_t, size_t> selections = select(SMOKE_QUEUE_SELECTIONS);
+  EXPECT_NEAR(0.75,
+              selections[1] / static_cast<double_t>(SMOKE_QUEUE_SELECTIONS),
+              0.05);
+}
+
+
+TEST_F(SmokeWeightedQueueTest, RemovedJobIsNotSelected) {
+  std::shared_ptr<SmokeJob> job0 = createJob(0);
+  std::shared_ptr<SmokeJob> job1 = createJob(1);
+  queue.add(job0);
+  queue.add(job1);
+
+  queue.remove(job0);
+  EXPECT_EQ(1u, queue.size());
+  EXPECT_EQ(0u, select(100)[0]);
+
+  queue.remove(job1);
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_TRUE(queue.finished);
+  EXPECT_FALSE(queue.hasSelectable());
+}
+
+
+TEST_F(SmokeWeightedQueueTest, SuspendedJobIsNotSelectedUntilResumed) {
+  std::shared_ptr<SmokeJob> job0 = createJob(0);
+  std::shared_ptr<SmokeJob> job1 = createJob(1);
+  queue.add(job0);
+  queue.add(job1);
+
+  // Suspending twice must not subtract shares twice.
+  queue.suspend(job0);
+  queue.suspend(job0);
+  EXPECT_TRUE(queue.hasSelectable());
+  EXPECT_EQ(0u, select(100)[0]);
+
+  queue.suspend(job1);
+  EXPECT_FALSE(queue.hasSelectable());
+  EXPECT_EQ(2u, queue.size());
+
+  queue.resumeAll();
+  EXPECT_TRUE(queue.hasSelectable());
+  std::map<size_t, size_t> selections = select(100);
+  EXPECT_LT(0u, selections[0]);
+  EXPECT_LT(0u, selections[1]);
+
+  // Removing suspended job leaves shares of the rest untouched.
+  queue.suspend(job0);
+  queue.remove(job0);
+  queue.resumeAll();
+  EXPECT_EQ(100u, select(100)[1]);
+}
+
+
+/**
+ * Growing rebuilds the tree. Job suspended before that must stay out of
+ * selection and come back only when resumed.
+ */
+TEST_F(SmokeWeightedQueueTest, GrowKeepsSuspendedJobsOut) {
+  std::vector<std::shared_ptr<SmokeJob>> jobs;
+  for (size_t id = 0; id < 16; id++) {
+    jobs.push_back(createJob(id));
+    queue.add(jobs.back());
+  }
+  queue.suspend(jobs[0]);
+
+  // Exceeds initial capacity.
+  for (size_t id = 16; id < 40; id++) {
+    jobs.push_back(createJob(id));
+    queue.add(jobs.back());
+  }
+  EXPECT_EQ(40u, queue.size());
+  EXPECT_EQ(0u, select(SMOKE_QUEUE_SELECTIONS)[0]);
+
+  for (size_t id = 1; id < jobs.size(); id++) {
+    queue.remove(jobs[id]);
+  }
+  EXPECT_FALSE(queue.hasSelectable());
+
+  queue.resumeAll();
+  ASSERT_TRUE(queue.hasSelectable());
+  EXPECT_EQ(jobs[0], queue.selectJob());
+}
+
+TEST_F(SmokeWeightedQueueTest, BestFitPacksLargestFittingJob) {
+  std::shared_ptr<SmokeJob> small = createJob(0, 1, "cpus:1;mem:128");
+  std::shared_ptr<SmokeJob> large = createJob(1, 1, "cpus:3;mem:128");
+  std::shared_ptr<SmokeJob> tooLarge = createJob(2, 10, "cpus:8;mem:128");
+  queue.add(small);
+  queue.add(large);
+  queue.add(tooLarge);
+
+  Resources remaining = Resources::parse("cpus:4;mem:1024").get();
+  EXPECT_EQ(large, queue.selectBestFit(remaining));
+
+  remaining -= large->taskResources;
+  EXPECT_EQ(small, queue.selectBestFit(remaining));
+
+  remaining -= small->taskResources;
+  EXPECT_EQ(nullptr, queue.selectBestFit(remaining));
+}
+
+
+TEST_F(SmokeWeightedQueueTest, BestFitPrefersSharesOfSimilarJobs) {
+  std::shared_ptr<SmokeJob> job0 = createJob(0, 1, "cpus:2;mem:128");
+  std::shared_ptr<SmokeJob> job1 = createJob(1, 3, "cpus:1;mem:128");
+  queue.add(job0);
+  queue.add(job1);
+
+  Resources remaining = Resources::parse("cpus:4;mem:1024").get();
+  EXPECT_EQ(job1, queue.selectBestFit(remaining));
+
+  // Suspended jobs are not packed.
+  queue.suspend(job1);
+  EXPECT_EQ(job0, queue.selectBestFit(remaining));
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -45,6 +45,19 @@ class TestCorrectionPipeline : public QoSControllerPipeline {
   }
 };
 
+class EmptyCorrectionPipeline : public QoSControllerPipeline {
+ public:
+  EmptyCorrectionPipeline() : runs(0) {}
+
+  virtual Result<QoSCorrections> run(const ResourceUsage& _product) {
+    this->runs++;
+    return QoSCorrections();
+  }
+
+  uint32_t runs;
+};
+
+
 /**
  * This tests checks the interface.
  */
@@ -73,6 +86,38 @@ TEST(SerenityControllerTest, PipelineIntegration) {
   EXPECT_EQ("Framework1", result.get().front().kill().framework_id().value());
 }
 
+
+/**
+ * With UsageClock retries on empty corrections do not wait for real time,
+ * so usage can be replayed faster than real time.
+ */
+TEST(SerenityControllerTest, EmptyCorrectionsWithUsageClock) {
+  std::shared_ptr<EmptyCorrectionPipeline> pipeline(
+      new EmptyCorrectionPipeline());
+  Try<QoSController*> qoSController =
+    serenity::SerenityController::create(
+        pipeline,
+        3600,
+        std::shared_ptr<PipelineClock>(new UsageClock()));
+  ASSERT_SOME(qoSController);
+
+  QoSController* controller = qoSController.get();
+
+  MockSlaveUsage usage(
+      "tests/fixtures/baseline_smoke_test_resource_usage.json");
+
+  Try<Nothing> initialize = controller->initialize(
+      lambda::bind(&MockSlaveUsage::usage, &usage));
+
+  process::Future<list<QoSCorrection>> result = controller->corrections();
+
+  AWAIT_READY(result);
+
+  EXPECT_EQ(0u, result.get().size());
+  // First run and 20 retries.
+  EXPECT_EQ(21u, pipeline->runs);
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
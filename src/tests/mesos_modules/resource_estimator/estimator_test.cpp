@@ -1,4 +1,5 @@
 #include <list>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -10,6 +11,7 @@
 
 #include "stout/gtest.hpp"
 
+#include "process/clock.hpp"
 #include "process/gtest.hpp"
 
 #include "tests/common/usage_helper.hpp"
@@ -32,6 +34,35 @@ class TestEstimationPipeline : public ResourceEstimatorPipeline {
 };
 
 
+class CountingEstimationPipeline : public TestEstimationPipeline {
+ public:
+  CountingEstimationPipeline() : runs(0) {}
+
+  virtual Result<Resources> run(const ResourceUsage& _product) {
+    runs++;
+    return TestEstimationPipeline::run(_product);
+  }
+
+  int runs;
+};
+
+
+static Resource createRevocableCpus(const std::string& cpus) {
+  Resource resource = Resources::parse("cpus", cpus, "*").get();
+  resource.mutable_revocable();
+  return resource;
+}
+
+
+class RevocableEstimationPipeline : public CountingEstimationPipeline {
+ public:
+  virtual Result<Resources> run(const ResourceUsage& _product) {
+    runs++;
+    return Resources(createRevocableCpus("16"));
+  }
+};
+
+
 /**
  * This tests checks the interface.
  */
@@ -62,6 +93,125 @@ TEST(SerenityEstimatorTest, PipelineIntegration) {
   }
 }
 
+
+/**
+ * Without background estimation, estimator should run the pipeline only
+ * when cached slack is older than max staleness.
+ */
+TEST(SerenityEstimatorTest, CachedSlackStaleness) {
+  process::Clock::pause();
+
+  std::shared_ptr<CountingEstimationPipeline> pipeline(
+    new CountingEstimationPipeline());
+
+  Try<ResourceEstimator*> resourceEstimator =
+    serenity::SerenityEstimator::create(
+      pipeline, Duration::zero(), Seconds(10));
+  ASSERT_SOME(resourceEstimator);
+
+  ResourceEstimator* estimator = resourceEstimator.get();
+
+  MockSlaveUsage usage(
+      "tests/fixtures/baseline_smoke_test_resource_usage.json");
+
+  ASSERT_SOME(estimator->initialize(
+      lambda::bind(&MockSlaveUsage::usage, &usage)));
+
+  AWAIT_READY(estimator->oversubscribable());
+  EXPECT_EQ(1, pipeline->runs);
+
+  // Fresh slack is served from cache.
+  process::Clock::advance(Seconds(5));
+  AWAIT_READY(estimator->oversubscribable());
+  EXPECT_EQ(1, pipeline->runs);
+
+  // Stale slack is estimated again.
+  process::Clock::advance(Seconds(6));
+  AWAIT_READY(estimator->oversubscribable());
+  EXPECT_EQ(2, pipeline->runs);
+
+  delete estimator;
+  process::Clock::resume();
+}
+
+
+/**
+ * Background estimation should refresh slack every estimation interval,
+ * independently of oversubscribable() calls.
+ */
+TEST(SerenityEstimatorTest, BackgroundEstimation) {
+  process::Clock::pause();
+
+  std::shared_ptr<CountingEstimationPipeline> pipeline(
+    new CountingEstimationPipeline());
+
+  Try<ResourceEstimator*> resourceEstimator =
+    serenity::SerenityEstimator::create(pipeline, Seconds(1), Seconds(10));
+  ASSERT_SOME(resourceEstimator);
+
+  ResourceEstimator* estimator = resourceEstimator.get();
+
+  MockSlaveUsage usage(
+      "tests/fixtures/baseline_smoke_test_resource_usage.json");
+
+  ASSERT_SOME(estimator->initialize(
+      lambda::bind(&MockSlaveUsage::usage, &usage)));
+
+  process::Clock::settle();
+  EXPECT_EQ(1, pipeline->runs);
+
+  // Slack estimated in background is served without running pipeline.
+  AWAIT_READY(estimator->oversubscribable());
+  EXPECT_EQ(1, pipeline->runs);
+
+  process::Clock::advance(Seconds(1));
+  process::Clock::settle();
+  EXPECT_EQ(2, pipeline->runs);
+
+  delete estimator;
+  process::Clock::resume();
+}
+
+/**
+ * Cached slack should be reduced by revocable resources allocated after
+ * it was estimated.
+ */
+TEST(SerenityEstimatorTest, CachedSlackReducedByAllocation) {
+  process::Clock::pause();
+
+  std::shared_ptr<RevocableEstimationPipeline> pipeline(
+    new RevocableEstimationPipeline());
+
+  Try<ResourceEstimator*> resourceEstimator =
+    serenity::SerenityEstimator::create(
+      pipeline, Duration::zero(), Seconds(10));
+  ASSERT_SOME(resourceEstimator);
+
+  ResourceEstimator* estimator = resourceEstimator.get();
+
+  ResourceUsage usage;
+  ResourceUsage_Executor* executor = usage.add_executors();
+  executor->mutable_executor_info()->mutable_executor_id()->set_value("be");
+
+  ASSERT_SOME(estimator->initialize(
+      [&usage]() { return process::Future<ResourceUsage>(usage); }));
+
+  process::Future<Resources> slack = estimator->oversubscribable();
+  AWAIT_READY(slack);
+  EXPECT_SOME_EQ(16.0, slack.get().revocable().cpus());
+
+  // BE task is launched on part of the slack.
+  executor->add_allocated()->CopyFrom(createRevocableCpus("4"));
+
+  slack = estimator->oversubscribable();
+  AWAIT_READY(slack);
+  EXPECT_EQ(1, pipeline->runs);
+  EXPECT_SOME_EQ(12.0, slack.get().revocable().cpus());
+
+  delete estimator;
+  process::Clock::resume();
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
@@ -0,0 +1,79 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+#include "mesos/resources.hpp"
+
+#include "observers/memory_slack.hpp"
+
+#include "stout/bytes.hpp"
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors with 160 MB memory limit and
+// 67.7 MB RSS each.
+const char MEMORY_SLACK_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+/**
+ * Slack is memory limit reduced by RSS and safety margin (10%).
+ */
+TEST(MemorySlackObserverTest, SlackFromUnusedMemory) {
+  MockSink<Resources> mockSink;
+  MemorySlackObserver observer(&mockSink);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  usageSource.produce(createUsageWithTotalMem(MEMORY_SLACK_FIXTURE, "1024"));
+
+  ASSERT_EQ(1, mockSink.numberOfMessagesConsumed);
+  Resources slack = mockSink.currentConsumedT;
+  ASSERT_SOME(slack.mem());
+  EXPECT_NEAR(381.52, slack.mem().get().bytes() / Megabytes(1).bytes(), 0.01);
+  EXPECT_EQ(slack, slack.revocable());
+  EXPECT_NONE(slack.cpus());
+}
+
+
+/**
+ * Slack is capped by max oversubscription fraction of total memory.
+ */
+TEST(MemorySlackObserverTest, MaxOversubscriptionFraction) {
+  MockSink<Resources> mockSink;
+  MemorySlackObserver observer(&mockSink);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  usageSource.produce(createUsageWithTotalMem(MEMORY_SLACK_FIXTURE, "512"));
+
+  ASSERT_SOME(mockSink.currentConsumedT.mem());
+  EXPECT_NEAR(71.12,
+              mockSink.currentConsumedT.mem().get().bytes() /
+                Megabytes(1).bytes(),
+              0.01);
+}
+
+
+/**
+ * Observer needs Agent's total memory.
+ */
+TEST(MemorySlackObserverTest, NoTotalMemory) {
+  MockSink<Resources> mockSink;
+  MemorySlackObserver observer(&mockSink);
+
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(MEMORY_SLACK_FIXTURE);
+  ASSERT_SOME(usages);
+
+  EXPECT_ERROR(observer.consume(usages.get().resource_usage(0)));
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -1,17 +1,28 @@
+#include "bus/event_bus.hpp"
+
 #include "gmock/gmock.h"
 
 #include "mesos/mesos.hpp"
 #include "mesos/resources.hpp"
 
+#include "filters/executor_age.hpp"
+
+#include "observers/qos_correction.hpp"
 #include "observers/slack_resource.hpp"
 
+#include "process/clock.hpp"
+
+#include "stout/gtest.hpp"
 #include "stout/try.hpp"
 #include "stout/nothing.hpp"
 
+#include "serenity/config.hpp"
 #include "serenity/math_utils.hpp"
 
 #include "tests/common/sources/json_source.hpp"
 #include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+#include "tests/common/usage_helper.hpp"
 
 namespace mesos {
 namespace serenity {
@@ -82,6 +93,162 @@ TEST(SlackResourceObserver, MaxOversubscriptionFraction) {
 }
 
 
+TEST(SlackResourceObserver, GraduatedSlackScale) {
+  MockSink<Resources> mockSink;
+  SlackResourceObserver observer(&mockSink);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  // First sample - no slack.
+  usageSource.produce(createSingleExecutorUsage(1, 1, None(), 4));
+  usageSource.produce(createSingleExecutorUsage(2, 2, None(), 4));
+  ASSERT_SOME(mockSink.currentConsumedT.cpus());
+  EXPECT_NEAR(3.0, mockSink.currentConsumedT.cpus().get(), 0.0001);
+
+  // Contention - scale slack to half.
+  StaticEventBus::publishSlackScaleEvent(0.5, "testObserver");
+
+  // Wait for libprocess queue to be processed.
+  process::Clock::pause();
+  process::Clock::settle();
+
+  usageSource.produce(createSingleExecutorUsage(3, 3, None(), 4));
+  EXPECT_NEAR(0.5, observer.getSlackScale(), 0.0001);
+  EXPECT_NEAR(1.5, mockSink.currentConsumedT.cpus().get(), 0.0001);
+
+  // Contention is gone - slack recovers by 0.1 per iteration.
+  StaticEventBus::publishSlackScaleEvent(1.0, "testObserver");
+
+  process::Clock::pause();
+  process::Clock::settle();
+
+  usageSource.produce(createSingleExecutorUsage(4, 4, None(), 4));
+  EXPECT_NEAR(0.6, observer.getSlackScale(), 0.0001);
+  EXPECT_NEAR(1.8, mockSink.currentConsumedT.cpus().get(), 0.0001);
+
+  usageSource.produce(createSingleExecutorUsage(5, 5, None(), 4));
+  EXPECT_NEAR(0.7, observer.getSlackScale(), 0.0001);
+  EXPECT_NEAR(2.1, mockSink.currentConsumedT.cpus().get(), 0.0001);
+
+  // Clear Clock.
+  process::Clock::resume();
+}
+
+
+/**
+ * Memory slack is not offered during MEMORY contention, CPU slack is only
+ * scaled by its severity.
+ */
+TEST(SlackResourceObserver, NoMemorySlackDuringMemoryContention) {
+  MockSink<Resources> mockSink;
+  SlackResourceObserver observer(&mockSink);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  usageSource.produce(createSingleExecutorUsage(1, 1, None(), 4));
+  EXPECT_NEAR(1.0, observer.getMemorySlackScale(), 0.0001);
+
+  StaticEventBus::publishSlackScaleEvent(0.8, "memoryObserver", true);
+
+  process::Clock::pause();
+  process::Clock::settle();
+
+  usageSource.produce(createSingleExecutorUsage(2, 2, None(), 4));
+  EXPECT_NEAR(0.8, observer.getSlackScale(), 0.0001);
+  EXPECT_NEAR(0.0, observer.getMemorySlackScale(), 0.0001);
+
+  // Contention is gone - memory slack recovers by 0.1 per iteration.
+  StaticEventBus::publishSlackScaleEvent(1.0, "memoryObserver");
+
+  process::Clock::settle();
+
+  usageSource.produce(createSingleExecutorUsage(3, 3, None(), 4));
+  EXPECT_NEAR(0.9, observer.getSlackScale(), 0.0001);
+  EXPECT_NEAR(0.1, observer.getMemorySlackScale(), 0.0001);
+
+  process::Clock::resume();
+}
+
+
+/**
+ * QoS observer destroyed during contention must not keep slack throttled.
+ */
+TEST(SlackResourceObserver, DestroyedQoSObserverRestoresSlack) {
+  MockSink<Resources> mockSink;
+  SlackResourceObserver observer(&mockSink);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  Try<FixtureResourceUsage> usages =
+    JsonUsage::ReadJson("tests/fixtures/qos/average_usage.json");
+  ASSERT_SOME(usages);
+
+  process::Clock::pause();
+  {
+    MockSink<QoSCorrections> correctionSink;
+    ExecutorAgeFilter age;
+    QoSCorrectionObserver qosObserver(
+        &correctionSink, &age, new SeniorityStrategy(SerenityConfig()));
+    age.addConsumer(&qosObserver);
+    MockSource<ResourceUsage> qosUsageSource(&age);
+    MockSource<Contentions> contentionSource(&qosObserver);
+
+    qosUsageSource.produce(usages.get().resource_usage(0));
+
+    // Contention with unknown severity stops offering slack.
+    Contention contention;
+    contention.set_type(Contention_Type_CPU);
+    contentionSource.produce({contention});
+
+    process::Clock::settle();
+    usageSource.produce(createSingleExecutorUsage(1, 1, None(), 4));
+    EXPECT_NEAR(0.0, observer.getSlackScale(), 0.0001);
+  }
+
+  process::Clock::settle();
+  for (double_t timestamp = 2; timestamp <= 11; timestamp++) {
+    usageSource.produce(
+        createSingleExecutorUsage(timestamp, timestamp, None(), 4));
+  }
+  EXPECT_NEAR(1.0, observer.getSlackScale(), 0.0001);
+
+  process::Clock::resume();
+}
+
+
+/**
+ * In PERCENTILE mode single quiet sample should not increase slack.
+ */
+TEST(SlackResourceObserver, PercentileSlack) {
+  SerenityConfig conf;
+  conf.set(slack_observer::MODE,
+           std::string(slack_observer::PERCENTILE_MODE));
+
+  MockSink<Resources> instantaneousSink;
+  SlackResourceObserver instantaneousObserver(&instantaneousSink);
+  MockSource<ResourceUsage> instantaneousSource(&instantaneousObserver);
+
+  MockSink<Resources> percentileSink;
+  SlackResourceObserver percentileObserver(
+    &percentileSink,
+    slack_observer::DEFAULT_MAX_OVERSUBSCRIPTION_FRACTION,
+    slack_observer::DEFAULT_SLACK_SCALE_RECOVERY_STEP,
+    conf);
+  MockSource<ResourceUsage> percentileSource(&percentileObserver);
+
+  // Executor uses 1 CPU for few iterations.
+  for (int i = 1; i <= 6; i++) {
+    instantaneousSource.produce(createSingleExecutorUsage(i, i, None(), 4));
+    percentileSource.produce(createSingleExecutorUsage(i, i, None(), 4));
+  }
+  EXPECT_NEAR(3.0, instantaneousSink.currentConsumedT.cpus().get(), 0.0001);
+  EXPECT_NEAR(3.0, percentileSink.currentConsumedT.cpus().get(), 0.05);
+
+  // Quiet sample - only 0.1 CPU used.
+  instantaneousSource.produce(createSingleExecutorUsage(7, 6.1, None(), 4));
+  percentileSource.produce(createSingleExecutorUsage(7, 6.1, None(), 4));
+  EXPECT_NEAR(3.9, instantaneousSink.currentConsumedT.cpus().get(), 0.0001);
+  EXPECT_NEAR(3.0, percentileSink.currentConsumedT.cpus().get(), 0.05);
+}
+
+
 }  //  namespace tests
 }  //  namespace serenity
 }  //  namespace mesos
@@ -0,0 +1,133 @@
+#include "filters/executor_age.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "observers/strategies/bandwidth.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char BANDWIDTH_STRATEGY_FIXTURE[] =
+  "tests/fixtures/qos/average_usage.json";
+
+
+// Sets already sampled (per second) network counters.
+static void setNetworkBytes(uint64_t sent, ResourceUsage_Executor* executor) {
+  executor->mutable_statistics()->set_timestamp(1);
+  executor->mutable_statistics()->set_net_rx_bytes(0);
+  executor->mutable_statistics()->set_net_tx_bytes(sent);
+}
+
+
+/**
+ * Strategy should revoke the heaviest BE network consumers first, until
+ * bandwidth given by severity is recovered. PR executors are never
+ * revoked.
+ */
+TEST(BandwidthStrategyTest, RevokeHeaviestConsumers) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(BANDWIDTH_STRATEGY_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+
+  setNetworkBytes(20e6, usage.mutable_executors(0));
+  setNetworkBytes(60e6, usage.mutable_executors(1));
+  setNetworkBytes(50e6, usage.mutable_executors(2));
+  setNetworkBytes(100e6, usage.mutable_executors(3));
+
+  SerenityConfig conf;
+  conf.set(detector::MAX_BANDWIDTH, 200e6);
+  BandwidthStrategy strategy(conf, Contention_Type_NETWORK);
+  ExecutorAgeFilter age;
+
+  // 0.5 * 200 MB/s = 100 MB/s to recover.
+  Contentions contentions;
+  contentions.push_back(createContention(0.5, Contention_Type_NETWORK));
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, contentions, usage);
+  ASSERT_SOME(corrections);
+
+  ASSERT_EQ(2u, corrections.get().size());
+  EXPECT_EQ(usage.executors(1).executor_info().executor_id().value(),
+            corrections.get().front().kill().executor_id().value());
+  EXPECT_EQ(usage.executors(2).executor_info().executor_id().value(),
+            corrections.get().back().kill().executor_id().value());
+}
+
+
+/**
+ * Contentions of other types should be ignored.
+ */
+TEST(BandwidthStrategyTest, OtherContentionTypeIgnored) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(BANDWIDTH_STRATEGY_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  setNetworkBytes(60e6, usage.mutable_executors(1));
+
+  SerenityConfig conf;
+  conf.set(detector::MAX_BANDWIDTH, 200e6);
+  BandwidthStrategy strategy(conf, Contention_Type_NETWORK);
+  ExecutorAgeFilter age;
+
+  Contentions contentions;
+  contentions.push_back(createContention(0.5, Contention_Type_IO));
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, contentions, usage);
+  ASSERT_SOME(corrections);
+
+  EXPECT_TRUE(corrections.get().empty());
+}
+
+/**
+ * Without MAX_BANDWIDTH of the node strategy does not know how much to
+ * recover, so nothing is revoked.
+ */
+TEST(BandwidthStrategyTest, NoMaxBandwidthNoRevocation) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(BANDWIDTH_STRATEGY_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  setNetworkBytes(60e6, usage.mutable_executors(1));
+
+  BandwidthStrategy strategy(SerenityConfig(), Contention_Type_NETWORK);
+  ExecutorAgeFilter age;
+
+  Contentions contentions;
+  contentions.push_back(createContention(0.5, Contention_Type_NETWORK));
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, contentions, usage);
+  ASSERT_SOME(corrections);
+
+  EXPECT_TRUE(corrections.get().empty());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
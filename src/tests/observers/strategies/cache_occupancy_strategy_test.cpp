@@ -1,12 +1,20 @@
+#include "filters/executor_age.hpp"
+
 #include "gmock/gmock.h"
 
 #include "mesos/mesos.hpp"
 #include "mesos/resources.hpp"
 
 #include "observers/slack_resource.hpp"
+#include "observers/strategies/cache_occupancy.hpp"
 
+#include "serenity/data_utils.hpp"
 #include "serenity/math_utils.hpp"
 
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+
 namespace mesos {
 namespace serenity {
 namespace tests {
@@ -33,6 +41,65 @@ ACTION_P(BasicTestAction, check) {
   return Nothing();
 }
 
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char CACHE_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+/**
+ * Strategy should revoke BE executors with LLC occupancy above the mean
+ * (and minimal occupancy) using occupancy attached as derived metric
+ * (e.g. by ResctrlFilter), without CMT enabled Mesos build.
+ */
+TEST(CacheOccupancyStrategyTest, RevokeAboveMeanOccupancy) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(CACHE_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(2000000, usage.mutable_executors(1));
+  usage::setLlcOccupancy(500000, usage.mutable_executors(2));
+  // PR executors should not be taken into account.
+  usage::setLlcOccupancy(9000000, usage.mutable_executors(3));
+
+  ExecutorAgeFilter age;
+  CacheOccupancyStrategy strategy;
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, Contentions(), usage);
+  ASSERT_SOME(corrections);
+
+  ASSERT_EQ(1u, corrections.get().size());
+  EXPECT_EQ(usage.executors(0).executor_info().executor_id().value(),
+            corrections.get().front().kill().executor_id().value());
+}
+
+
+/**
+ * Strategy should not revoke anything when LLC occupancy is not available.
+ */
+TEST(CacheOccupancyStrategyTest, NoOccupancyData) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(CACHE_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ExecutorAgeFilter age;
+  CacheOccupancyStrategy strategy;
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, Contentions(), usages.get().resource_usage(0));
+  ASSERT_SOME(corrections);
+
+  EXPECT_TRUE(corrections.get().empty());
+}
+
 }  //  namespace tests
 }  //  namespace serenity
 }  //  namespace mesos
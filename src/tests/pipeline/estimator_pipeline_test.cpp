@@ -5,7 +5,10 @@
 #include "mesos/resources.hpp"
 
 #include "process/clock.hpp"
+#include "process/future.hpp"
 #include "process/gtest.hpp"
+#include "process/http.hpp"
+#include "process/pid.hpp"
 
 #include "pipeline/estimator_pipeline.hpp"
 
@@ -60,6 +63,35 @@ TEST(EstimatorPipelineTest, NoSlack) {
   delete pipeline;
 }
 
+
+/**
+ * Partial estimation scales the slack offered in every iteration instead
+ * of skipping iterations (which would offer no slack at all).
+ */
+TEST(EstimatorPipelineTest, ValveScalesSlack) {
+  CpuEstimatorPipeline pipeline(0);
+
+  process::UPID upid(
+      getValveProcessBaseName(RESOURCE_ESTIMATOR), process::address());
+  process::Future<process::http::Response> response = process::http::post(
+      upid, VALVE_ROUTE + "?" + PIPELINE_SCALE_KEY + "=0.5");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(process::http::OK().status, response);
+
+  // First samples - executor CPU usage is not known yet.
+  pipeline.run(createSingleExecutorUsage(1, 1, 4, 4));
+  pipeline.run(createSingleExecutorUsage(2, 2, 4, 4));
+
+  // Executor uses 1 of 4 CPUs - half of 3 CPUs is offered every time.
+  for (int i = 3; i < 6; i++) {
+    Result<Resources> slack =
+      pipeline.run(createSingleExecutorUsage(i, i, 4, 4));
+    ASSERT_SOME(slack);
+    ASSERT_SOME(slack.get().cpus());
+    EXPECT_NEAR(1.5, slack.get().cpus().get(), 0.0001);
+  }
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
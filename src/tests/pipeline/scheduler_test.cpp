@@ -0,0 +1,180 @@
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "pipeline/scheduler.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/serenity.hpp"
+
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+const double_t SCHEDULER_DEADLINE = 1.0;
+
+
+/**
+ * Sink which consumption takes given time on the fake clock.
+ */
+class SlowSink : public Consumer<ResourceUsage> {
+ public:
+  SlowSink(double_t* _time, double_t _cost)
+    : time(_time), cost(_cost), consumed(0) {}
+
+  Try<Nothing> consume(const ResourceUsage& in) override {
+    *this->time += this->cost;
+    this->consumed++;
+    return Nothing();
+  }
+
+  double_t* time;
+  const double_t cost;
+  int consumed;
+};
+
+
+class PipelineSchedulerTest : public ::testing::Test {
+ protected:
+  PipelineSchedulerTest() : time(0) {}
+
+  PipelineScheduler createScheduler() {
+    SerenityConfig conf;
+    conf.set(pipeline_scheduler::DEADLINE, SCHEDULER_DEADLINE);
+    double_t* clock = &this->time;
+    return PipelineScheduler(conf, Tag(QOS_CONTROLLER, "test"), [clock]() {
+      return *clock;
+    });
+  }
+
+  double_t time;
+};
+
+
+/**
+ * Best effort consumer consumes only when deferred work is run - after
+ * critical consumers.
+ */
+TEST_F(PipelineSchedulerTest, BestEffortAfterCritical) {
+  PipelineScheduler scheduler = createScheduler();
+  MockSink<ResourceUsage> critical;
+  MockSink<ResourceUsage> bestEffort;
+  MockSource<ResourceUsage> usageSource(&critical);
+  usageSource.addBestEffortConsumer(&bestEffort, &scheduler, "exporter");
+
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+  EXPECT_EQ(1, critical.numberOfMessagesConsumed);
+  EXPECT_EQ(0, bestEffort.numberOfMessagesConsumed);
+
+  scheduler.runDeferred();
+  EXPECT_EQ(1, bestEffort.numberOfMessagesConsumed);
+  EXPECT_EQ(1u, scheduler.getStats().at("exporter").executed);
+  EXPECT_EQ(0u, scheduler.getStats().at("exporter").skipped);
+}
+
+
+/**
+ * Best effort work is skipped when critical consumers used the whole
+ * iteration or when its average cost does not fit before the deadline.
+ */
+TEST_F(PipelineSchedulerTest, SkipWhenDeadlineAtRisk) {
+  PipelineScheduler scheduler = createScheduler();
+  SlowSink bestEffort(&this->time, 0.4);
+  MockSource<ResourceUsage> usageSource;
+  usageSource.addBestEffortConsumer(&bestEffort, &scheduler, "exporter");
+
+  // Critical part missed the deadline.
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+  this->time += 1.5;
+  scheduler.runDeferred();
+  EXPECT_EQ(0, bestEffort.consumed);
+  EXPECT_EQ(1u, scheduler.missedDeadlines());
+
+  // Plenty of time - cost of the consumer is learned.
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+  this->time += 0.1;
+  scheduler.runDeferred();
+  EXPECT_EQ(1, bestEffort.consumed);
+
+  // 0.3 s is left, consumer takes 0.4 s on average.
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+  this->time += 0.7;
+  scheduler.runDeferred();
+  EXPECT_EQ(1, bestEffort.consumed);
+
+  const DeferredWorkStats& stats = scheduler.getStats().at("exporter");
+  EXPECT_EQ(1u, stats.executed);
+  EXPECT_EQ(2u, stats.skipped);
+  EXPECT_DOUBLE_EQ(0.4, stats.averageCost());
+  EXPECT_EQ(3u, scheduler.iterations());
+  EXPECT_EQ(1u, scheduler.missedDeadlines());
+}
+
+
+/**
+ * Work which was not run in its iteration is dropped.
+ */
+TEST_F(PipelineSchedulerTest, OutdatedWorkSkipped) {
+  PipelineScheduler scheduler = createScheduler();
+  MockSink<ResourceUsage> bestEffort;
+  MockSource<ResourceUsage> usageSource;
+  usageSource.addBestEffortConsumer(&bestEffort, &scheduler, "exporter");
+
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+
+  scheduler.startIteration();
+  scheduler.runDeferred();
+
+  EXPECT_EQ(0, bestEffort.numberOfMessagesConsumed);
+  EXPECT_EQ(1u, scheduler.getStats().at("exporter").skipped);
+}
+
+/**
+ * Consumer which average cost never fits is run after MAX_CONSECUTIVE_SKIPS
+ * skips, so its cost estimate is refreshed.
+ */
+TEST_F(PipelineSchedulerTest, RunAfterConsecutiveSkips) {
+  SerenityConfig conf;
+  conf.set(pipeline_scheduler::DEADLINE, SCHEDULER_DEADLINE);
+  conf.set(pipeline_scheduler::MAX_CONSECUTIVE_SKIPS, (uint64_t) 2);
+  double_t* clock = &this->time;
+  PipelineScheduler scheduler(conf, Tag(QOS_CONTROLLER, "test"), [clock]() {
+    return *clock;
+  });
+
+  SlowSink bestEffort(&this->time, 0.8);
+  MockSource<ResourceUsage> usageSource;
+  usageSource.addBestEffortConsumer(&bestEffort, &scheduler, "exporter");
+
+  // Cost of the consumer is learned.
+  scheduler.startIteration();
+  usageSource.produce(ResourceUsage());
+  scheduler.runDeferred();
+  EXPECT_EQ(1, bestEffort.consumed);
+
+  // Only 0.5 s is left in each iteration.
+  for (int i = 0; i < 3; i++) {
+    scheduler.startIteration();
+    usageSource.produce(ResourceUsage());
+    this->time += 0.5;
+    scheduler.runDeferred();
+  }
+
+  const DeferredWorkStats& stats = scheduler.getStats().at("exporter");
+  EXPECT_EQ(2, bestEffort.consumed);
+  EXPECT_EQ(2u, stats.executed);
+  EXPECT_EQ(2u, stats.skipped);
+  EXPECT_EQ(0u, stats.consecutiveSkips);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,290 @@
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bus/event_bus.hpp"
+
+#include "filters/valve.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/resources.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "pipeline/qos_pipeline.hpp"
+#include "pipeline/shadow_pipelines.hpp"
+
+#include "process/clock.hpp"
+#include "process/future.hpp"
+#include "process/gtest.hpp"
+#include "process/http.hpp"
+#include "process/pid.hpp"
+#include "process/process.hpp"
+
+#include "stout/gtest.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+static ExecutorInfo createExecutorInfo(const std::string& executorId) {
+  ExecutorInfo executorInfo;
+  executorInfo.mutable_framework_id()->set_value("Framework1");
+  executorInfo.mutable_executor_id()->set_value(executorId);
+  return executorInfo;
+}
+
+
+/**
+ * Pipeline which kills given executors every iteration.
+ */
+class KillingPipeline : public QoSControllerPipeline {
+ public:
+  explicit KillingPipeline(const std::list<std::string>& _executorIds)
+    : executorIds(_executorIds), runs(0) {}
+
+  Result<QoSCorrections> run(const ResourceUsage& _product) override {
+    this->runs++;
+
+    QoSCorrections corrections;
+    for (const std::string& executorId : this->executorIds) {
+      corrections.push_back(
+        createKillQosCorrection(createExecutorInfo(executorId)));
+    }
+    return corrections;
+  }
+
+  const std::list<std::string> executorIds;
+  uint32_t runs;
+};
+
+
+TEST(ShadowQoSPipelinesTest, CompareWithLiveCorrections) {
+  std::shared_ptr<KillingPipeline> same(
+      new KillingPipeline(std::list<std::string>{"Executor1"}));
+  std::shared_ptr<KillingPipeline> different(
+      new KillingPipeline(std::list<std::string>{"Executor1", "Executor2"}));
+  std::shared_ptr<KillingPipeline> silent(
+      new KillingPipeline(std::list<std::string>{}));
+
+  ShadowQoSPipelines shadows(1000);
+  shadows.add("same", same);
+  shadows.add("different", different);
+  shadows.add("silent", silent);
+  ASSERT_EQ(3u, shadows.size());
+
+  KillingPipeline live(std::list<std::string>{"Executor1"});
+  ResourceUsage usage;
+  for (int i = 0; i < 2; i++) {
+    Result<QoSCorrections> liveCorrections = live.run(usage);
+    ASSERT_SOME(liveCorrections);
+    shadows.run(usage, liveCorrections.get(), 0);
+  }
+
+  EXPECT_EQ("same", shadows.getName(0));
+  EXPECT_EQ(2u, shadows.getStats(0).iterations);
+  EXPECT_EQ(2u, shadows.getStats(0).agreed);
+  EXPECT_EQ(0u, shadows.getStats(0).shadowOnly);
+  EXPECT_EQ(0u, shadows.getStats(0).liveOnly);
+
+  EXPECT_EQ(4u, shadows.getStats(1).corrections);
+  EXPECT_EQ(2u, shadows.getStats(1).agreed);
+  EXPECT_EQ(2u, shadows.getStats(1).shadowOnly);
+  EXPECT_EQ(0u, shadows.getStats(1).liveOnly);
+
+  EXPECT_EQ(0u, shadows.getStats(2).corrections);
+  EXPECT_EQ(2u, shadows.getStats(2).liveOnly);
+}
+
+
+TEST(ShadowQoSPipelinesTest, SkipWhenBudgetExceeded) {
+  std::shared_ptr<KillingPipeline> shadow(
+      new KillingPipeline(std::list<std::string>{"Executor1"}));
+
+  ShadowQoSPipelines shadows(0.5);
+  shadows.add("shadow", shadow);
+
+  ResourceUsage usage;
+  // Live pipeline used the whole budget.
+  shadows.run(usage, QoSCorrections(), 0.5);
+  EXPECT_EQ(0u, shadow->runs);
+  EXPECT_EQ(1u, shadows.getStats(0).skipped);
+
+  shadows.run(usage, QoSCorrections(), 0.1);
+  EXPECT_EQ(1u, shadow->runs);
+  EXPECT_EQ(1u, shadows.getStats(0).iterations);
+  EXPECT_EQ(1u, shadows.getStats(0).skipped);
+  EXPECT_LE(shadows.getStats(0).averageCost(), shadows.getStats(0).maxCost);
+}
+
+
+/**
+ * All live iterations of one corrections call share one budget.
+ */
+TEST(ShadowQoSPipelinesTest, SharedBudgetForCorrectionsCall) {
+  std::shared_ptr<KillingPipeline> shadow(
+      new KillingPipeline(std::list<std::string>{"Executor1"}));
+
+  ShadowQoSPipelines shadows(0.5);
+  shadows.add("shadow", shadow);
+
+  std::vector<LiveIteration> liveIterations(3);
+  shadows.run(liveIterations, 0.1);
+  EXPECT_EQ(3u, shadow->runs);
+  EXPECT_EQ(3u, shadows.getStats(0).iterations);
+  EXPECT_EQ(3u, shadows.getStats(0).shadowOnly);
+
+  // Live pipeline used the whole budget in its iterations.
+  shadows.run(liveIterations, 0.5);
+  EXPECT_EQ(3u, shadow->runs);
+  EXPECT_EQ(3u, shadows.getStats(0).skipped);
+}
+
+
+TEST(ShadowQoSPipelinesTest, ShadowConfigOverrides) {
+  SerenityConfig live;
+  live.set(ema::ALPHA_CPU, (double_t) 0.9);
+  live[SIGNAL_DROP_ANALYZER_NAME].set(detector::WINDOW_SIZE, (uint64_t) 10);
+
+  Try<SerenityConfig> parsed = createShadowQoSPipelineConfig(
+      live,
+      "AssuranceDropAnalyzer.WINDOW_SIZE=16, ALPHA_CPU=0.5,"
+      "A.B.KEY=-1,VALVE_OPENED=false,PATH=/tmp/x");
+  ASSERT_SOME(parsed);
+  SerenityConfig shadow = parsed.get();
+
+  EXPECT_TRUE(shadow.getB(qos_pipeline::SHADOW_MODE));
+  EXPECT_EQ(16u, shadow[SIGNAL_DROP_ANALYZER_NAME].getU64(
+      detector::WINDOW_SIZE));
+  EXPECT_NEAR(0.5, shadow.getD(ema::ALPHA_CPU), 0.0001);
+  EXPECT_EQ(-1, shadow["A"]["B"].getI64("KEY"));
+  EXPECT_FALSE(shadow.getB(qos_pipeline::VALVE_OPENED));
+  EXPECT_EQ("/tmp/x", shadow.getS("PATH"));
+
+  // Live configuration stays untouched.
+  EXPECT_NEAR(0.9, live.getD(ema::ALPHA_CPU), 0.0001);
+  EXPECT_EQ(10u, live[SIGNAL_DROP_ANALYZER_NAME].getU64(
+      detector::WINDOW_SIZE));
+  EXPECT_FALSE(live.hasKey(qos_pipeline::SHADOW_MODE));
+
+  EXPECT_ERROR(createShadowQoSPipelineConfig(live, "ALPHA_CPU"));
+  EXPECT_ERROR(createShadowQoSPipelineConfig(live, "=1"));
+  EXPECT_ERROR(createShadowQoSPipelineConfig(live, "ALPHA_CPU=1.2.3"));
+}
+
+
+/**
+ * Counts slack scale events published on StaticEventBus.
+ */
+class SlackScaleEventConsumer :
+  public ProtobufProcess<SlackScaleEventConsumer> {
+ public:
+  SlackScaleEventConsumer() : ProtobufProcess(), events(0) {
+    install<OversubscriptionCtrlEventEnvelope>(
+      &SlackScaleEventConsumer::event,
+      &OversubscriptionCtrlEventEnvelope::message);
+  }
+
+  void event(const OversubscriptionCtrlEvent& msg) {
+    if (msg.has_slack_scale()) {
+      this->events++;
+    }
+  }
+
+  uint32_t events;
+};
+
+
+/**
+ * Agent with 10 CPUs where production and best effort executors use
+ * 5 CPUs each - overloaded above the default utilization threshold.
+ */
+static ResourceUsage createOverloadedUsage(double_t timestamp) {
+  ResourceUsage usage;
+  usage.add_total()->CopyFrom(Resources::parse("cpus", "10", "*").get());
+
+  for (const std::string& executorId : {"pr", "be"}) {
+    ResourceUsage_Executor* executor = usage.add_executors();
+    Resource cpus = Resources::parse("cpus", "5", "*").get();
+    if (executorId == "be") {
+      cpus.mutable_revocable();
+    }
+    executor->add_allocated()->CopyFrom(cpus);
+    executor->mutable_executor_info()->CopyFrom(
+        createExecutorInfo(executorId));
+    executor->mutable_executor_info()->mutable_command()->set_value("run");
+    executor->mutable_statistics()->set_timestamp(timestamp);
+    executor->mutable_statistics()->set_cpus_limit(5);
+    executor->mutable_statistics()->set_cpus_user_time_secs(5 * timestamp);
+    executor->mutable_statistics()->set_cpus_system_time_secs(0);
+  }
+
+  return usage;
+}
+
+
+static SerenityConfig createOverloadConfig() {
+  SerenityConfig conf;
+  conf.set(ema::ALPHA_CPU, (double_t) 0.9);
+  conf.set(ema::ALPHA_IPC, (double_t) 0.9);
+  conf.set(qos_pipeline::ENABLED_VISUALISATION, false);
+  conf.set(qos_pipeline::VALVE_OPENED, true);
+  return conf;
+}
+
+
+/**
+ * Runs pipeline on overloaded agent and returns number of published
+ * slack scale events.
+ */
+static uint32_t countSlackScaleEvents(QoSControllerPipeline* pipeline) {
+  SlackScaleEventConsumer consumer;
+  process::spawn(consumer);
+  StaticEventBus::subscribe<OversubscriptionCtrlEventEnvelope>(
+      consumer.self());
+
+  for (int i = 1; i < 6; i++) {
+    pipeline->run(createOverloadedUsage(i));
+  }
+
+  // Wait for libprocess queue to be processed.
+  process::Clock::pause();
+  process::Clock::settle();
+  process::Clock::resume();
+
+  process::terminate(consumer);
+  process::wait(consumer);
+
+  return consumer.events;
+}
+
+
+TEST(ShadowQoSPipelinesTest, ShadowPipelineHasNoSideEffects) {
+  CpuQoSPipeline live(createOverloadConfig());
+
+  {
+    SerenityConfig shadowConf = createOverloadConfig();
+    shadowConf.set(qos_pipeline::SHADOW_MODE, true);
+    CpuQoSPipeline shadow(shadowConf);
+
+    // Overloaded agent makes pipeline throttle slack - but not in shadow.
+    EXPECT_EQ(0u, countSlackScaleEvents(&shadow));
+  }
+
+  // Destroyed shadow did not take down valve endpoint of live pipeline.
+  process::UPID upid(
+      getValveProcessBaseName(QOS_CONTROLLER), process::address());
+  process::Future<process::http::Response> response = process::http::post(
+      upid, VALVE_ROUTE + "?" + PIPELINE_ENABLE_KEY + "=true");
+  AWAIT_READY(response);
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(process::http::OK().status, response);
+
+  // The same scenario makes live pipeline publish slack scale.
+  EXPECT_LT(0u, countSlackScaleEvents(&live));
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
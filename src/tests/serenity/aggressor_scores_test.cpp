@@ -0,0 +1,223 @@
+#include <memory>
+#include <string>
+
+#include "filters/executor_age.hpp"
+#include "filters/task_performance.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "observers/qos_correction.hpp"
+#include "observers/strategies/cache_occupancy.hpp"
+
+#include "serenity/aggressor_scores.hpp"
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char SCORES_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+const int SCORES_VICTIM = 3;
+
+
+static void setIpc(uint64_t instructions, ResourceUsage_Executor* executor) {
+  PerfStatistics* perf = executor->mutable_statistics()->mutable_perf();
+  perf->set_timestamp(executor->statistics().timestamp());
+  perf->set_duration(1);
+  perf->set_cycles(1000);
+  perf->set_instructions(instructions);
+}
+
+
+TEST(AggressorScoresTest, ScoreUpdate) {
+  AggressorScores scores;
+  ExecutorInfo aggressor;
+  aggressor.mutable_executor_id()->set_value("executor1");
+  aggressor.mutable_framework_id()->set_value("framework");
+  aggressor.set_name("batch");
+
+  EXPECT_DOUBLE_EQ(0.0, scores.score(aggressor));
+
+  scores.update(aggressor, 1.0);
+  EXPECT_DOUBLE_EQ(0.3, scores.score(aggressor));
+  EXPECT_FALSE(scores.isConfident(aggressor));
+
+  // Another executor of the same workload.
+  ExecutorInfo restarted = aggressor;
+  restarted.mutable_executor_id()->set_value("executor2");
+  scores.update(restarted, 5.0);
+  EXPECT_DOUBLE_EQ(0.51, scores.score(aggressor));
+  EXPECT_TRUE(scores.isConfident(aggressor));
+  EXPECT_EQ(1u, scores.size());
+}
+
+
+/**
+ * Observer should credit revoked workload when victim's IPC recovered
+ * within the evaluation window.
+ */
+TEST(AggressorScoresTest, ObserverScoresRecoveredVictim) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SCORES_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(500000, usage.mutable_executors(1));
+  setIpc(1000, usage.mutable_executors(SCORES_VICTIM));
+
+  SerenityConfig conf;
+  conf.set(feedback::WINDOW, (uint64_t) 2);
+  std::shared_ptr<AggressorScores> scores(new AggressorScores(conf));
+
+  MockSink<QoSCorrections> sink;
+  ExecutorAgeFilter age;
+  QoSCorrectionObserver observer(
+      &sink,
+      &age,
+      new CacheOccupancyStrategy(),
+      1);
+  observer.setAggressorScores(scores, usage::getIpc);
+  MockSource<Contentions> contentionSource(&observer);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  Contentions contentions;
+  contentions.push_back(createContention(
+      0.5,
+      Contention_Type_IPC,
+      WID(usage.executors(SCORES_VICTIM).executor_info()).getWorkID()));
+
+  usageSource.produce(usage);
+  contentionSource.produce(contentions);
+
+  // Victim recovers after revocation.
+  setIpc(2000, usage.mutable_executors(SCORES_VICTIM));
+  for (int i = 0; i < 2; i++) {
+    usageSource.produce(usage);
+    contentionSource.produce(Contentions());
+  }
+
+  EXPECT_DOUBLE_EQ(0.3, scores->score(usage.executors(0).executor_info()));
+  EXPECT_DOUBLE_EQ(0.0, scores->score(usage.executors(1).executor_info()));
+}
+
+
+/**
+ * With usage from TaskPerformanceFilter (as in QoS pipeline) observer
+ * should score revoked workload by change of victim's SLO signal.
+ */
+TEST(AggressorScoresTest, ObserverScoresSloVictim) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SCORES_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(500000, usage.mutable_executors(1));
+  const std::string victimTask = usage.executors(SCORES_VICTIM)
+    .executor_info().executor_id().value();
+
+  SerenityConfig conf;
+  conf.set(feedback::WINDOW, (uint64_t) 2);
+  std::shared_ptr<AggressorScores> scores(new AggressorScores(conf));
+
+  MockSink<QoSCorrections> sink;
+  ExecutorAgeFilter age;
+  QoSCorrectionObserver observer(
+      &sink,
+      &age,
+      new CacheOccupancyStrategy(),
+      1);
+  observer.setAggressorScores(scores, usage::getSloSignal);
+  std::shared_ptr<PipelineClock> clock(new UsageClock(100));
+  TaskPerformanceFilter performanceFilter(&observer, SerenityConfig(), clock);
+  MockSource<Contentions> contentionSource(&observer);
+  MockSource<ResourceUsage> usageSource(&performanceFilter);
+
+  TaskPerformance performance;
+  performance.mutable_task()->set_value(victimTask);
+  TaskPerformance_Sample* latency = performance.add_samples();
+  latency->set_name(slo::DEFAULT_SAMPLE);
+  latency->set_value(20);
+  performanceFilter.getStore()->add(performance, 90);
+
+  Contentions contentions;
+  contentions.push_back(createContention(
+      0.5,
+      Contention_Type_SLO,
+      WID(usage.executors(SCORES_VICTIM).executor_info()).getWorkID()));
+
+  usageSource.produce(usage);
+  contentionSource.produce(contentions);
+
+  // Latency of victim improves by 20% (SLO signal by 25%) after revocation.
+  latency->set_value(16);
+  performanceFilter.getStore()->add(performance, 95);
+  for (int i = 0; i < 2; i++) {
+    usageSource.produce(usage);
+    contentionSource.produce(Contentions());
+  }
+
+  // Without victim signal score would be 0.3 (from quiet iterations).
+  EXPECT_NEAR(0.3 * 0.25,
+              scores->score(usage.executors(0).executor_info()),
+              0.0001);
+  EXPECT_DOUBLE_EQ(0.0, scores->score(usage.executors(1).executor_info()));
+}
+
+
+/**
+ * Only known aggressor is revoked, even if other executors are above mean
+ * LLC occupancy too.
+ */
+TEST(AggressorScoresTest, StrategyRevokesKnownAggressorOnly) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(SCORES_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(4000000, usage.mutable_executors(1));
+  usage::setLlcOccupancy(500000, usage.mutable_executors(2));
+
+  std::shared_ptr<AggressorScores> scores(new AggressorScores());
+  scores->update(usage.executors(1).executor_info(), 1.0);
+  scores->update(usage.executors(1).executor_info(), 1.0);
+
+  ExecutorAgeFilter age;
+  CacheOccupancyStrategy strategy;
+  strategy.setAggressorScores(scores);
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, Contentions(), usage);
+  ASSERT_SOME(corrections);
+
+  ASSERT_EQ(1u, corrections.get().size());
+  EXPECT_EQ(usage.executors(1).executor_info().framework_id().value(),
+            corrections.get().front().kill().framework_id().value());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,168 @@
+#include <memory>
+#include <string>
+
+#include "filters/cumulative.hpp"
+#include "filters/ema.hpp"
+#include "filters/executor_age.hpp"
+
+#include "gtest/gtest.h"
+
+#include "serenity/checkpoint.hpp"
+#include "serenity/clock.hpp"
+#include "serenity/config.hpp"
+
+#include "stout/gtest.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// One executor with timestamps 1 - 6.
+const char CHECKPOINT_FIXTURE[] = "tests/fixtures/ignore_new_executors.json";
+
+
+class PipelineCheckpointTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<std::string> dir = os::mkdtemp();
+    ASSERT_SOME(dir);
+    root = dir.get();
+
+    conf.set(checkpoint::PATH, path::join(root, "pipeline.state"));
+
+    Try<FixtureResourceUsage> fixture = JsonUsage::ReadJson(CHECKPOINT_FIXTURE);
+    ASSERT_SOME(fixture);
+    usages = fixture.get();
+  }
+
+  void TearDown() override {
+    os::rmdir(root);
+  }
+
+  std::string root;
+  SerenityConfig conf;
+  FixtureResourceUsage usages;
+};
+
+
+TEST_F(PipelineCheckpointTest, Disabled) {
+  PipelineCheckpointer checkpointer;
+  EXPECT_FALSE(checkpointer.isEnabled());
+  EXPECT_SOME(checkpointer.iteration());
+  EXPECT_ERROR(checkpointer.restore());
+}
+
+
+TEST_F(PipelineCheckpointTest, RestoreFiltersState) {
+  std::shared_ptr<UsageClock> clock(new UsageClock());
+  const ExecutorInfo executorInfo =
+    usages.resource_usage(0).executors(0).executor_info();
+
+  {
+    MockSink<ResourceUsage> sink;
+    CumulativeFilter cumulativeFilter(&sink);
+    ExecutorAgeFilter ageFilter(&cumulativeFilter, clock);
+    MockSource<ResourceUsage> source(&ageFilter);
+
+    PipelineCheckpointer checkpointer(conf, clock);
+    checkpointer.add("ageFilter", &ageFilter);
+    checkpointer.add("cumulativeFilter", &cumulativeFilter);
+
+    for (int i = 0; i < 3; i++) {
+      clock->update(usages.resource_usage(i));
+      source.produce(usages.resource_usage(i));
+    }
+
+    ASSERT_SOME(checkpointer.save());
+  }
+
+  // Restarted pipeline.
+  MockSink<ResourceUsage> sink;
+  CumulativeFilter cumulativeFilter(&sink);
+  ExecutorAgeFilter ageFilter(&cumulativeFilter, clock);
+  MockSource<ResourceUsage> source(&ageFilter);
+
+  PipelineCheckpointer checkpointer(conf, clock);
+  checkpointer.add("ageFilter", &ageFilter);
+  checkpointer.add("cumulativeFilter", &cumulativeFilter);
+  ASSERT_SOME(checkpointer.restore());
+
+  clock->update(usages.resource_usage(3));
+  source.produce(usages.resource_usage(3));
+
+  // Cumulative filter produces samples in first iteration after restart.
+  ASSERT_EQ(1, sink.numberOfMessagesConsumed);
+  EXPECT_EQ(1, sink.currentConsumedT.executors(0).statistics().timestamp());
+
+  // Executor was spotted first at timestamp 1.
+  Try<double_t> age = ageFilter.age(executorInfo);
+  ASSERT_SOME(age);
+  EXPECT_EQ(3, age.get());
+}
+
+
+TEST_F(PipelineCheckpointTest, IgnoreTooOldCheckpoint) {
+  conf.set(checkpoint::MAX_AGE, (double_t) 60);
+  conf.set(checkpoint::INTERVAL, (uint64_t) 2);
+
+  std::shared_ptr<UsageClock> clock(new UsageClock());
+  ExecutorAgeFilter ageFilter(clock);
+
+  PipelineCheckpointer checkpointer(conf, clock);
+  checkpointer.add("ageFilter", &ageFilter);
+
+  clock->update(usages.resource_usage(0));
+  ageFilter.consume(usages.resource_usage(0));
+  EXPECT_SOME(checkpointer.iteration());
+  EXPECT_FALSE(os::exists(path::join(root, "pipeline.state")));
+
+  // Saved every second iteration.
+  EXPECT_SOME(checkpointer.iteration());
+  EXPECT_TRUE(os::exists(path::join(root, "pipeline.state")));
+
+  std::shared_ptr<UsageClock> laterClock(new UsageClock(1000));
+  PipelineCheckpointer laterCheckpointer(conf, laterClock);
+  EXPECT_ERROR(laterCheckpointer.restore());
+}
+
+
+/**
+ * State of executors which are not in agent usage anymore is forgotten,
+ * so checkpoints do not grow.
+ */
+TEST_F(PipelineCheckpointTest, FinishedExecutorsPruned) {
+  std::shared_ptr<UsageClock> clock(new UsageClock());
+  ExecutorAgeFilter ageFilter(clock);
+  EMAFilter emaFilter(nullptr, usage::getCpuUsage, usage::setEmaCpuUsage);
+
+  const ResourceUsage& usage = usages.resource_usage(0);
+  clock->update(usage);
+  ageFilter.consume(usage);
+  emaFilter.consume(usage);
+
+  FilterCheckpoint running;
+  ageFilter.checkpoint(&running);
+  emaFilter.checkpoint(&running);
+  EXPECT_EQ(2, running.executors_size());
+
+  // Executor finished.
+  ResourceUsage finished;
+  finished.mutable_total()->CopyFrom(usage.total());
+  ageFilter.consume(finished);
+  emaFilter.prune(finished);
+
+  FilterCheckpoint pruned;
+  ageFilter.checkpoint(&pruned);
+  emaFilter.checkpoint(&pruned);
+  EXPECT_EQ(0, pruned.executors_size());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,82 @@
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "filters/executor_age.hpp"
+#include "filters/ignore_new_executors.hpp"
+
+#include "serenity/clock.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/sinks/dummy_sink.hpp"
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+const std::string CLOCK_FIXTURE = "tests/fixtures/ignore_new_executors.json";
+
+
+TEST(UsageClockTest, FollowsNewestTimestamp) {
+  UsageClock clock;
+  EXPECT_EQ(0, clock.now());
+
+  Try<FixtureResourceUsage> usages = JsonUsage::ReadJson(CLOCK_FIXTURE);
+  ASSERT_SOME(usages);
+
+  for (const ResourceUsage& usage : usages.get().resource_usage()) {
+    clock.update(usage);
+    EXPECT_EQ(usage.executors(0).statistics().timestamp(), clock.now());
+  }
+
+  // Clock never moves backwards.
+  clock.update(usages.get().resource_usage(0));
+  EXPECT_EQ(6, clock.now());
+
+  // Sleep does not block nor move the clock.
+  clock.sleep(Hours(1));
+  EXPECT_EQ(6, clock.now());
+}
+
+
+TEST(UsageClockTest, ExecutorAgeFromUsageTimestamps) {
+  std::shared_ptr<UsageClock> clock(new UsageClock());
+  ExecutorAgeFilter ageFilter(clock);
+
+  Try<FixtureResourceUsage> usages = JsonUsage::ReadJson(CLOCK_FIXTURE);
+  ASSERT_SOME(usages);
+
+  for (const ResourceUsage& usage : usages.get().resource_usage()) {
+    clock->update(usage);
+    ageFilter.consume(usage);
+  }
+
+  Try<double_t> age = ageFilter.age(
+      usages.get().resource_usage(0).executors(0).executor_info());
+  ASSERT_SOME(age);
+  EXPECT_EQ(5, age.get());
+}
+
+
+TEST(UsageClockTest, IgnoreNewExecutorsWithUsageClock) {
+  std::shared_ptr<UsageClock> clock(new UsageClock());
+  DummySink<ResourceUsage> dummySink;
+  IgnoreNewExecutorsFilter filter(&dummySink, 3, clock);
+
+  Try<FixtureResourceUsage> usages = JsonUsage::ReadJson(CLOCK_FIXTURE);
+  ASSERT_SOME(usages);
+
+  for (const ResourceUsage& usage : usages.get().resource_usage()) {
+    clock->update(usage);
+    filter.consume(usage);
+  }
+
+  // Executor appeared at timestamp 1, so it passes at timestamps 4, 5, 6.
+  EXPECT_EQ(3u, dummySink.numberOfMessagesConsumed);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,190 @@
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "filters/executor_age.hpp"
+
+#include "gtest/gtest.h"
+
+#include "observers/qos_correction.hpp"
+#include "observers/strategies/cache_occupancy.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/journal.hpp"
+
+#include "stout/gtest.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+
+#include "tests/common/mocks/mock_sink.hpp"
+#include "tests/common/sources/mock_source.hpp"
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char JOURNAL_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+class DecisionJournalTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<std::string> dir = os::mkdtemp();
+    ASSERT_SOME(dir);
+    root = dir.get();
+    path = path::join(root, "journal");
+  }
+
+  void TearDown() override {
+    os::rmdir(root);
+  }
+
+  std::string root;
+  std::string path;
+};
+
+
+TEST_F(DecisionJournalTest, KeepNewestRecords) {
+  Try<std::shared_ptr<DecisionJournal>> journal =
+    DecisionJournal::open(path, 3);
+  ASSERT_SOME(journal);
+
+  for (uint32_t i = 0; i < 5; i++) {
+    JournalRecord record = JournalRecord();
+    record.cooldown = i;
+    journal.get()->append(&record);
+  }
+  EXPECT_EQ(5u, journal.get()->appended());
+
+  Try<std::vector<JournalRecord>> records = DecisionJournal::read(path);
+  ASSERT_SOME(records);
+  ASSERT_EQ(3u, records.get().size());
+  for (uint32_t i = 0; i < 3; i++) {
+    EXPECT_EQ(i + 2, records.get()[i].sequence);
+    EXPECT_EQ(i + 2, records.get()[i].cooldown);
+  }
+}
+
+
+TEST_F(DecisionJournalTest, ContinueAfterReopen) {
+  {
+    Try<std::shared_ptr<DecisionJournal>> journal =
+      DecisionJournal::open(path, 4);
+    ASSERT_SOME(journal);
+    JournalRecord record = JournalRecord();
+    journal.get()->append(&record);
+    journal.get()->append(&record);
+  }
+
+  Try<std::shared_ptr<DecisionJournal>> reopened =
+    DecisionJournal::open(path, 4);
+  ASSERT_SOME(reopened);
+  EXPECT_EQ(2u, reopened.get()->appended());
+
+  // Different capacity starts new journal.
+  Try<std::shared_ptr<DecisionJournal>> resized =
+    DecisionJournal::open(path, 8);
+  ASSERT_SOME(resized);
+  EXPECT_EQ(0u, resized.get()->appended());
+
+  EXPECT_ERROR(DecisionJournal::read(path::join(root, "missing")));
+}
+
+
+TEST_F(DecisionJournalTest, TruncateRecord) {
+  JournalRecord record = JournalRecord();
+  record.setSource(std::string(100, 's'));
+
+  WorkID victim;
+  victim.mutable_executor_id()->set_value(std::string(100, 'e'));
+  for (size_t i = 0; i < JournalRecord::MAX_CONTENTIONS + 2; i++) {
+    record.addContention(
+        createContention(0.5, Contention_Type_IPC, victim));
+  }
+
+  EXPECT_EQ(JournalRecord::SOURCE_LENGTH - 1, strlen(record.source));
+  EXPECT_EQ(JournalRecord::MAX_CONTENTIONS, record.contentionsCount);
+  EXPECT_EQ(2u, record.truncated);
+  EXPECT_EQ(JournalContention::ID_LENGTH - 1,
+            strlen(record.contentions[0].victim));
+  EXPECT_EQ(Contention_Type_IPC, record.contentions[0].type);
+  EXPECT_EQ(0.5, record.contentions[0].severity);
+}
+
+
+/**
+ * Observer should journal corrections and following cooldown.
+ */
+TEST_F(DecisionJournalTest, ObserverDecisions) {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(JOURNAL_QOS_FIXTURE);
+  ASSERT_SOME(usages);
+
+  ResourceUsage usage;
+  usage.CopyFrom(usages.get().resource_usage(0));
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(500000, usage.mutable_executors(1));
+
+  std::shared_ptr<PipelineClock> clock(new UsageClock(100));
+  Try<std::shared_ptr<DecisionJournal>> journal =
+    DecisionJournal::open(path, 16, clock);
+  ASSERT_SOME(journal);
+
+  MockSink<QoSCorrections> sink;
+  ExecutorAgeFilter age;
+  QoSCorrectionObserver observer(
+      &sink,
+      &age,
+      new CacheOccupancyStrategy(),
+      5,
+      Tag(QOS_CONTROLLER, CacheOccupancyStrategy::NAME),
+      journal.get(),
+      CacheOccupancyStrategy::NAME);
+  MockSource<Contentions> contentionSource(&observer);
+  MockSource<ResourceUsage> usageSource(&observer);
+
+  WorkID victim;
+  victim.mutable_executor_id()->set_value(
+      usage.executors(3).executor_info().executor_id().value());
+  Contentions contentions;
+  contentions.push_back(createContention(0.2, Contention_Type_IPC, victim));
+
+  for (int i = 0; i < 2; i++) {
+    usageSource.produce(usage);
+    contentionSource.produce(contentions);
+  }
+
+  Try<std::vector<JournalRecord>> records = DecisionJournal::read(path);
+  ASSERT_SOME(records);
+  ASSERT_EQ(2u, records.get().size());
+
+  const JournalRecord& corrected = records.get()[0];
+  EXPECT_EQ(JournalOutcome::CORRECTED, corrected.outcome);
+  EXPECT_STREQ(CacheOccupancyStrategy::NAME, corrected.source);
+  EXPECT_EQ(100, corrected.timestamp);
+  EXPECT_EQ(5u, corrected.cooldown);
+  ASSERT_EQ(1u, corrected.contentionsCount);
+  EXPECT_STREQ(victim.executor_id().value().c_str(),
+               corrected.contentions[0].victim);
+  ASSERT_EQ(1u, corrected.correctionsCount);
+  EXPECT_STREQ(
+      usage.executors(0).executor_info().executor_id().value().c_str(),
+      corrected.corrections[0]);
+
+  const JournalRecord& cooldown = records.get()[1];
+  EXPECT_EQ(JournalOutcome::COOLDOWN, cooldown.outcome);
+  EXPECT_EQ(4u, cooldown.cooldown);
+  EXPECT_EQ(0u, cooldown.correctionsCount);
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
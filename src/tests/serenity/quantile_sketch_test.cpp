@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+
+#include "serenity/quantile_sketch.hpp"
+
+#include "stout/gtest.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+TEST(QuantileSketchTest, EmptySketch) {
+  QuantileSketch sketch;
+  EXPECT_NONE(sketch.quantile(0.5));
+}
+
+
+TEST(QuantileSketchTest, QuantilesWithinRelativeAccuracy) {
+  const double_t accuracy = 0.02;
+  QuantileSketch sketch(accuracy, 0);
+
+  for (int i = 1; i <= 1000; i++) {
+    sketch.add(i / 100.0);
+  }
+
+  ASSERT_SOME(sketch.quantile(0.5));
+  EXPECT_NEAR(5.0, sketch.quantile(0.5).get(), 5.0 * accuracy);
+  EXPECT_NEAR(9.5, sketch.quantile(0.95).get(), 9.5 * accuracy);
+  EXPECT_NEAR(10.0, sketch.quantile(1.0).get(), 10.0 * accuracy);
+  EXPECT_NEAR(0.01, sketch.quantile(0.0).get(), 0.01 * accuracy);
+}
+
+
+TEST(QuantileSketchTest, BoundedBins) {
+  const size_t maxBins = 16;
+  QuantileSketch sketch(0.01, 0, maxBins);
+
+  for (int i = 1; i <= 10000; i++) {
+    sketch.add(i);
+  }
+
+  EXPECT_GE(maxBins, sketch.binsSize());
+  // High quantiles are preserved when lowest bins are collapsed.
+  EXPECT_NEAR(10000, sketch.quantile(1.0).get(), 10000 * 0.01);
+}
+
+
+TEST(QuantileSketchTest, OldSamplesDecay) {
+  QuantileSketch sketch(0.02, 10);
+
+  for (int i = 0; i < 100; i++) {
+    sketch.add(8.0);
+  }
+  EXPECT_NEAR(8.0, sketch.quantile(0.5).get(), 8.0 * 0.02);
+
+  // After many horizons old samples are forgotten.
+  for (int i = 0; i < 100; i++) {
+    sketch.add(1.0);
+  }
+  EXPECT_NEAR(1.0, sketch.quantile(0.95).get(), 1.0 * 0.025);
+  EXPECT_GE(10.0 + 1e-6, sketch.weight());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -212,6 +213,63 @@ TEST(SerenityFrameworkTests, MultiProductTypesConsumer) {
   ASSERT_EQ(SECOND_STRING_PRODUCT, consumer.getConsumable<std::string>().get());
 }
 
+
+TEST(SerenityLoggingTests, TagName) {
+  Tag tag(QOS_CONTROLLER, "testComponent");
+  EXPECT_EQ("[SerenityQoS] testComponent: ", tag.NAME());
+  EXPECT_EQ(QOS_CONTROLLER, tag.TYPE());
+
+  Tag undefinedTag("testComponent");
+  EXPECT_EQ("[Serenity] testComponent: ", undefinedTag.NAME());
+}
+
+
+/**
+ * Verbose messages are logged (and formatted) only when component
+ * verbosity is high enough.
+ */
+TEST(SerenityLoggingTests, ComponentVerbosity) {
+  Tag tag(UNDEFINED, "verbosityTestComponent");
+  Tag otherTag(UNDEFINED, "otherVerbosityTestComponent");
+
+  int formatted = 0;
+  auto format = [&formatted]() { return ++formatted; };
+
+  EXPECT_FALSE(tag.isVerbose(1));
+  SERENITY_VLOG(1) << format();
+  EXPECT_EQ(0, formatted);
+
+  logging::setVerbosity("verbosityTestComponent", 1);
+  EXPECT_TRUE(tag.isVerbose(1));
+  EXPECT_FALSE(tag.isVerbose(2));
+  EXPECT_FALSE(otherTag.isVerbose(1));
+  SERENITY_VLOG(1) << format();
+  EXPECT_EQ(1, formatted);
+
+  logging::setVerbosity("verbosityTestComponent", 0);
+}
+
+
+/**
+ * Rate limited call site logs only once per period.
+ */
+TEST(SerenityLoggingTests, RateLimit) {
+  Tag tag(UNDEFINED, "rateLimitTestComponent");
+
+  int formatted = 0;
+  auto format = [&formatted]() { return ++formatted; };
+
+  for (int i = 0; i < 10; i++) {
+    SERENITY_LOG_EVERY_N_SEC(INFO, 3600) << format();
+  }
+  EXPECT_EQ(1, formatted);
+
+  std::atomic<int64_t> lastLog(0);
+  EXPECT_TRUE(logging::rateLimit(&lastLog, 3600));
+  EXPECT_FALSE(logging::rateLimit(&lastLog, 3600));
+  EXPECT_TRUE(logging::rateLimit(&lastLog, 0));
+}
+
 }  // namespace tests
 }  // namespace serenity
 }  // namespace mesos
@@ -0,0 +1,210 @@
+#include <list>
+#include <set>
+#include <string>
+
+#include "filters/executor_age.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "observers/strategies/cache_occupancy.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/data_utils.hpp"
+#include "serenity/resource_helper.hpp"
+#include "serenity/topology.hpp"
+#include "serenity/wid.hpp"
+
+#include "stout/gtest.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char TOPOLOGY_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+TEST(TopologyTest, ParseCpuList) {
+  Try<std::set<uint32_t>> cpus = parseCpuList("0-2,8,10-11\n");
+  ASSERT_SOME(cpus);
+  EXPECT_EQ(std::set<uint32_t>({0, 1, 2, 8, 10, 11}), cpus.get());
+
+  EXPECT_ERROR(parseCpuList("3-1"));
+  EXPECT_ERROR(parseCpuList("a-b"));
+}
+
+
+/**
+ * Fake sysfs with two NUMA nodes (CPUs 0-3 and 4-7) and cgroup cpuset
+ * hierarchy. Executors are pinned:
+ * - serenityBe2 (id 0) to socket 1
+ * - serenityBe1 (id 1, 2) and serenityPR (id 3) to socket 0
+ * - serenityPR2 (id 4) spans both sockets.
+ */
+class FakeTopologyTree : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Try<std::string> dir = os::mkdtemp();
+    ASSERT_SOME(dir);
+    root = dir.get();
+
+    writeFile(path::join(root, "devices/system/node/node0"), "cpulist",
+              "0-3\n");
+    writeFile(path::join(root, "devices/system/node/node1"), "cpulist",
+              "4-7\n");
+
+    writeCpuset("serenityBe2", "4-5");
+    writeCpuset("serenityBe1", "2-3");
+    writeCpuset("serenityPR", "0-1");
+    writeCpuset("serenityPR2", "0-7");
+
+    conf.set(topology::SYSFS_ROOT, root);
+    conf.set(topology::CPUSET_ROOT, path::join(root, "cpuset"));
+    conf.set(topology::CPUSET_GROUP,
+             std::string(topology::EXECUTOR_ID_GROUP));
+
+    Try<mesos::FixtureResourceUsage> usages =
+      JsonUsage::ReadJson(TOPOLOGY_QOS_FIXTURE);
+    ASSERT_SOME(usages);
+    usage.CopyFrom(usages.get().resource_usage(0));
+  }
+
+  void TearDown() override {
+    os::rmdir(root);
+  }
+
+  void writeFile(const std::string& dir,
+                 const std::string& name,
+                 const std::string& content) {
+    ASSERT_SOME(os::mkdir(dir));
+    ASSERT_SOME(os::write(path::join(dir, name), content));
+  }
+
+  void writeCpuset(const std::string& group, const std::string& cpus) {
+    writeFile(path::join(root, "cpuset", group), "cpuset.cpus", cpus + "\n");
+  }
+
+  std::string root;
+  SerenityConfig conf;
+  ResourceUsage usage;
+};
+
+
+TEST_F(FakeTopologyTree, MapsExecutorsToSockets) {
+  ExecutorSocketMapper mapper(conf);
+  ASSERT_TRUE(mapper.isAvailable());
+
+  EXPECT_SOME_EQ(1u, mapper(usage.executors(0)));
+  EXPECT_SOME_EQ(0u, mapper(usage.executors(1)));
+  EXPECT_SOME_EQ(0u, mapper(usage.executors(3)));
+  EXPECT_NONE(mapper(usage.executors(4)));
+}
+
+
+/**
+ * By default cgroups are named after container id (as created by Mesos
+ * cgroups isolators). Executors without container id have unknown socket.
+ * Sockets are cached until cache is cleared (new iteration).
+ */
+TEST_F(FakeTopologyTree, MapsContainersToSockets) {
+  conf.set(topology::CPUSET_GROUP,
+           std::string(topology::CONTAINER_ID_GROUP));
+  writeCpuset("container1", "4-7");
+  ExecutorSocketMapper mapper(conf);
+
+  ResourceUsage_Executor executor = usage.executors(3);
+  executor.clear_container_id();
+  EXPECT_NONE(mapper(executor));
+
+  executor.mutable_container_id()->set_value("container1");
+  EXPECT_SOME_EQ(1u, mapper(executor));
+
+  writeCpuset("container1", "0-3");
+  EXPECT_SOME_EQ(1u, mapper(executor));
+
+  mapper.clearCache();
+  EXPECT_SOME_EQ(0u, mapper(executor));
+}
+
+
+/**
+ * Only BE executors on the socket of the victim (or contention) are
+ * possible aggressors. Contention without known socket concerns all.
+ */
+TEST_F(FakeTopologyTree, ColocatedExecutors) {
+  ExecutorSocketMapper mapper(conf);
+  const std::list<ResourceUsage_Executor> revocable =
+    ResourceUsageHelper::getRevocableExecutors(usage);
+  ASSERT_EQ(3u, revocable.size());
+
+  Contentions victimOnSocket0;
+  victimOnSocket0.push_back(createContention(
+      1.0,
+      Contention_Type_IPC,
+      WID(usage.executors(3).executor_info()).getWorkID()));
+  EXPECT_EQ(2u, colocatedExecutors(
+      revocable, victimOnSocket0, usage, mapper).size());
+
+  Contentions socket1;
+  socket1.push_back(createContention(1.0, Contention_Type_IPC));
+  socket1.front().set_socket(1);
+  std::list<ResourceUsage_Executor> colocated =
+    colocatedExecutors(revocable, socket1, usage, mapper);
+  ASSERT_EQ(1u, colocated.size());
+  EXPECT_EQ("serenityBe2",
+            colocated.front().executor_info().executor_id().value());
+
+  Contentions spanningVictim;
+  spanningVictim.push_back(createContention(
+      1.0,
+      Contention_Type_IPC,
+      WID(usage.executors(4).executor_info()).getWorkID()));
+  EXPECT_EQ(3u, colocatedExecutors(
+      revocable, spanningVictim, usage, mapper).size());
+}
+
+
+/**
+ * Cache occupancy strategy should not revoke the biggest LLC user when it
+ * runs on the other socket than the victim.
+ */
+TEST_F(FakeTopologyTree, CacheOccupancyStrategyRevokesColocated) {
+  usage::setLlcOccupancy(5000000, usage.mutable_executors(0));
+  usage::setLlcOccupancy(2000000, usage.mutable_executors(1));
+  usage::setLlcOccupancy(3000000, usage.mutable_executors(2));
+
+  Contentions contentions;
+  contentions.push_back(createContention(
+      1.0,
+      Contention_Type_IPC,
+      WID(usage.executors(3).executor_info()).getWorkID()));
+
+  ExecutorAgeFilter age;
+  CacheOccupancyStrategy strategy(SerenityConfig(), ExecutorSocketMapper(conf));
+
+  Try<QoSCorrections> corrections =
+    strategy.decide(&age, contentions, usage);
+  ASSERT_SOME(corrections);
+
+  ASSERT_EQ(1u, corrections.get().size());
+  EXPECT_EQ(usage.executors(2).executor_info().framework_id().value(),
+            corrections.get().front().kill().framework_id().value());
+  EXPECT_EQ(usage.executors(2).executor_info().executor_id().value(),
+            corrections.get().front().kill().executor_id().value());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
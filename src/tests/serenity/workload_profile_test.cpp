@@ -0,0 +1,207 @@
+#include <memory>
+#include <string>
+
+#include "filters/profile_learner.hpp"
+
+#include "gtest/gtest.h"
+
+#include "mesos/mesos.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "serenity/config.hpp"
+#include "serenity/wid.hpp"
+#include "serenity/workload_profile.hpp"
+
+#include "stout/gtest.hpp"
+#include "stout/os.hpp"
+#include "stout/path.hpp"
+
+#include "tests/common/sources/mock_source.hpp"
+#include "tests/common/usage_helper.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+// This fixture includes 5 executors:
+// - 1 BE <1 CPUS> id 0
+// - 2 BE <0.5 CPUS> id 1,2
+// - 1 PR <4 CPUS> id 3
+// - 1 PR <2 CPUS> id 4
+const char PROFILE_QOS_FIXTURE[] = "tests/fixtures/qos/average_usage.json";
+
+
+static ExecutorInfo createCommandExecutor(
+    const std::string& executorId,
+    const std::string& taskId) {
+  ExecutorInfo info;
+  info.mutable_executor_id()->set_value(executorId);
+  info.mutable_framework_id()->set_value("framework");
+  info.mutable_command()->set_value("mesos-executor");
+  info.set_name("Command Executor (Task: " + taskId + ") "
+                "(Command: sh -c 'app')");
+  return info;
+}
+
+
+/**
+ * Fixture usage with perf counters (so IPC can be counted). Both PR
+ * executors are separate workloads.
+ */
+static Try<ResourceUsage> createProfileUsage() {
+  Try<mesos::FixtureResourceUsage> usages =
+    JsonUsage::ReadJson(PROFILE_QOS_FIXTURE);
+  if (usages.isError()) {
+    return Error(usages.error());
+  }
+
+  ResourceUsage usage = usages.get().resource_usage(0);
+  for (ResourceUsage_Executor& executor : *usage.mutable_executors()) {
+    PerfStatistics* perf = executor.mutable_statistics()->mutable_perf();
+    perf->set_timestamp(executor.statistics().timestamp());
+    perf->set_duration(1);
+    perf->set_cycles(2000);
+    perf->set_instructions(3000);
+  }
+  // Both PR executors run the same command - make them separate workloads.
+  usage.mutable_executors(4)->mutable_executor_info()->set_name("other");
+
+  return usage;
+}
+
+
+TEST(WorkloadProfileTest, CommandExecutorWorkload) {
+  EXPECT_EQ("framework/Command Executor (Command: sh -c 'app')",
+            executorWorkload(createCommandExecutor("executor1", "task1")));
+
+  ExecutorInfo info;
+  info.mutable_executor_id()->set_value("executor1");
+  info.mutable_framework_id()->set_value("framework");
+  info.mutable_command()->set_value("./app");
+  EXPECT_EQ("framework/./app", executorWorkload(info));
+}
+
+
+/**
+ * Baseline is known after MIN_SAMPLES and is shared by all executors
+ * of the same workload.
+ */
+TEST(WorkloadProfileTest, LearnBaseline) {
+  const uint64_t MIN_SAMPLES = 5;
+  SerenityConfig conf;
+  conf.set(workload_profile::MIN_SAMPLES, MIN_SAMPLES);
+  WorkloadProfileStore store(conf);
+
+  const ExecutorInfo first = createCommandExecutor("executor1", "task1");
+  for (uint64_t i = 0; i < MIN_SAMPLES - 1; i++) {
+    store.learn(first, 1.5, 2.0, i);
+  }
+  EXPECT_NONE(store.baseline(first, ProfileSignal::IPC));
+
+  store.learn(first, 1.5, 2.0, MIN_SAMPLES);
+
+  const ExecutorInfo restarted = createCommandExecutor("executor2", "task2");
+  Option<double_t> ipc = store.baseline(restarted, ProfileSignal::IPC);
+  ASSERT_SOME(ipc);
+  EXPECT_DOUBLE_EQ(1.5, ipc.get());
+
+  Option<double_t> cpuUsage =
+    store.baseline(restarted, ProfileSignal::CPU_USAGE);
+  ASSERT_SOME(cpuUsage);
+  EXPECT_DOUBLE_EQ(2.0, cpuUsage.get());
+  EXPECT_EQ(1u, store.size());
+}
+
+
+/**
+ * Signal with too high variation is not used as baseline.
+ */
+TEST(WorkloadProfileTest, NoisySignalIgnored) {
+  SerenityConfig conf;
+  conf.set(workload_profile::MIN_SAMPLES, (uint64_t) 10);
+  WorkloadProfileStore store(conf);
+
+  const ExecutorInfo info = createCommandExecutor("executor1", "task1");
+  for (int i = 0; i < 40; i++) {
+    store.learn(info, (i % 2 == 0) ? 0.5 : 2.5, 2.0, i);
+  }
+
+  EXPECT_NONE(store.baseline(info, ProfileSignal::IPC));
+  EXPECT_SOME(store.baseline(info, ProfileSignal::CPU_USAGE));
+}
+
+
+/**
+ * Learner learns only production executors and saves profiles, which are
+ * loaded by new store.
+ */
+TEST(WorkloadProfileTest, LearnSaveAndLoad) {
+  Try<std::string> dir = os::mkdtemp();
+  ASSERT_SOME(dir);
+
+  SerenityConfig conf;
+  conf.set(workload_profile::PATH, path::join(dir.get(), "profiles"));
+  conf.set(workload_profile::SAVE_INTERVAL, (uint64_t) 1);
+
+  Try<ResourceUsage> profileUsage = createProfileUsage();
+  ASSERT_SOME(profileUsage);
+  const ResourceUsage& usage = profileUsage.get();
+
+  std::shared_ptr<WorkloadProfileStore> store(
+      new WorkloadProfileStore(conf));
+  WorkloadProfileLearner learner(store, conf);
+  MockSource<ResourceUsage> usageSource(&learner);
+  usageSource.produce(usage);
+
+  EXPECT_EQ(2u, store->size());
+  ASSERT_TRUE(os::exists(path::join(dir.get(), "profiles")));
+
+  WorkloadProfileStore loaded(conf);
+  ASSERT_SOME(loaded.load());
+  EXPECT_EQ(2u, loaded.size());
+
+  const ExecutorInfo& info = usage.executors(3).executor_info();
+  Option<WorkloadProfile> expected = store->get(info);
+  Option<WorkloadProfile> actual = loaded.get(info);
+  ASSERT_SOME(expected);
+  ASSERT_SOME(actual);
+  EXPECT_EQ(expected.get().workload(), actual.get().workload());
+  EXPECT_DOUBLE_EQ(1.5, actual.get().ipc());
+  EXPECT_DOUBLE_EQ(expected.get().cpu_usage(), actual.get().cpu_usage());
+  EXPECT_EQ(1u, actual.get().samples());
+
+  os::rmdir(dir.get());
+}
+
+
+/**
+ * Victims of detected contentions are not learned in that iteration.
+ */
+TEST(WorkloadProfileTest, ContendedExecutorNotLearned) {
+  Try<ResourceUsage> usage = createProfileUsage();
+  ASSERT_SOME(usage);
+
+  std::shared_ptr<WorkloadProfileStore> store(new WorkloadProfileStore());
+  WorkloadProfileLearner learner(store);
+  MockSource<ResourceUsage> usageSource(&learner);
+  MockSource<Contentions> contentionSource(learner.getContendedExecutors());
+
+  const ExecutorInfo& victim = usage.get().executors(3).executor_info();
+  contentionSource.produce(Contentions{createContention(
+      1.0, Contention_Type_IPC, WID(victim).getWorkID(), 0)});
+  usageSource.produce(usage.get());
+
+  EXPECT_EQ(1u, store->size());
+  EXPECT_NONE(store->get(victim));
+
+  // Contention is over.
+  contentionSource.produce(Contentions());
+  usageSource.produce(usage.get());
+
+  EXPECT_EQ(2u, store->size());
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,119 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mesos_modules/qos_controller/serenity_controller.hpp"
+
+#include "stout/gtest.hpp"
+
+#include "tests/common/usage_helper.hpp"
+
+#include "tools/parameter_sweep/sweep.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace tests {
+
+using sweep::ContentionWindow;
+using sweep::IterationOutcome;
+using sweep::SweepParameters;
+using sweep::SweepResult;
+using sweep::SweepScore;
+
+
+TEST(ParameterSweepTest, CreateGrid) {
+  std::vector<SweepParameters> grid = sweep::createGrid(
+      {8, 10}, {0.3, 0.5}, {2.1}, {0.5, 0.7}, {0.2, 0.9});
+
+  ASSERT_EQ(16u, grid.size());
+  EXPECT_EQ(8u, grid.front().windowSize);
+  EXPECT_EQ(0.2, grid.front().emaAlphaIpc);
+  EXPECT_EQ(10u, grid.back().windowSize);
+  EXPECT_EQ(0.9, grid.back().emaAlphaCpu);
+}
+
+
+TEST(ParameterSweepTest, ScoreAgainstLabels) {
+  const std::vector<ContentionWindow> windows = {{10, 20}, {40, 50}};
+  const std::vector<IterationOutcome> outcomes = {
+    {5, 1},   // False positive.
+    {10, 0},
+    {14, 2},  // First window detected after 4 s.
+    {18, 1},
+    {30, 0},
+    {45, 0},  // Second window is missed (counts as 10 s).
+  };
+
+  SweepScore result = sweep::score(outcomes, windows);
+  EXPECT_EQ(1u, result.detected);
+  EXPECT_EQ(1u, result.missed);
+  EXPECT_EQ(1u, result.falsePositives);
+  EXPECT_EQ(4u, result.kills);
+  EXPECT_DOUBLE_EQ(7, result.meanDetectionDelay);
+}
+
+
+TEST(ParameterSweepTest, ParetoFront) {
+  std::vector<SweepResult> results(4);
+  results[0].score.meanDetectionDelay = 5;
+  results[0].score.kills = 10;
+  results[1].score.meanDetectionDelay = 10;
+  results[1].score.kills = 2;
+  // Dominated by results[0].
+  results[2].score.meanDetectionDelay = 6;
+  results[2].score.kills = 12;
+  // Same score as results[0] - kept.
+  results[3].score.meanDetectionDelay = 5;
+  results[3].score.kills = 10;
+  for (size_t i = 0; i < results.size(); i++) {
+    results[i].parameters.windowSize = i;
+  }
+
+  std::vector<SweepResult> front = sweep::paretoFront(results);
+  ASSERT_EQ(3u, front.size());
+  EXPECT_EQ(5, front[0].score.meanDetectionDelay);
+  EXPECT_EQ(5, front[1].score.meanDetectionDelay);
+  EXPECT_EQ(1u, front[2].parameters.windowSize);
+}
+
+
+TEST(ParameterSweepTest, ParseLabels) {
+  Try<std::vector<ContentionWindow>> windows = sweep::parseContentionWindows(
+      "{\"contentions\": [{\"start\": 100, \"end\": 160}]}");
+  ASSERT_SOME(windows);
+  ASSERT_EQ(1u, windows.get().size());
+  EXPECT_EQ(100, windows.get()[0].start);
+  EXPECT_EQ(160, windows.get()[0].end);
+
+  EXPECT_ERROR(sweep::parseContentionWindows("{\"contentions\": [{}]}"));
+  EXPECT_ERROR(sweep::parseContentionWindows("{}"));
+}
+
+
+TEST(ParameterSweepTest, ReplayTrace) {
+  Try<FixtureResourceUsage> usages = JsonUsage::ReadJson(
+      "tests/fixtures/pipeline/qos_one_drop_correction.json");
+  ASSERT_SOME(usages);
+  const std::vector<ResourceUsage> trace(
+      usages.get().resource_usage().begin(),
+      usages.get().resource_usage().end());
+
+  std::vector<SweepParameters> grid = sweep::createGrid(
+      {8, 10}, {0.3}, {2.1}, {0.7}, {0.9});
+
+  std::vector<SweepResult> results = sweep::runSweep(
+      grid, createSerenityControllerConfig(), trace, {}, 1);
+
+  ASSERT_EQ(grid.size(), results.size());
+  EXPECT_EQ(8u, results[0].parameters.windowSize);
+  EXPECT_EQ(10u, results[1].parameters.windowSize);
+  // No labels - every kill is a false positive.
+  for (const SweepResult& result : results) {
+    EXPECT_EQ(0u, result.score.missed);
+    EXPECT_LE(result.score.falsePositives, result.score.kills);
+  }
+}
+
+}  // namespace tests
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "serenity/journal.hpp"
+
+#include "stout/flags.hpp"
+
+using std::string;
+using std::vector;
+
+using namespace mesos::serenity;  // NOLINT(build/namespaces)
+
+
+class JournalReaderFlags : public virtual flags::FlagsBase {
+ public:
+  JournalReaderFlags() {
+    add(&path,
+        "path",
+        "Path to decision journal (JOURNAL_PATH of QoS pipeline).");
+
+    add(&last,
+        "last",
+        "Print only given number of the newest records.");
+
+    add(&source,
+        "source",
+        "Print only records of given observer, e.g. CpuContentionStrategy.");
+
+    add(&corrections,
+        "corrections",
+        "Print only records with corrections.",
+        false);
+  }
+
+  Option<string> path;
+  Option<size_t> last;
+  Option<string> source;
+  bool corrections;
+};
+
+
+int main(int argc, char** argv) {
+  JournalReaderFlags flags;
+  Try<Nothing> load = flags.load(None(), argc, argv);
+  if (load.isError()) {
+    std::cerr << flags.usage(load.error()) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (flags.path.isNone()) {
+    std::cerr << flags.usage("--path is required") << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Try<vector<JournalRecord>> records = DecisionJournal::read(flags.path.get());
+  if (records.isError()) {
+    std::cerr << records.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vector<const JournalRecord*> selected;
+  for (const JournalRecord& record : records.get()) {
+    if (flags.source.isSome() && flags.source.get() != record.source) {
+      continue;
+    }
+    if (flags.corrections && record.correctionsCount == 0) {
+      continue;
+    }
+    selected.push_back(&record);
+  }
+
+  size_t first = 0;
+  if (flags.last.isSome() && flags.last.get() < selected.size()) {
+    first = selected.size() - flags.last.get();
+  }
+
+  for (size_t i = first; i < selected.size(); i++) {
+    std::cout << *selected[i] << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glog/logging.h"
+
+#include "mesos/mesos.hpp"
+
+#include "mesos_modules/qos_controller/serenity_controller.hpp"
+
+#include "messages/serenity.hpp"
+
+#include "pbjson.hpp"
+
+#include "stout/flags.hpp"
+#include "stout/numify.hpp"
+#include "stout/os.hpp"
+#include "stout/strings.hpp"
+
+#include "tools/parameter_sweep/sweep.hpp"
+
+using std::string;
+using std::vector;
+
+using namespace mesos;  // NOLINT(build/namespaces)
+using namespace mesos::serenity;  // NOLINT(build/namespaces)
+using namespace mesos::serenity::sweep;  // NOLINT(build/namespaces)
+
+
+class SweepFlags : public virtual flags::FlagsBase {
+ public:
+  SweepFlags() {
+    add(&trace,
+        "trace",
+        "Path to JSON with recorded usage: {\"resource_usage\": [...]}.");
+
+    add(&labels,
+        "labels",
+        "Path to JSON with labelled contention windows (usage timestamps):\n"
+          "{\"contentions\": [{\"start\": 100, \"end\": 160}]}");
+
+    add(&window_sizes,
+        "window_sizes",
+        "Comma separated WINDOW_SIZE values.",
+        "8,10,16");
+
+    add(&fractional_thresholds,
+        "fractional_thresholds",
+        "Comma separated FRACTIONAL_THRESHOLD values.",
+        "0.2,0.3,0.5");
+
+    add(&severity_fractions,
+        "severity_fractions",
+        "Comma separated SEVERITY_FRACTION values.",
+        "1,2.1");
+
+    add(&quorums,
+        "quorums",
+        "Comma separated QUORUM values.",
+        "0.5,0.7");
+
+    add(&ema_alphas,
+        "ema_alphas",
+        "Comma separated EMA alphas (used for both IPC and CPU).",
+        "0.2,0.5,0.9");
+
+    add(&threads,
+        "threads",
+        "Number of replay threads. Defaults to number of cores.");
+
+    add(&all,
+        "all",
+        "Print scores of all configurations, not only Pareto-best ones.",
+        false);
+  }
+
+  Option<string> trace;
+  Option<string> labels;
+  string window_sizes;
+  string fractional_thresholds;
+  string severity_fractions;
+  string quorums;
+  string ema_alphas;
+  Option<size_t> threads;
+  bool all;
+};
+
+
+template <typename T>
+static Try<vector<T>> parseList(const string& name, const string& values) {
+  vector<T> parsed;
+  for (const string& value : strings::tokenize(values, ",")) {
+    Try<T> number = numify<T>(strings::trim(value));
+    if (number.isError()) {
+      return Error("Bad value '" + value + "' in --" + name);
+    }
+    parsed.push_back(number.get());
+  }
+
+  return parsed;
+}
+
+
+static void print(const SweepResult& result) {
+  std::cout << "delay=" << result.score.meanDetectionDelay
+            << " detected=" << result.score.detected
+            << " missed=" << result.score.missed
+            << " false_positives=" << result.score.falsePositives
+            << " kills=" << result.score.kills
+            << " | " << result.parameters.toString() << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+  SweepFlags flags;
+  Try<Nothing> load = flags.load(None(), argc, argv);
+  if (load.isError()) {
+    std::cerr << flags.usage(load.error()) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (flags.trace.isNone() || flags.labels.isNone()) {
+    std::cerr << flags.usage("--trace and --labels are required")
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Pipelines are very verbose - keep only warnings.
+  FLAGS_minloglevel = google::WARNING;
+  google::InitGoogleLogging(argv[0]);
+
+  Try<string> traceJson = os::read(flags.trace.get());
+  if (traceJson.isError()) {
+    std::cerr << "Cannot read trace: " << traceJson.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  UsageTrace usageTrace;
+  string error;
+  if (pbjson::json2pb(traceJson.get(), &usageTrace, error) != 0) {
+    std::cerr << "Cannot parse trace: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Decoded once, shared read-only by all replay threads.
+  const vector<ResourceUsage> trace(
+      usageTrace.resource_usage().begin(),
+      usageTrace.resource_usage().end());
+
+  Try<string> labelsJson = os::read(flags.labels.get());
+  if (labelsJson.isError()) {
+    std::cerr << "Cannot read labels: " << labelsJson.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Try<vector<ContentionWindow>> windows =
+    parseContentionWindows(labelsJson.get());
+  if (windows.isError()) {
+    std::cerr << windows.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Try<vector<uint64_t>> windowSizes =
+    parseList<uint64_t>("window_sizes", flags.window_sizes);
+  Try<vector<double_t>> fractionalThresholds =
+    parseList<double_t>("fractional_thresholds", flags.fractional_thresholds);
+  Try<vector<double_t>> severityFractions =
+    parseList<double_t>("severity_fractions", flags.severity_fractions);
+  Try<vector<double_t>> quorums =
+    parseList<double_t>("quorums", flags.quorums);
+  Try<vector<double_t>> emaAlphas =
+    parseList<double_t>("ema_alphas", flags.ema_alphas);
+
+  for (const Try<vector<double_t>>* values :
+         {&fractionalThresholds, &severityFractions, &quorums, &emaAlphas}) {
+    if (values->isError()) {
+      std::cerr << values->error() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (windowSizes.isError()) {
+    std::cerr << windowSizes.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const vector<SweepParameters> grid = createGrid(
+      windowSizes.get(),
+      fractionalThresholds.get(),
+      severityFractions.get(),
+      quorums.get(),
+      emaAlphas.get());
+
+  size_t threads = flags.threads.isSome()
+    ? flags.threads.get()
+    : std::thread::hardware_concurrency();
+
+  std::cerr << "Replaying " << trace.size() << " samples through "
+            << grid.size() << " configurations on " << threads
+            << " threads" << std::endl;
+
+  const vector<SweepResult> results = runSweep(
+      grid, createSerenityControllerConfig(), trace, windows.get(), threads);
+
+  for (const SweepResult& result : flags.all ? results : paretoFront(results)) {
+    print(result);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pipeline/qos_pipeline.hpp"
+
+#include "serenity/clock.hpp"
+#include "serenity/default_vars.hpp"
+
+#include "stout/json.hpp"
+#include "stout/stringify.hpp"
+
+#include "tools/parameter_sweep/sweep.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace sweep {
+
+void SweepParameters::apply(SerenityConfig* conf) const {
+  SerenityConfig& analyzer = (*conf)[SIGNAL_DROP_ANALYZER_NAME];
+  analyzer.set(detector::WINDOW_SIZE, this->windowSize);
+  analyzer.set(detector::FRACTIONAL_THRESHOLD, this->fractionalThreshold);
+  analyzer.set(detector::SEVERITY_FRACTION, this->severityFraction);
+  analyzer.set(detector::QUORUM, this->quorum);
+
+  conf->set(ema::ALPHA_IPC, this->emaAlphaIpc);
+  conf->set(ema::ALPHA_CPU, this->emaAlphaCpu);
+}
+
+
+std::string SweepParameters::toString() const {
+  std::stringstream out;
+  out << detector::WINDOW_SIZE << "=" << this->windowSize << " "
+      << detector::FRACTIONAL_THRESHOLD << "=" << this->fractionalThreshold
+      << " " << detector::SEVERITY_FRACTION << "=" << this->severityFraction
+      << " " << detector::QUORUM << "=" << this->quorum << " "
+      << ema::ALPHA_IPC << "=" << this->emaAlphaIpc << " "
+      << ema::ALPHA_CPU << "=" << this->emaAlphaCpu;
+  return out.str();
+}
+
+
+bool SweepScore::dominates(const SweepScore& other) const {
+  const bool notWorse =
+    this->meanDetectionDelay <= other.meanDetectionDelay &&
+    this->falsePositives <= other.falsePositives &&
+    this->kills <= other.kills;
+  const bool better =
+    this->meanDetectionDelay < other.meanDetectionDelay ||
+    this->falsePositives < other.falsePositives ||
+    this->kills < other.kills;
+
+  return notWorse && better;
+}
+
+
+std::vector<SweepParameters> createGrid(
+    const std::vector<uint64_t>& windowSizes,
+    const std::vector<double_t>& fractionalThresholds,
+    const std::vector<double_t>& severityFractions,
+    const std::vector<double_t>& quorums,
+    const std::vector<double_t>& emaAlphas) {
+  std::vector<SweepParameters> grid;
+  for (uint64_t windowSize : windowSizes) {
+    for (double_t fractionalThreshold : fractionalThresholds) {
+      for (double_t severityFraction : severityFractions) {
+        for (double_t quorum : quorums) {
+          for (double_t emaAlpha : emaAlphas) {
+            grid.push_back(SweepParameters{
+              windowSize,
+              fractionalThreshold,
+              severityFraction,
+              quorum,
+              emaAlpha,
+              emaAlpha});
+          }
+        }
+      }
+    }
+  }
+
+  return grid;
+}
+
+
+SweepScore score(
+    const std::vector<IterationOutcome>& outcomes,
+    const std::vector<ContentionWindow>& windows) {
+  SweepScore result;
+  double_t totalDelay = 0;
+
+  for (const ContentionWindow& window : windows) {
+    bool detected = false;
+    for (const IterationOutcome& outcome : outcomes) {
+      if (outcome.kills > 0 && window.contains(outcome.timestamp)) {
+        totalDelay += outcome.timestamp - window.start;
+        detected = true;
+        break;
+      }
+    }
+
+    if (detected) {
+      result.detected++;
+    } else {
+      totalDelay += window.end - window.start;
+      result.missed++;
+    }
+  }
+
+  for (const IterationOutcome& outcome : outcomes) {
+    result.kills += outcome.kills;
+    if (outcome.kills == 0) {
+      continue;
+    }
+
+    bool inWindow = false;
+    for (const ContentionWindow& window : windows) {
+      if (window.contains(outcome.timestamp)) {
+        inWindow = true;
+        break;
+      }
+    }
+
+    if (!inWindow) {
+      result.falsePositives++;
+    }
+  }
+
+  if (!windows.empty()) {
+    result.meanDetectionDelay = totalDelay / windows.size();
+  }
+
+  return result;
+}
+
+
+SweepScore replay(
+    const SweepParameters& parameters,
+    const SerenityConfig& baseConf,
+    const std::vector<ResourceUsage>& trace,
+    const std::vector<ContentionWindow>& windows) {
+  // Deep copy - sections of base configuration are shared between threads.
+  SerenityConfig conf;
+  conf.applyConfig(baseConf);
+  parameters.apply(&conf);
+  // Replays run in parallel, so pipelines cannot spawn endpoints nor
+  // publish slack scale on StaticEventBus.
+  conf.set(qos_pipeline::SHADOW_MODE, true);
+
+  std::shared_ptr<PipelineClock> clock(new UsageClock());
+  std::unique_ptr<CpuQoSPipeline> pipeline(new CpuQoSPipeline(conf, clock));
+
+  std::vector<IterationOutcome> outcomes;
+  outcomes.reserve(trace.size());
+  for (const ResourceUsage& usage : trace) {
+    Result<QoSCorrections> corrections = pipeline->run(usage);
+
+    IterationOutcome outcome{clock->now(), 0};
+    if (corrections.isSome()) {
+      for (const slave::QoSCorrection& correction : corrections.get()) {
+        if (correction.has_kill()) {
+          outcome.kills++;
+        }
+      }
+    }
+    outcomes.push_back(outcome);
+  }
+
+  return score(outcomes, windows);
+}
+
+
+std::vector<SweepResult> runSweep(
+    const std::vector<SweepParameters>& grid,
+    const SerenityConfig& baseConf,
+    const std::vector<ResourceUsage>& trace,
+    const std::vector<ContentionWindow>& windows,
+    size_t threads) {
+  std::vector<SweepResult> results(grid.size());
+  std::atomic<size_t> next(0);
+
+  // Every worker takes next parameter set and writes only to its slot.
+  auto worker = [&]() {
+    for (size_t index = next++; index < grid.size(); index = next++) {
+      results[index].parameters = grid[index];
+      results[index].score = replay(grid[index], baseConf, trace, windows);
+    }
+  };
+
+  threads = std::max<size_t>(1, std::min(threads, grid.size()));
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < threads; i++) {
+    workers.push_back(std::thread(worker));
+  }
+
+  for (std::thread& thread : workers) {
+    thread.join();
+  }
+
+  return results;
+}
+
+
+std::vector<SweepResult> paretoFront(const std::vector<SweepResult>& results) {
+  std::vector<SweepResult> front;
+  for (const SweepResult& candidate : results) {
+    bool dominated = false;
+    for (const SweepResult& other : results) {
+      if (other.score.dominates(candidate.score)) {
+        dominated = true;
+        break;
+      }
+    }
+
+    if (!dominated) {
+      front.push_back(candidate);
+    }
+  }
+
+  std::sort(front.begin(), front.end(),
+            [](const SweepResult& lhs, const SweepResult& rhs) {
+              return lhs.score.meanDetectionDelay <
+                     rhs.score.meanDetectionDelay;
+            });
+
+  return front;
+}
+
+
+Try<std::vector<ContentionWindow>> parseContentionWindows(
+    const std::string& json) {
+  Try<JSON::Object> object = JSON::parse<JSON::Object>(json);
+  if (object.isError()) {
+    return Error("Failed to parse labels: " + object.error());
+  }
+
+  Result<JSON::Array> contentions =
+    object.get().find<JSON::Array>("contentions");
+  if (!contentions.isSome()) {
+    return Error("Labels do not contain 'contentions' array");
+  }
+
+  std::vector<ContentionWindow> windows;
+  for (size_t i = 0; i < contentions.get().values.size(); i++) {
+    const std::string prefix = "contentions[" + stringify(i) + "].";
+    Result<JSON::Number> start =
+      object.get().find<JSON::Number>(prefix + "start");
+    Result<JSON::Number> end =
+      object.get().find<JSON::Number>(prefix + "end");
+    if (!start.isSome() || !end.isSome()) {
+      return Error("Contention " + stringify(i) + " needs 'start' and 'end'");
+    }
+
+    windows.push_back(ContentionWindow{start.get().value, end.get().value});
+  }
+
+  return windows;
+}
+
+}  // namespace sweep
+}  // namespace serenity
+}  // namespace mesos
@@ -0,0 +1,151 @@
+#ifndef SERENITY_PARAMETER_SWEEP_HPP
+#define SERENITY_PARAMETER_SWEEP_HPP
+
+#include <string>
+#include <vector>
+
+#include "mesos/mesos.hpp"
+
+#include "serenity/config.hpp"
+
+#include "stout/try.hpp"
+
+namespace mesos {
+namespace serenity {
+namespace sweep {
+
+/**
+ * Detector parameters tried in one sweep point.
+ */
+struct SweepParameters {
+  uint64_t windowSize;
+  double_t fractionalThreshold;
+  double_t severityFraction;
+  double_t quorum;
+  double_t emaAlphaIpc;
+  double_t emaAlphaCpu;
+
+  /**
+   * Overrides parameters in QoS pipeline configuration.
+   */
+  void apply(SerenityConfig* conf) const;
+
+  std::string toString() const;
+};
+
+
+/**
+ * Labelled period (absolute usage timestamps) with real contention.
+ */
+struct ContentionWindow {
+  double_t start;
+  double_t end;
+
+  bool contains(double_t timestamp) const {
+    return timestamp >= start && timestamp <= end;
+  }
+};
+
+
+/**
+ * Outcome of one pipeline iteration during replay.
+ */
+struct IterationOutcome {
+  double_t timestamp;
+  uint64_t kills;
+};
+
+
+/**
+ * All values are "lower is better".
+ */
+struct SweepScore {
+  SweepScore()
+    : meanDetectionDelay(0),
+      detected(0),
+      missed(0),
+      falsePositives(0),
+      kills(0) {}
+
+  //! Seconds from window start to first correction. Missed window counts
+  //! as whole window length.
+  double_t meanDetectionDelay;
+  uint64_t detected;
+  uint64_t missed;
+  //! Iterations with corrections outside of labelled windows.
+  uint64_t falsePositives;
+  uint64_t kills;
+
+  /**
+   * True when this score is not worse in any objective and better in at
+   * least one (delay, false positives, kills).
+   */
+  bool dominates(const SweepScore& other) const;
+};
+
+
+struct SweepResult {
+  SweepParameters parameters;
+  SweepScore score;
+};
+
+
+/**
+ * Cartesian product of given parameter values.
+ */
+std::vector<SweepParameters> createGrid(
+    const std::vector<uint64_t>& windowSizes,
+    const std::vector<double_t>& fractionalThresholds,
+    const std::vector<double_t>& severityFractions,
+    const std::vector<double_t>& quorums,
+    const std::vector<double_t>& emaAlphas);
+
+
+SweepScore score(
+    const std::vector<IterationOutcome>& outcomes,
+    const std::vector<ContentionWindow>& windows);
+
+
+/**
+ * Replays trace through fresh CpuQoSPipeline (driven by UsageClock) built
+ * from base configuration with given parameters. Pipeline runs in
+ * qos_pipeline::SHADOW_MODE, so it has no side effects outside of itself.
+ */
+SweepScore replay(
+    const SweepParameters& parameters,
+    const SerenityConfig& baseConf,
+    const std::vector<ResourceUsage>& trace,
+    const std::vector<ContentionWindow>& windows);
+
+
+/**
+ * Replays trace for every parameter set using given number of threads.
+ * Each pipeline is isolated, trace is shared read-only.
+ * Results are in the same order as parameters.
+ */
+std::vector<SweepResult> runSweep(
+    const std::vector<SweepParameters>& grid,
+    const SerenityConfig& baseConf,
+    const std::vector<ResourceUsage>& trace,
+    const std::vector<ContentionWindow>& windows,
+    size_t threads);
+
+
+/**
+ * Returns results which are not dominated by any other result, sorted by
+ * detection delay.
+ */
+std::vector<SweepResult> paretoFront(const std::vector<SweepResult>& results);
+
+
+/**
+ * Parses labels: {"contentions": [{"start": 100, "end": 160}, ...]}
+ */
+Try<std::vector<ContentionWindow>> parseContentionWindows(
+    const std::string& json);
+
+}  // namespace sweep
+}  // namespace serenity
+}  // namespace mesos
+
+#endif  // SERENITY_PARAMETER_SWEEP_HPP